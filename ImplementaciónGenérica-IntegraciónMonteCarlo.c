@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "montecarlo_problems.h"
+
+// Ejemplo del motor genérico con integrandos de dimensión arbitraria
+
+// Indicador de la bola unitaria en [0,1]^4: su volumen es π^2 / 32
+static inline double ball4_integrand(const mc_no_params_t* params, const double* u, int stride) {
+    (void)params;
+    double r2 = 0.0;
+    for (int d = 0; d < 4; d++) {
+        r2 += u[d * stride] * u[d * stride];
+    }
+    return (r2 <= 1.0) ? 1.0 : 0.0;
+}
+
+#define MC_NAME ball4
+#define MC_DIM 4
+#define MC_PARAMS mc_no_params_t
+#define MC_INTEGRAND ball4_integrand
+#include "montecarlo_engine.h"
+
+// Función suave de Genz ("product peak") en [0,1]^6 con integral conocida:
+// prod_d a_d (atan(a_d (1 - c_d)) + atan(a_d c_d))
+typedef struct {
+    double a[6];
+    double c[6];
+} genz_params_t;
+
+static inline double genz_integrand(const genz_params_t* params, const double* u, int stride) {
+    double value = 1.0;
+    for (int d = 0; d < 6; d++) {
+        double diff = u[d * stride] - params->c[d];
+        value *= 1.0 / (1.0 / (params->a[d] * params->a[d]) + diff * diff);
+    }
+    return value;
+}
+
+#define MC_NAME genz
+#define MC_DIM 6
+#define MC_PARAMS genz_params_t
+#define MC_INTEGRAND genz_integrand
+#include "montecarlo_engine.h"
+
+static double genz_exact(const genz_params_t* params) {
+    double value = 1.0;
+    for (int d = 0; d < 6; d++) {
+        double a = params->a[d];
+        double c = params->c[d];
+        value *= a * (atan(a * (1.0 - c)) + atan(a * c));
+    }
+    return value;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t num_points = 4000000;
+    int num_workers = 4;
+    sampling_mode_t mode = SAMPLING_UNIFORM;
+
+    if (argc > 4 || (argc > 1 && parse_sampling_mode(argv[1], &mode) != 0) ||
+        (argc > 2 && parse_sample_count(argv[2], &num_points) != 0) ||
+        (argc > 3 && (num_workers = atoi(argv[3])) <= 0)) {
+        printf("Uso: %s [uniforme|estratificado|antitetico|sobol|halton|qmc] [puntos] [workers]\n", argv[0]);
+        return 1;
+    }
+    if (num_workers > MC_MAX_WORKERS) num_workers = MC_MAX_WORKERS;
+
+    genz_params_t genz = {{5.0, 4.0, 3.0, 5.0, 4.0, 3.0}, {0.3, 0.5, 0.7, 0.2, 0.4, 0.6}};
+
+    printf("Integración Monte Carlo genérica\n");
+    printf("Muestreo: %s\n", sampling_mode_name(mode));
+    printf("Puntos: %" PRIu64 "\n", num_points);
+    printf("Workers: %d\n\n", num_workers);
+    printf("%-10s %-10s %4s %16s %14s %14s\n",
+           "Problema", "Backend", "Dim", "Estimación", "Error", "Mpuntos/s");
+
+    for (int b = 0; b < NUM_MC_BACKENDS; b++) {
+        mc_backend_t backend = (mc_backend_t)b;
+        mc_design_t design;
+        double start, elapsed, estimate;
+        mc_sum_t result;
+
+        mc_design_init(&design, mode, 2, num_points, time(NULL));
+        start = mc_wall_time();
+        result = dartboard_run(backend, NULL, &design, 0, num_points, num_workers);
+        elapsed = mc_wall_time() - start;
+        estimate = dartboard_estimate(&result);
+        printf("%-10s %-10s %4d %16.6f %14.3e %14.2f\n", "dartboard", mc_backend_name(backend),
+               2, estimate, fabs(estimate - M_PI), num_points / elapsed / 1e6);
+
+        mc_design_init(&design, mode, 4, num_points, time(NULL));
+        start = mc_wall_time();
+        result = ball4_run(backend, NULL, &design, 0, num_points, num_workers);
+        elapsed = mc_wall_time() - start;
+        estimate = sqrt(32.0 * mc_mean(&result));
+        printf("%-10s %-10s %4d %16.6f %14.3e %14.2f\n", "bola4", mc_backend_name(backend),
+               4, estimate, fabs(estimate - M_PI), num_points / elapsed / 1e6);
+
+        mc_design_init(&design, mode, 6, num_points, time(NULL));
+        start = mc_wall_time();
+        result = genz_run(backend, &genz, &design, 0, num_points, num_workers);
+        elapsed = mc_wall_time() - start;
+        estimate = mc_mean(&result);
+        printf("%-10s %-10s %4d %16.6f %14.3e %14.2f\n", "genz", mc_backend_name(backend),
+               6, estimate, fabs(estimate - genz_exact(&genz)), num_points / elapsed / 1e6);
+    }
+
+    mc_shutdown();
+    return 0;
+}
@@ -2,40 +2,82 @@
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include "montecarlo_problems.h"
 
-double dartboard_method_serial(int num_points) {
-    srand(time(NULL));
-    int inside_circle = 0;
+double dartboard_method_serial(uint64_t num_points, sampling_mode_t mode, uint64_t seed) {
+    mc_design_t design;
+    mc_design_init(&design, mode, 2, num_points, seed);
+
+    mc_sum_t result = dartboard_serial(NULL, &design, 0, num_points);
     
-    for (int i = 0; i < num_points; i++) {
-        // Generar coordenadas aleatorias [-1, 1]
-        double x = 2.0 * ((double)rand() / RAND_MAX) - 1.0;
-        double y = 2.0 * ((double)rand() / RAND_MAX) - 1.0;
-        
-        // Verificar si está dentro del círculo unitario
-        if (x * x + y * y <= 1.0) {
-            inside_circle++;
+    // Estimar π
+    return dartboard_estimate(&result);
+}
+
+// Compara los modos de muestreo: para cada tamaño se hacen varias réplicas
+// con semillas distintas y se reporta el error cuadrático medio, el tiempo
+// por réplica y la eficiencia 1 / (RMSE^2 * tiempo). A mayor eficiencia,
+// menos cómputo hace falta para alcanzar una precisión dada.
+void compare_sampling_modes(void) {
+    const int sizes[] = {10000, 100000, 1000000};
+    const int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    const int replicas = 16;
+
+    printf("Dartboard Method - Comparación de modos de muestreo\n");
+    printf("Réplicas por configuración: %d\n\n", replicas);
+    printf("%-14s %10s %14s %14s %16s\n",
+           "Modo", "Puntos", "RMSE", "Tiempo (s)", "1/(RMSE^2*t)");
+
+    for (int m = 0; m < NUM_SAMPLING_MODES; m++) {
+        for (int s = 0; s < num_sizes; s++) {
+            double sum_sq_error = 0.0;
+            double start = mc_wall_time();
+            for (int r = 0; r < replicas; r++) {
+                double pi_estimate = dartboard_method_serial(sizes[s], (sampling_mode_t)m, r + 1);
+                sum_sq_error += (pi_estimate - M_PI) * (pi_estimate - M_PI);
+            }
+            double end = mc_wall_time();
+
+            double rmse = sqrt(sum_sq_error / replicas);
+            double time_per_run = (end - start) / replicas;
+            double efficiency = (rmse > 0.0 && time_per_run > 0.0)
+                              ? 1.0 / (rmse * rmse * time_per_run) : INFINITY;
+
+            printf("%-14s %10d %14.3e %14.6f %16.3e\n",
+                   sampling_mode_name((sampling_mode_t)m), sizes[s],
+                   rmse, time_per_run, efficiency);
         }
     }
-    
-    // Estimar π
-    return 4.0 * inside_circle / num_points;
 }
 
-int main() {
-    int num_points = 1000000;
+int main(int argc, char* argv[]) {
+    uint64_t num_points = 1000000;
+    sampling_mode_t mode = SAMPLING_UNIFORM;
+
+    if (argc > 1 && strcmp(argv[1], "comparar") == 0) {
+        compare_sampling_modes();
+        return 0;
+    }
+    if (argc > 3 || (argc > 1 && parse_sampling_mode(argv[1], &mode) != 0) ||
+        (argc > 2 && parse_sample_count(argv[2], &num_points) != 0)) {
+        printf("Uso: %s [uniforme|estratificado|antitetico|sobol|halton|qmc|comparar] [puntos]\n", argv[0]);
+        printf("Ejemplo: %s sobol 1e9\n", argv[0]);
+        return 1;
+    }
     
-    clock_t start = clock();
-    double pi_estimate = dartboard_method_serial(num_points);
-    clock_t end = clock();
+    double start = mc_wall_time();
+    double pi_estimate = dartboard_method_serial(num_points, mode, time(NULL));
+    double end = mc_wall_time();
     
-    double execution_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+    double execution_time = end - start;
     
     printf("Dartboard Method - Serial\n");
-    printf("Puntos: %d\n", num_points);
-    printf("Estimación de π: %.6f\n", pi_estimate);
-    printf("Error: %.6f\n", fabs(M_PI - pi_estimate));
+    printf("Muestreo: %s\n", sampling_mode_name(mode));
+    printf("Puntos: %" PRIu64 "\n", num_points);
+    printf("Estimación de π: %.10f\n", pi_estimate);
+    printf("Error: %.10f\n", fabs(M_PI - pi_estimate));
     printf("Tiempo de ejecución: %.4f segundos\n", execution_time);
+    printf("Rendimiento: %.2f Mpuntos/s\n", num_points / execution_time / 1e6);
     
     return 0;
 }
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <mpi.h>
+#include "montecarlo_problems.h"
+
+// Dartboard distribuido con MPI. Compilar y ejecutar en una sola máquina:
+//   mpicc -O3 -march=native -pthread -o dartboard_mpi "ImplementaciónconMPI-DartboardMethod.c" -lm
+//   mpirun -np 4 ./dartboard_mpi sobol 1e9 1
+//   mpirun -np 4 ./dartboard_mpi uniforme 1e8 1 escalado
+
+// Cuenta los aciertos del tramo [first, first + count). El generador depende
+// sólo de (semilla, índice), así que saltar al subflujo de un rank es O(1) y
+// los tramos de distintos ranks son disjuntos por construcción.
+uint64_t dartboard_count_range(const mc_design_t* design, uint64_t first, uint64_t count,
+                               int threads_per_rank) {
+    mc_sum_t partial = threads_per_rank > 1
+                     ? dartboard_threads(NULL, design, first, count, threads_per_rank)
+                     : dartboard_simd(NULL, design, first, count);
+    return partial.hits;
+}
+
+// Estima π con los ranks de comm: cada rank evalúa su tramo del diseño de
+// num_points puntos y los aciertos se combinan con MPI_Reduce en el rank 0
+double dartboard_method_mpi(uint64_t num_points, sampling_mode_t mode, uint64_t seed,
+                            int threads_per_rank, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    mc_design_t design;
+    mc_design_init(&design, mode, 2, num_points, seed);
+
+    uint64_t first, end;
+    mc_partition(0, num_points, size, rank, &first, &end);
+    uint64_t local_hits = dartboard_count_range(&design, first, end - first, threads_per_rank);
+
+    uint64_t total_hits = 0;
+    MPI_Reduce(&local_hits, &total_hits, 1, MPI_UINT64_T, MPI_SUM, 0, comm);
+
+    return 4.0 * (double)total_hits / (double)num_points;
+}
+
+// Tiempo de una estimación sobre comm, medido entre barreras
+double timed_run(uint64_t num_points, sampling_mode_t mode, uint64_t seed,
+                 int threads_per_rank, MPI_Comm comm, double* pi_estimate) {
+    MPI_Barrier(comm);
+    double start = MPI_Wtime();
+    *pi_estimate = dartboard_method_mpi(num_points, mode, seed, threads_per_rank, comm);
+    MPI_Barrier(comm);
+    return MPI_Wtime() - start;
+}
+
+// Escalado fuerte (N total fijo) y débil (N por rank fijo) con 1, 2, 4, ...
+// ranks: los ranks que no participan en una medición esperan en la barrera
+void scaling_report(uint64_t num_points, sampling_mode_t mode, uint64_t seed,
+                    int threads_per_rank) {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (rank == 0) {
+        printf("Dartboard Method - MPI (escalado)\n");
+        printf("Muestreo: %s\n", sampling_mode_name(mode));
+        printf("Puntos (fuerte) / puntos por rank (débil): %" PRIu64 "\n\n",
+               num_points);
+        printf("%-7s %6s %16s %12s %10s %12s %14s\n",
+               "Tipo", "Ranks", "Puntos", "Tiempo (s)", "Speedup", "Eficiencia", "Error");
+    }
+
+    for (int weak = 0; weak <= 1; weak++) {
+        double base_time = 0.0;
+        for (int p = 1; p <= size; p *= 2) {
+            MPI_Comm sub;
+            MPI_Comm_split(MPI_COMM_WORLD, rank < p ? 0 : MPI_UNDEFINED, rank, &sub);
+
+            uint64_t points = weak ? num_points * p : num_points;
+            double elapsed = 0.0, pi_estimate = 0.0;
+            if (sub != MPI_COMM_NULL) {
+                elapsed = timed_run(points, mode, seed, threads_per_rank, sub, &pi_estimate);
+                MPI_Comm_free(&sub);
+            }
+            MPI_Barrier(MPI_COMM_WORLD);
+
+            if (rank == 0) {
+                if (p == 1) base_time = elapsed;
+                // Fuerte: T1 / Tp. Débil: T1 / Tp con p veces más trabajo
+                double speedup = weak ? base_time * p / elapsed : base_time / elapsed;
+                printf("%-7s %6d %16" PRIu64 " %12.4f %10.2f %11.1f%% %14.3e\n",
+                       weak ? "debil" : "fuerte", p, points, elapsed,
+                       speedup, 100.0 * speedup / p, fabs(M_PI - pi_estimate));
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    uint64_t num_points = 1000000000ULL;
+    sampling_mode_t mode = SAMPLING_UNIFORM;
+    int threads_per_rank = 1;
+    int scaling = 0;
+
+    // Mismo orden que las demás implementaciones: modo, muestras, trabajadores.
+    // Admite notación científica para el número de puntos (p. ej. 1e12)
+    if (argc > 1 && parse_sampling_mode(argv[1], &mode) != 0) num_points = 0;
+    if (argc > 2 && parse_sample_count(argv[2], &num_points) != 0) num_points = 0;
+    if (argc > 3) threads_per_rank = atoi(argv[3]);
+    if (argc > 4) scaling = strcmp(argv[4], "escalado") == 0;
+
+    if (num_points == 0 || threads_per_rank <= 0) {
+        if (rank == 0) {
+            printf("Uso: %s [uniforme|estratificado|antitetico|sobol|halton|qmc] [puntos] "
+                   "[hilos_por_rank] [escalado]\n", argv[0]);
+            printf("Ejemplo: mpirun -np 4 %s uniforme 1e9 1\n", argv[0]);
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Todos los ranks comparten la semilla del rank 0
+    uint64_t seed = time(NULL);
+    MPI_Bcast(&seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+    if (scaling) {
+        scaling_report(num_points, mode, seed, threads_per_rank);
+    } else {
+        double pi_estimate;
+        double execution_time = timed_run(num_points, mode, seed, threads_per_rank,
+                                          MPI_COMM_WORLD, &pi_estimate);
+        if (rank == 0) {
+            printf("Dartboard Method - MPI\n");
+            printf("Muestreo: %s\n", sampling_mode_name(mode));
+            printf("Puntos: %" PRIu64 "\n", num_points);
+            printf("Ranks: %d\n", size);
+            printf("Hilos por rank: %d\n", threads_per_rank);
+            printf("Estimación de π: %.10f\n", pi_estimate);
+            printf("Error: %.10f\n", fabs(M_PI - pi_estimate));
+            printf("Tiempo de ejecución: %.4f segundos\n", execution_time);
+            printf("Rendimiento: %.2f Mpuntos/s\n", num_points / execution_time / 1e6);
+        }
+    }
+
+    mc_shutdown();
+    MPI_Finalize();
+    return 0;
+}
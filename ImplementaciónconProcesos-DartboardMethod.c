@@ -1,75 +1,64 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <unistd.h>
-#include <sys/wait.h>
-#include <sys/mman.h>
 #include <time.h>
+#include "montecarlo_problems.h"
 
-double dartboard_method_processes(int num_points, int num_processes) {
-    // Memoria compartida para contador
-    int* shared_counter = mmap(NULL, sizeof(int), PROT_READ | PROT_WRITE,
-                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
-    *shared_counter = 0;
-    
-    int points_per_process = num_points / num_processes;
-    pid_t pids[num_processes];
-    
-    for (int p = 0; p < num_processes; p++) {
-        pid_t pid = fork();
-        
-        if (pid == 0) { // Proceso hijo
-            srand(time(NULL) + getpid());
-            int local_inside = 0;
-            
-            for (int i = 0; i < points_per_process; i++) {
-                double x = 2.0 * ((double)rand() / RAND_MAX) - 1.0;
-                double y = 2.0 * ((double)rand() / RAND_MAX) - 1.0;
-                
-                if (x * x + y * y <= 1.0) {
-                    local_inside++;
-                }
-            }
-            
-            // Actualizar contador compartido (requiere sincronización)
-            __atomic_add_fetch(shared_counter, local_inside, __ATOMIC_SEQ_CST);
-            exit(0);
-            
-        } else if (pid > 0) { // Proceso padre
-            pids[p] = pid;
-        } else {
-            perror("fork failed");
-            exit(1);
-        }
-    }
-    
-    // Esperar todos los procesos hijo
-    for (int p = 0; p < num_processes; p++) {
-        waitpid(pids[p], NULL, 0);
-    }
-    
-    double pi_estimate = 4.0 * (*shared_counter) / num_points;
-    munmap(shared_counter, sizeof(int));
+double dartboard_method_processes(uint64_t num_points, int num_processes, sampling_mode_t mode) {
+    // Semilla común: cada proceso del pool evalúa su tramo del mismo diseño de
+    // puntos y deja sus sumas parciales de 64 bits en su ranura compartida
+    mc_design_t design;
+    mc_design_init(&design, mode, 2, num_points, time(NULL));
+
+    mc_sum_t result = dartboard_processes(NULL, &design, 0, num_points, num_processes);
     
-    return pi_estimate;
+    return dartboard_estimate(&result);
 }
 
-int main() {
-    int num_points = 1000000;
+int main(int argc, char* argv[]) {
+    uint64_t num_points = 1000000;
     int num_processes = 4; // Número de procesos
+    int repetitions = 1;
+    sampling_mode_t mode = SAMPLING_UNIFORM;
 
-    clock_t start = clock();
-    double pi_estimate = dartboard_method_processes(num_points, num_processes);
-    clock_t end = clock();
+    if (argc > 5 || (argc > 1 && parse_sampling_mode(argv[1], &mode) != 0) ||
+        (argc > 2 && parse_sample_count(argv[2], &num_points) != 0) ||
+        (argc > 3 && (num_processes = atoi(argv[3])) <= 0) ||
+        (argc > 4 && (repetitions = atoi(argv[4])) <= 0)) {
+        printf("Uso: %s [uniforme|estratificado|antitetico|sobol|halton|qmc] [puntos] [procesos] [repeticiones]\n", argv[0]);
+        printf("Ejemplo: %s uniforme 1e11 8\n", argv[0]);
+        return 1;
+    }
+    if (num_processes > MC_MAX_WORKERS) num_processes = MC_MAX_WORKERS;
 
-    double execution_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+    // La primera ejecución incluye crear el pool; las siguientes lo reutilizan
+    double start = mc_wall_time();
+    double pi_estimate = dartboard_method_processes(num_points, num_processes, mode);
+    double end = mc_wall_time();
+    double execution_time = end - start;
+
+    double reuse_time = 0.0;
+    for (int r = 1; r < repetitions; r++) {
+        double t0 = mc_wall_time();
+        pi_estimate = dartboard_method_processes(num_points, num_processes, mode);
+        reuse_time += mc_wall_time() - t0;
+    }
 
     printf("Dartboard Method - Procesos\n");
-    printf("Puntos: %d\n", num_points);
+    printf("Muestreo: %s\n", sampling_mode_name(mode));
+    printf("Puntos: %" PRIu64 "\n", num_points);
     printf("Procesos: %d\n", num_processes);
-    printf("Estimación de π: %.6f\n", pi_estimate);
-    printf("Error: %.6f\n", fabs(M_PI - pi_estimate));
+    printf("Estimación de π: %.10f\n", pi_estimate);
+    printf("Error: %.10f\n", fabs(M_PI - pi_estimate));
     printf("Tiempo de ejecución: %.4f segundos\n", execution_time);
+    printf("Rendimiento: %.2f Mpuntos/s\n", num_points / execution_time / 1e6);
+    if (repetitions > 1) {
+        double mean_time = reuse_time / (repetitions - 1);
+        printf("Repeticiones con el pool ya creado: %d\n", repetitions - 1);
+        printf("Tiempo medio por repetición: %.4f segundos\n", mean_time);
+        printf("Rendimiento con el pool ya creado: %.2f Mpuntos/s\n", num_points / mean_time / 1e6);
+    }
 
+    mc_shutdown();
     return 0;
 }
@@ -2,49 +2,46 @@
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include "montecarlo_problems.h"
 
-double buffon_needle_serial(int num_tosses, double needle_length, double line_distance) {
-    srand(time(NULL));
-    int crosses = 0;
-    
-    for (int i = 0; i < num_tosses; i++) {
-        // Generar posición x aleatoria [0, line_distance]
-        double x = ((double)rand() / RAND_MAX) * line_distance;
-        
-        // Generar ángulo θ aleatorio [0, π]
-        double theta = ((double)rand() / RAND_MAX) * M_PI;
-        
-        // Calcular extremos de la aguja
-        double x_left = x - (needle_length / 2.0) * sin(theta);
-        double x_right = x + (needle_length / 2.0) * sin(theta);
-        
-        // Verificar si cruza una línea
-        if (x_left < 0.0 || x_right > line_distance) {
-            crosses++;
-        }
-    }
+double buffon_needle_serial(uint64_t num_tosses, double needle_length, double line_distance,
+                            sampling_mode_t mode) {
+    buffon_params_t params = {needle_length, line_distance};
+    mc_design_t design;
+    mc_design_init(&design, mode, 2, num_tosses, time(NULL));
+
+    mc_sum_t result = buffon_serial(&params, &design, 0, num_tosses);
     
     // Calcular π usando la fórmula de Buffon
-    double probability = (double)crosses / num_tosses;
-    return (2.0 * needle_length) / (probability * line_distance);
+    return buffon_estimate(&params, &result);
 }
 
-int main() {
-    int num_tosses = 1000000;
+int main(int argc, char* argv[]) {
+    uint64_t num_tosses = 1000000;
     double needle_length = 1.0;
     double line_distance = 2.0;
+    sampling_mode_t mode = SAMPLING_UNIFORM;
+
+    if (argc > 3 || (argc > 1 && parse_sampling_mode(argv[1], &mode) != 0) ||
+        (argc > 2 && parse_sample_count(argv[2], &num_tosses) != 0)) {
+        printf("Uso: %s [uniforme|estratificado|antitetico|sobol|halton|qmc] [lanzamientos]\n", argv[0]);
+        printf("Ejemplo: %s halton 1e9\n", argv[0]);
+        return 1;
+    }
     
-    clock_t start = clock();
-    double pi_estimate = buffon_needle_serial(num_tosses, needle_length, line_distance);
-    clock_t end = clock();
+    double start = mc_wall_time();
+    double pi_estimate = buffon_needle_serial(num_tosses, needle_length, line_distance, mode);
+    double end = mc_wall_time();
     
-    double execution_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+    double execution_time = end - start;
     
     printf("Buffon's Needle - Serial\n");
-    printf("Lanzamientos: %d\n", num_tosses);
-    printf("Estimación de π: %.6f\n", pi_estimate);
-    printf("Error: %.6f\n", fabs(M_PI - pi_estimate));
+    printf("Muestreo: %s\n", sampling_mode_name(mode));
+    printf("Lanzamientos: %" PRIu64 "\n", num_tosses);
+    printf("Estimación de π: %.10f\n", pi_estimate);
+    printf("Error: %.10f\n", fabs(M_PI - pi_estimate));
     printf("Tiempo de ejecución: %.4f segundos\n", execution_time);
+    printf("Rendimiento: %.2f Mpuntos/s\n", num_tosses / execution_time / 1e6);
     
     return 0;
 }
@@ -0,0 +1,92 @@
+#!/bin/bash
+
+# Benchmark de rendimiento para los estimadores de π
+# Compila los programas y mide Mpuntos/s con contadores de 64 bits
+# (por defecto 10^11 muestras, por encima del límite de int)
+
+# Colores para output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+# Configuración
+BUILD_DIR="build_pi"
+RESULTS_DIR="results_pi"
+TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RESULTS_FILE="$RESULTS_DIR/throughput_$TIMESTAMP.csv"
+SAMPLES="${SAMPLES:-1e11}"
+WORKERS="${WORKERS:-$(nproc)}"
+MODE="${MODE:-uniforme}"
+MPIRUN="${MPIRUN:-mpirun}"
+CFLAGS="-O3 -march=native -Wall -Wextra -pthread"
+
+# Compilar los programas (los nombres de archivo tienen espacios y acentos)
+build() {
+    mkdir -p "$BUILD_DIR"
+    echo -e "${BLUE}=== COMPILANDO ===${NC}"
+    gcc $CFLAGS -o "$BUILD_DIR/dartboard_procesos" "ImplementaciónconProcesos-DartboardMethod.c" -lm || exit 1
+    gcc $CFLAGS -o "$BUILD_DIR/buffon_hilos" "ImplementaciónconThreads-Buffon's Needle.c" -lm || exit 1
+    gcc $CFLAGS -o "$BUILD_DIR/integracion" "ImplementaciónGenérica-IntegraciónMonteCarlo.c" -lm || exit 1
+    if command -v mpicc > /dev/null; then
+        mpicc $CFLAGS -o "$BUILD_DIR/dartboard_mpi" "ImplementaciónconMPI-DartboardMethod.c" -lm || exit 1
+    else
+        echo -e "${YELLOW}mpicc no disponible: se omite el backend MPI${NC}"
+    fi
+}
+
+# Ejecuta un programa y agrega una fila al CSV
+run_test() {
+    local name="$1"
+    shift
+
+    echo -e "${YELLOW}Ejecutando: $name ($SAMPLES muestras, $WORKERS workers)${NC}"
+    local output
+    output=$("$@" 2>&1)
+    local exit_code=$?
+
+    if [ $exit_code -ne 0 ]; then
+        echo -e "${RED}ERROR: $name (código: $exit_code)${NC}"
+        echo "$output"
+        echo "$name,$SAMPLES,$WORKERS,ERROR,ERROR,ERROR" >> "$RESULTS_FILE"
+        return
+    fi
+
+    local time_result=$(echo "$output" | grep "Tiempo de ejecución" | awk '{print $4}')
+    local rate=$(echo "$output" | grep "Rendimiento" | awk '{print $2}')
+    local error=$(echo "$output" | grep "^Error" | awk '{print $2}')
+
+    echo -e "${GREEN}✓ $name: ${time_result}s, ${rate} Mpuntos/s, error $error${NC}"
+    echo "$name,$SAMPLES,$WORKERS,$time_result,$rate,$error" >> "$RESULTS_FILE"
+}
+
+main() {
+    build
+    mkdir -p "$RESULTS_DIR"
+    echo "Programa,Muestras,Workers,Tiempo(s),Mpuntos/s,Error" > "$RESULTS_FILE"
+
+    echo -e "${BLUE}=== THROUGHPUT ($SAMPLES muestras, modo $MODE) ===${NC}"
+    run_test "Dartboard-Procesos" "$BUILD_DIR/dartboard_procesos" "$MODE" "$SAMPLES" "$WORKERS"
+    run_test "Buffon-Hilos" "$BUILD_DIR/buffon_hilos" "$MODE" "$SAMPLES" "$WORKERS"
+    if [ -x "$BUILD_DIR/dartboard_mpi" ]; then
+        run_test "Dartboard-MPI" $MPIRUN -np "$WORKERS" "$BUILD_DIR/dartboard_mpi" "$MODE" "$SAMPLES" 1
+    fi
+
+    echo ""
+    echo -e "${GREEN}Benchmark completado${NC}"
+    echo "Resultados en: $RESULTS_FILE"
+}
+
+case "${1:-run}" in
+    "run")
+        main
+        ;;
+    "help"|"-h"|"--help")
+        echo "Uso: [SAMPLES=1e11] [WORKERS=n] [MODE=uniforme] [MPIRUN=mpirun] $0"
+        ;;
+    *)
+        echo -e "${RED}Opción desconocida: $1${NC}"
+        exit 1
+        ;;
+esac
@@ -0,0 +1,553 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "reto2hpc-main/pool_procesos.h"
+
+// Motor Monte Carlo genérico: muestreo -> integrando -> acumulación -> fórmula.
+// Este archivo contiene lo común a todas las instancias (muestreadores sobre
+// [0,1]^d, acumuladores, pools de hilos y de procesos). Las funciones de cada problema se
+// generan incluyendo montecarlo_engine.h con MC_NAME, MC_DIM, MC_PARAMS y
+// MC_INTEGRAND definidos, de forma que el integrando queda en línea dentro
+// de cada backend igual que en un bucle escrito a mano.
+
+#define MC_MAX_DIM 8
+#define MC_MAX_WORKERS POOL_MAX_TRABAJADORES
+#define MC_BATCH 64
+
+// Parámetros de los problemas que no necesitan ninguno
+typedef struct {
+    char unused;
+} mc_no_params_t;
+
+// ---------------------------------------------------------------------------
+// Modos de muestreo
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    SAMPLING_UNIFORM,
+    SAMPLING_STRATIFIED,
+    SAMPLING_ANTITHETIC,
+    SAMPLING_SOBOL,
+    SAMPLING_HALTON
+} sampling_mode_t;
+
+#define NUM_SAMPLING_MODES 5
+
+static inline const char* sampling_mode_name(sampling_mode_t mode) {
+    switch (mode) {
+        case SAMPLING_UNIFORM:    return "uniforme";
+        case SAMPLING_STRATIFIED: return "estratificado";
+        case SAMPLING_ANTITHETIC: return "antitetico";
+        case SAMPLING_SOBOL:      return "sobol";
+        case SAMPLING_HALTON:     return "halton";
+    }
+    return "desconocido";
+}
+
+// Devuelve 0 si el nombre es válido. "qmc" selecciona Sobol aleatorizado,
+// que es el modo cuasi-Monte Carlo por defecto.
+static inline int parse_sampling_mode(const char* name, sampling_mode_t* mode) {
+    if (strcmp(name, "qmc") == 0) {
+        *mode = SAMPLING_SOBOL;
+        return 0;
+    }
+    for (int m = 0; m < NUM_SAMPLING_MODES; m++) {
+        if (strcmp(name, sampling_mode_name((sampling_mode_t)m)) == 0) {
+            *mode = (sampling_mode_t)m;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Backends de ejecución
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    MC_BACKEND_SERIAL,
+    MC_BACKEND_SIMD,
+    MC_BACKEND_THREADS,
+    MC_BACKEND_PROCESSES
+} mc_backend_t;
+
+#define NUM_MC_BACKENDS 4
+
+static inline const char* mc_backend_name(mc_backend_t backend) {
+    switch (backend) {
+        case MC_BACKEND_SERIAL:    return "serial";
+        case MC_BACKEND_SIMD:      return "simd";
+        case MC_BACKEND_THREADS:   return "hilos";
+        case MC_BACKEND_PROCESSES: return "procesos";
+    }
+    return "desconocido";
+}
+
+static inline int parse_mc_backend(const char* name, mc_backend_t* backend) {
+    for (int b = 0; b < NUM_MC_BACKENDS; b++) {
+        if (strcmp(name, mc_backend_name((mc_backend_t)b)) == 0) {
+            *backend = (mc_backend_t)b;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Número de muestras de 64 bits; admite notación científica ("1e11").
+// Devuelve 0 si el valor es válido y positivo.
+static inline int parse_sample_count(const char* text, uint64_t* count) {
+    char* end;
+    if (strpbrk(text, "eE.") != NULL) {
+        double value = strtod(text, &end);
+        if (*end != '\0' || value < 1.0 || value >= 18446744073709551616.0) return -1;
+        *count = (uint64_t)value;
+    } else {
+        if (text[0] == '-') return -1;
+        unsigned long long value = strtoull(text, &end, 10);
+        if (*end != '\0' || value == 0) return -1;
+        *count = (uint64_t)value;
+    }
+    return 0;
+}
+
+// Tiempo de pared en segundos: clock() sólo mide CPU del proceso que llama,
+// lo que no sirve para hilos ni para procesos hijos
+static inline double mc_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---------------------------------------------------------------------------
+// Generadores: cada coordenada depende sólo de (semilla, índice, dimensión),
+// así que cualquier rango de índices se puede evaluar en cualquier worker
+// ---------------------------------------------------------------------------
+
+// Finalizador de SplitMix64
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Número uniforme en [0, 1) para la coordenada dim del punto index
+static inline double hash_uniform(uint64_t seed, uint64_t index, int dim) {
+    uint64_t bits = mix64(seed ^ mix64(index * MC_MAX_DIM + (uint64_t)dim + 0x9e3779b97f4a7c15ULL));
+    return (double)(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline uint32_t reverse_bits32(uint32_t x) {
+    x = ((x & 0x55555555u) << 1) | ((x >> 1) & 0x55555555u);
+    x = ((x & 0x33333333u) << 2) | ((x >> 2) & 0x33333333u);
+    x = ((x & 0x0f0f0f0fu) << 4) | ((x >> 4) & 0x0f0f0f0fu);
+    x = ((x & 0x00ff00ffu) << 8) | ((x >> 8) & 0x00ff00ffu);
+    return (x << 16) | (x >> 16);
+}
+
+// Aleatorización de Owen basada en hash (Burley, 2020): permuta los dígitos
+// binarios de forma anidada, conserva la estructura (t,m,s) de Sobol y hace
+// que cada semilla dé una réplica independiente e insesgada
+static inline uint32_t nested_uniform_scramble(uint32_t x, uint32_t seed) {
+    x = reverse_bits32(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverse_bits32(x);
+}
+
+// Números de dirección de Sobol (Joe y Kuo, new-joe-kuo-6.21201) para las
+// dimensiones 2..8; la dimensión 1 es van der Corput en base 2
+static const struct { int s; int a; int m[5]; } mc_sobol_poly[MC_MAX_DIM - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}}
+};
+
+static uint32_t mc_sobol_v[MC_MAX_DIM][32];
+static int mc_sobol_ready = 0;
+
+// Debe llamarse antes de crear hilos o procesos (lo hace mc_design_init)
+static inline void mc_sobol_init(void) {
+    if (mc_sobol_ready) {
+        return;
+    }
+    for (int bit = 0; bit < 32; bit++) {
+        mc_sobol_v[0][bit] = 1u << (31 - bit);
+    }
+    for (int d = 1; d < MC_MAX_DIM; d++) {
+        int s = mc_sobol_poly[d - 1].s;
+        int a = mc_sobol_poly[d - 1].a;
+        uint32_t* v = mc_sobol_v[d];
+        for (int i = 0; i < s; i++) {
+            v[i] = (uint32_t)mc_sobol_poly[d - 1].m[i] << (31 - i);
+        }
+        for (int i = s; i < 32; i++) {
+            v[i] = v[i - s] ^ (v[i - s] >> s);
+            for (int k = 1; k < s; k++) {
+                v[i] ^= ((a >> (s - 1 - k)) & 1) * v[i - k];
+            }
+        }
+    }
+    mc_sobol_ready = 1;
+}
+
+// Punto de Sobol sin aleatorizar para el índice en código Gray g: el
+// orden Gray permite pasar al punto siguiente con un solo XOR
+static inline uint32_t mc_sobol_raw(uint32_t gray, int dim) {
+    uint32_t x = 0;
+    // Sin saltos: los bits del índice son impredecibles para el predictor
+    for (int bit = 0; gray != 0; bit++, gray >>= 1) {
+        x ^= mc_sobol_v[dim][bit] & (0u - (gray & 1u));
+    }
+    return x;
+}
+
+// Cada bloque de 2^32 índices es una réplica de Sobol con su propia
+// aleatorización, lo que mantiene el estimador insesgado en corridas largas
+static inline uint32_t mc_sobol_seed(uint64_t seed, uint64_t index, int dim) {
+    return (uint32_t)mix64(seed + (index >> 32) * MC_MAX_DIM + dim);
+}
+
+static inline double mc_sobol(uint64_t index, int dim, uint64_t seed) {
+    uint32_t low = (uint32_t)index;
+    uint32_t x = mc_sobol_raw(low ^ (low >> 1), dim);
+    return nested_uniform_scramble(x, mc_sobol_seed(seed, index, dim)) * (1.0 / 4294967296.0);
+}
+
+static inline double radical_inverse(uint64_t index, uint32_t base) {
+    double inv_base = 1.0 / base;
+    double factor = inv_base;
+    double result = 0.0;
+    while (index > 0) {
+        result += (double)(index % base) * factor;
+        index /= base;
+        factor *= inv_base;
+    }
+    return result;
+}
+
+static const uint32_t mc_halton_bases[MC_MAX_DIM] = {2, 3, 5, 7, 11, 13, 17, 19};
+
+// ---------------------------------------------------------------------------
+// Diseño de muestreo: modo + dimensión + número total de puntos
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    sampling_mode_t mode;
+    int dim;
+    uint64_t total;
+    uint64_t seed;
+    uint64_t strata_side;           // lado de la rejilla estratificada
+    uint64_t strata;                // strata_side^dim celdas
+    double halton_shift[MC_MAX_DIM]; // rotación de Cranley-Patterson
+} mc_design_t;
+
+static inline void mc_design_init(mc_design_t* design, sampling_mode_t mode, int dim,
+                                  uint64_t total, uint64_t seed) {
+    design->mode = mode;
+    design->dim = dim;
+    design->total = total;
+    design->seed = seed;
+
+    // Rejilla m^d con m = floor(total^(1/d)); el resto se muestrea uniforme
+    uint64_t side = (uint64_t)pow((double)total, 1.0 / dim);
+    for (;;) {
+        uint64_t cells = 1;
+        for (int d = 0; d < dim; d++) cells *= side + 1;
+        if (cells > total) break;
+        side++;
+    }
+    while (side > 1) {
+        uint64_t cells = 1;
+        for (int d = 0; d < dim; d++) cells *= side;
+        if (cells <= total) break;
+        side--;
+    }
+    design->strata_side = side > 0 ? side : 1;
+    design->strata = 1;
+    for (int d = 0; d < dim; d++) {
+        design->strata *= design->strata_side;
+    }
+
+    for (int d = 0; d < MC_MAX_DIM; d++) {
+        design->halton_shift[d] = hash_uniform(seed, 0, d);
+    }
+    mc_sobol_init();
+}
+
+// Escribe el punto index en u[0], u[stride], ..., u[(dim - 1) * stride]
+static inline void mc_sample_point(const mc_design_t* design, uint64_t index,
+                                   double* u, int stride) {
+    int dim = design->dim;
+    uint64_t seed = design->seed;
+
+    switch (design->mode) {
+        case SAMPLING_STRATIFIED:
+            if (index < design->strata) {
+                uint64_t cell = index;
+                for (int d = 0; d < dim; d++) {
+                    uint64_t coord = cell % design->strata_side;
+                    cell /= design->strata_side;
+                    u[d * stride] = (coord + hash_uniform(seed, index, d)) / design->strata_side;
+                }
+                return;
+            }
+            break;
+        case SAMPLING_ANTITHETIC:
+            // Pares (u, 1 - u): para integrandos monótonos en cada coordenada
+            // los dos puntos quedan anticorrelados
+            for (int d = 0; d < dim; d++) {
+                double value = hash_uniform(seed, index / 2, d);
+                u[d * stride] = (index & 1) ? 1.0 - value : value;
+            }
+            return;
+        case SAMPLING_SOBOL:
+            for (int d = 0; d < dim; d++) {
+                u[d * stride] = mc_sobol(index, d, seed);
+            }
+            return;
+        case SAMPLING_HALTON:
+            for (int d = 0; d < dim; d++) {
+                double value = radical_inverse(index + 1, mc_halton_bases[d]) + design->halton_shift[d];
+                u[d * stride] = value - (int)value;
+            }
+            return;
+        case SAMPLING_UNIFORM:
+            break;
+    }
+
+    for (int d = 0; d < dim; d++) {
+        u[d * stride] = hash_uniform(seed, index, d);
+    }
+}
+
+// Llena un lote en formato SoA: coordenada d del punto j en u[d * MC_BATCH + j]
+static inline void mc_sample_batch(const mc_design_t* design, uint64_t first, int len, double* u) {
+    if (design->mode == SAMPLING_UNIFORM) {
+        for (int d = 0; d < design->dim; d++) {
+            for (int j = 0; j < len; j++) {
+                u[d * MC_BATCH + j] = hash_uniform(design->seed, first + j, d);
+            }
+        }
+        return;
+    }
+    if (design->mode == SAMPLING_SOBOL && (first >> 32) == ((first + len - 1) >> 32)) {
+        // Recorrido en orden Gray: x(i + 1) = x(i) XOR v[ctz(i + 1)]
+        for (int d = 0; d < design->dim; d++) {
+            uint32_t low = (uint32_t)first;
+            uint32_t x = mc_sobol_raw(low ^ (low >> 1), d);
+            uint32_t scramble_seed = mc_sobol_seed(design->seed, first, d);
+            for (int j = 0; j < len; j++) {
+                u[d * MC_BATCH + j] = nested_uniform_scramble(x, scramble_seed) * (1.0 / 4294967296.0);
+                low++;
+                x ^= mc_sobol_v[d][__builtin_ctz(low ? low : 1)];
+            }
+        }
+        return;
+    }
+    for (int j = 0; j < len; j++) {
+        mc_sample_point(design, first + j, &u[j], MC_BATCH);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Acumuladores
+// ---------------------------------------------------------------------------
+
+// hits cuenta los puntos con f(u) != 0: para integrandos indicadores es la
+// suma exacta en 64 bits, sin el límite de 2^53 de la suma en double
+typedef struct {
+    double sum;
+    double sum_sq;
+    uint64_t count;
+    uint64_t hits;
+} mc_sum_t;
+
+// Un resultado por worker, alineado a línea de cache para evitar falso
+// compartido entre hilos y entre procesos que escriben en memoria compartida
+typedef struct {
+    mc_sum_t value;
+} __attribute__((aligned(64))) mc_slot_t;
+
+static inline void mc_sum_add(mc_sum_t* total, const mc_sum_t* partial) {
+    total->sum += partial->sum;
+    total->sum_sq += partial->sum_sq;
+    total->count += partial->count;
+    total->hits += partial->hits;
+}
+
+static inline double mc_mean(const mc_sum_t* s) {
+    return s->count > 0 ? s->sum / s->count : 0.0;
+}
+
+// Fracción exacta de aciertos para integrandos indicadores
+static inline double mc_hit_ratio(const mc_sum_t* s) {
+    return s->count > 0 ? (double)s->hits / (double)s->count : 0.0;
+}
+
+// Error estándar de la media (sólo significativo para muestreo aleatorio)
+static inline double mc_std_error(const mc_sum_t* s) {
+    if (s->count < 2) return 0.0;
+    double mean = mc_mean(s);
+    double variance = s->sum_sq / s->count - mean * mean;
+    return variance > 0.0 ? sqrt(variance / s->count) : 0.0;
+}
+
+// Tramo [begin, end) del worker w al repartir count índices entre workers
+static inline void mc_partition(uint64_t first, uint64_t count, int workers, int w,
+                                uint64_t* begin, uint64_t* end) {
+    uint64_t base = count / workers;
+    uint64_t extra = count % workers;
+    *begin = first + w * base + ((uint64_t)w < extra ? (uint64_t)w : extra);
+    *end = *begin + base + ((uint64_t)w < extra ? 1 : 0);
+}
+
+// ---------------------------------------------------------------------------
+// Pool de hilos persistente: se crea una vez y se reutiliza entre llamadas
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    pthread_t threads[MC_MAX_WORKERS];
+    int num_threads;
+    int pending;
+    int stop;
+    unsigned long generation;
+    void (*task)(void* arg, int worker);
+    void* arg;
+} mc_thread_pool_t;
+
+static mc_thread_pool_t mc_pool = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    {0}, 0, 0, 0, 0, NULL, NULL
+};
+
+typedef struct {
+    int worker;
+    unsigned long generation; // generación al crear el hilo: no es trabajo suyo
+} mc_pool_worker_arg_t;
+
+static mc_pool_worker_arg_t mc_pool_args[MC_MAX_WORKERS];
+
+static inline void* mc_pool_worker(void* arg) {
+    int worker = ((mc_pool_worker_arg_t*)arg)->worker;
+    unsigned long seen = ((mc_pool_worker_arg_t*)arg)->generation;
+
+    pthread_mutex_lock(&mc_pool.mutex);
+    for (;;) {
+        while (!mc_pool.stop && mc_pool.generation == seen) {
+            pthread_cond_wait(&mc_pool.work_ready, &mc_pool.mutex);
+        }
+        if (mc_pool.stop) break;
+        seen = mc_pool.generation;
+        void (*task)(void*, int) = mc_pool.task;
+        void* task_arg = mc_pool.arg;
+        pthread_mutex_unlock(&mc_pool.mutex);
+
+        task(task_arg, worker);
+
+        pthread_mutex_lock(&mc_pool.mutex);
+        if (--mc_pool.pending == 0) {
+            pthread_cond_signal(&mc_pool.work_done);
+        }
+    }
+    pthread_mutex_unlock(&mc_pool.mutex);
+    return NULL;
+}
+
+static inline void mc_pool_shutdown(void) {
+    pthread_mutex_lock(&mc_pool.mutex);
+    mc_pool.stop = 1;
+    pthread_cond_broadcast(&mc_pool.work_ready);
+    pthread_mutex_unlock(&mc_pool.mutex);
+    for (int i = 0; i < mc_pool.num_threads; i++) {
+        pthread_join(mc_pool.threads[i], NULL);
+    }
+    mc_pool.num_threads = 0;
+    mc_pool.stop = 0;
+}
+
+// Ejecuta task(arg, w) para w = 0..num_threads-1 y espera a que terminen
+static inline void mc_pool_run(int num_threads, void (*task)(void*, int), void* arg) {
+    if (num_threads > MC_MAX_WORKERS) num_threads = MC_MAX_WORKERS;
+    if (mc_pool.num_threads != num_threads) {
+        if (mc_pool.num_threads > 0) {
+            mc_pool_shutdown();
+        }
+        // generation no se reinicia entre pools: un hilo nuevo que partiera
+        // de 0 ejecutaría la tarea de la llamada anterior
+        pthread_mutex_lock(&mc_pool.mutex);
+        unsigned long generation = mc_pool.generation;
+        pthread_mutex_unlock(&mc_pool.mutex);
+        for (int i = 0; i < num_threads; i++) {
+            mc_pool_args[i].worker = i;
+            mc_pool_args[i].generation = generation;
+            pthread_create(&mc_pool.threads[i], NULL, mc_pool_worker, &mc_pool_args[i]);
+        }
+        mc_pool.num_threads = num_threads;
+    }
+
+    pthread_mutex_lock(&mc_pool.mutex);
+    mc_pool.task = task;
+    mc_pool.arg = arg;
+    mc_pool.pending = num_threads;
+    mc_pool.generation++;
+    pthread_cond_broadcast(&mc_pool.work_ready);
+    while (mc_pool.pending > 0) {
+        pthread_cond_wait(&mc_pool.work_done, &mc_pool.mutex);
+    }
+    pthread_mutex_unlock(&mc_pool.mutex);
+}
+
+// ---------------------------------------------------------------------------
+// Procesos: pool pre-creado (pool_procesos.h) que se reutiliza entre llamadas
+// ---------------------------------------------------------------------------
+
+static pool_procesos_t* mc_process_pool = NULL;
+
+// Los hijos ven el estado global del momento del fork: las tablas de Sobol
+// se inicializan antes de crearlos
+static inline pool_procesos_t* mc_get_process_pool(int num_processes) {
+    if (num_processes > MC_MAX_WORKERS) num_processes = MC_MAX_WORKERS;
+    if (mc_process_pool != NULL && pool_num_trabajadores(mc_process_pool) != num_processes) {
+        pool_destruir(mc_process_pool);
+        mc_process_pool = NULL;
+    }
+    if (mc_process_pool == NULL) {
+        mc_sobol_init();
+        mc_process_pool = pool_crear(num_processes);
+    }
+    return mc_process_pool;
+}
+
+// Libera los pools persistentes de hilos y de procesos
+static inline void mc_shutdown(void) {
+    if (mc_pool.num_threads > 0) {
+        mc_pool_shutdown();
+    }
+    if (mc_process_pool != NULL) {
+        pool_destruir(mc_process_pool);
+        mc_process_pool = NULL;
+    }
+}
+
+#endif
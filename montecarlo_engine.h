@@ -0,0 +1,171 @@
+// Plantilla del motor Monte Carlo. Se incluye una vez por problema con:
+//
+//   #define MC_NAME       prefijo de las funciones generadas (p. ej. dartboard)
+//   #define MC_DIM        dimensión del dominio [0,1]^MC_DIM
+//   #define MC_PARAMS     tipo de los parámetros del problema (mc_no_params_t si
+//                         no tiene); se copia por valor a los procesos del pool
+//   #define MC_INTEGRAND  función f(const MC_PARAMS* p, const double* u, int stride)
+//                         que lee la coordenada d en u[d * stride]
+//   #include "montecarlo_engine.h"
+//
+// y genera MC_NAME_serial, _simd, _threads, _processes y _run, que devuelven
+// la suma de f sobre los puntos [first, first + count) del diseño. La media
+// de f estima la integral de f sobre el hipercubo unitario.
+
+#include "montecarlo.h"
+
+#if !defined(MC_NAME) || !defined(MC_DIM) || !defined(MC_PARAMS) || !defined(MC_INTEGRAND)
+#error "Definir MC_NAME, MC_DIM, MC_PARAMS y MC_INTEGRAND antes de incluir montecarlo_engine.h"
+#endif
+
+#define MC_CAT_(a, b) a##_##b
+#define MC_CAT(a, b) MC_CAT_(a, b)
+#define MC_FN(suffix) MC_CAT(MC_NAME, suffix)
+
+// Referencia: un punto cada vez, igual que los bucles originales
+static inline mc_sum_t MC_FN(serial)(const MC_PARAMS* params, const mc_design_t* design,
+                                     uint64_t first, uint64_t count) {
+    mc_sum_t result = {0.0, 0.0, count, 0};
+    double u[MC_DIM];
+
+    for (uint64_t i = first; i < first + count; i++) {
+        mc_sample_point(design, i, u, 1);
+        double value = MC_INTEGRAND(params, u, 1);
+        result.sum += value;
+        result.sum_sq += value * value;
+        result.hits += (value != 0.0);
+    }
+    return result;
+}
+
+// Lotes de MC_BATCH puntos en formato SoA: el muestreo uniforme y la
+// evaluación del integrando quedan como bucles sin dependencias que el
+// compilador vectoriza
+static inline mc_sum_t MC_FN(simd)(const MC_PARAMS* params, const mc_design_t* design,
+                                   uint64_t first, uint64_t count) {
+    mc_sum_t result = {0.0, 0.0, count, 0};
+    double u[MC_DIM * MC_BATCH];
+    double values[MC_BATCH];
+
+    for (uint64_t start = first; start < first + count; start += MC_BATCH) {
+        uint64_t remaining = first + count - start;
+        int len = remaining < MC_BATCH ? (int)remaining : MC_BATCH;
+
+        mc_sample_batch(design, start, len, u);
+#ifdef __GNUC__
+#pragma GCC ivdep
+#endif
+        for (int j = 0; j < len; j++) {
+            values[j] = MC_INTEGRAND(params, &u[j], MC_BATCH);
+        }
+        double batch_sum = 0.0, batch_sum_sq = 0.0;
+        uint64_t batch_hits = 0;
+        for (int j = 0; j < len; j++) {
+            batch_sum += values[j];
+            batch_sum_sq += values[j] * values[j];
+            batch_hits += (values[j] != 0.0);
+        }
+        result.sum += batch_sum;
+        result.sum_sq += batch_sum_sq;
+        result.hits += batch_hits;
+    }
+    return result;
+}
+
+typedef struct {
+    const MC_PARAMS* params;
+    const mc_design_t* design;
+    uint64_t first;
+    uint64_t count;
+    int num_workers;
+    mc_slot_t* slots;
+} MC_FN(task_t);
+
+static inline void MC_FN(task)(void* arg, int worker) {
+    MC_FN(task_t)* task = (MC_FN(task_t)*)arg;
+    uint64_t begin, end;
+    mc_partition(task->first, task->count, task->num_workers, worker, &begin, &end);
+    task->slots[worker].value = MC_FN(simd)(task->params, task->design, begin, end - begin);
+}
+
+static inline mc_sum_t MC_FN(threads)(const MC_PARAMS* params, const mc_design_t* design,
+                                      uint64_t first, uint64_t count, int num_threads) {
+    // El mismo límite que mc_pool_run: las muestras se reparten entre los
+    // hilos que de verdad corren
+    if (num_threads > MC_MAX_WORKERS) num_threads = MC_MAX_WORKERS;
+    mc_slot_t* slots = (mc_slot_t*)aligned_alloc(64, num_threads * sizeof(mc_slot_t));
+    MC_FN(task_t) task = {params, design, first, count, num_threads, slots};
+
+    mc_pool_run(num_threads, MC_FN(task), &task);
+
+    mc_sum_t result = {0.0, 0.0, 0, 0};
+    for (int w = 0; w < num_threads; w++) {
+        mc_sum_add(&result, &slots[w].value);
+    }
+    free(slots);
+    return result;
+}
+
+typedef struct {
+    mc_design_t design;
+    MC_PARAMS params;
+    uint64_t begin;
+    uint64_t count;
+} MC_FN(job_t);
+
+// Se ejecuta en un proceso del pool con una copia del diseño y los parámetros
+static inline void MC_FN(process_job)(const void* data, void* slot, int worker) {
+    (void)worker;
+    const MC_FN(job_t)* job = (const MC_FN(job_t)*)data;
+    mc_sum_t result = MC_FN(simd)(&job->params, &job->design, job->begin, job->count);
+    memcpy(slot, &result, sizeof(result));
+}
+
+static inline mc_sum_t MC_FN(processes)(const MC_PARAMS* params, const mc_design_t* design,
+                                        uint64_t first, uint64_t count, int num_processes) {
+    pool_procesos_t* pool = mc_get_process_pool(num_processes);
+    num_processes = pool_num_trabajadores(pool);
+
+    // Un trabajo por proceso; cada uno deja sus sumas en su ranura compartida
+    for (int p = 0; p < num_processes; p++) {
+        MC_FN(job_t) job;
+        memset(&job, 0, sizeof(job));
+        job.design = *design;
+        if (params != NULL) job.params = *params;
+        mc_partition(first, count, num_processes, p, &job.begin, &job.count);
+        job.count -= job.begin;
+        pool_enviar(pool, MC_FN(process_job), &job, sizeof(job), p);
+    }
+    if (pool_esperar(pool) > 0) {
+        fprintf(stderr, "Error: uno o más procesos del pool fallaron\n");
+        exit(1);
+    }
+
+    mc_sum_t result = {0.0, 0.0, 0, 0};
+    for (int p = 0; p < num_processes; p++) {
+        mc_sum_t partial;
+        memcpy(&partial, pool_ranura(pool, p), sizeof(partial));
+        mc_sum_add(&result, &partial);
+    }
+    return result;
+}
+
+static inline mc_sum_t MC_FN(run)(mc_backend_t backend, const MC_PARAMS* params,
+                                  const mc_design_t* design, uint64_t first, uint64_t count,
+                                  int num_workers) {
+    switch (backend) {
+        case MC_BACKEND_SIMD:      return MC_FN(simd)(params, design, first, count);
+        case MC_BACKEND_THREADS:   return MC_FN(threads)(params, design, first, count, num_workers);
+        case MC_BACKEND_PROCESSES: return MC_FN(processes)(params, design, first, count, num_workers);
+        case MC_BACKEND_SERIAL:
+        default:                   return MC_FN(serial)(params, design, first, count);
+    }
+}
+
+#undef MC_FN
+#undef MC_CAT
+#undef MC_CAT_
+#undef MC_NAME
+#undef MC_DIM
+#undef MC_PARAMS
+#undef MC_INTEGRAND
@@ -0,0 +1,55 @@
+#ifndef MONTECARLO_PROBLEMS_H
+#define MONTECARLO_PROBLEMS_H
+
+#include <math.h>
+#include "montecarlo.h"
+
+// Dartboard y Buffon como instancias del motor Monte Carlo genérico
+
+// Dartboard: indicador del cuarto de círculo unitario en [0,1]^2; la
+// fracción de puntos dentro es π/4
+static inline double dartboard_integrand(const mc_no_params_t* params, const double* u, int stride) {
+    (void)params;
+    double x = u[0];
+    double y = u[stride];
+    return (x * x + y * y <= 1.0) ? 1.0 : 0.0;
+}
+
+#define MC_NAME dartboard
+#define MC_DIM 2
+#define MC_PARAMS mc_no_params_t
+#define MC_INTEGRAND dartboard_integrand
+#include "montecarlo_engine.h"
+
+static inline double dartboard_estimate(const mc_sum_t* result) {
+    return 4.0 * mc_hit_ratio(result);
+}
+
+// Buffon: posición del centro x en [0, line_distance] y ángulo θ en [0, π];
+// la aguja cruza una línea con probabilidad 2L / (π D) cuando L <= D
+typedef struct {
+    double needle_length;
+    double line_distance;
+} buffon_params_t;
+
+static inline double buffon_integrand(const buffon_params_t* params, const double* u, int stride) {
+    double x = u[0] * params->line_distance;
+    double theta = u[stride] * M_PI;
+    double half_span = (params->needle_length / 2.0) * sin(theta);
+
+    return (x - half_span < 0.0 || x + half_span > params->line_distance) ? 1.0 : 0.0;
+}
+
+#define MC_NAME buffon
+#define MC_DIM 2
+#define MC_PARAMS buffon_params_t
+#define MC_INTEGRAND buffon_integrand
+#include "montecarlo_engine.h"
+
+// Calcular π usando la fórmula de Buffon
+static inline double buffon_estimate(const buffon_params_t* params, const mc_sum_t* result) {
+    double probability = mc_hit_ratio(result);
+    return (2.0 * params->needle_length) / (probability * params->line_distance);
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef ACUMULADORES_H
+#define ACUMULADORES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+// Modos de acumulación para C = A * B con entradas int. Los kernels de los
+// programas acumulan en int, que desborda (comportamiento indefinido) en
+// cuanto n * max|A| * max|B| pasa de 2^31. Aquí el resultado es de 64 bits
+// y la suma se hace en uno de estos modos:
+//   - int32:     32 bits módulo 2^32 (lo que hacen los kernels, sin UB)
+//   - saturado:  32 bits con saturación en INT32_MIN / INT32_MAX
+//   - int64:     64 bits
+//   - periodico: 32 bits durante un tramo de k que no puede desbordar,
+//                volcado luego a 64 bits; exacto y casi al costo de int32
+//
+// El kernel recorre C por filas en orden i-k-j: el bucle interno sobre j es
+// contiguo en B y en el acumulador, y el compilador lo vectoriza en los
+// cuatro modos. Con --acumulador=modo los kernels medidos de cada programa
+// pasan a ser estos: el optimizado reparte multiplicar_filas_acumulador con
+// su propio ejecutor y el original usa multiplicar_filas_acumulador_original
+// (i-j-k), que suma k en el mismo orden, así que los dos resultados deben ser
+// idénticos en todos los modos y eso es lo que se verifica. Con
+// --acumulador=todos, comparar_modos_acumulador mide además el costo de cada
+// modo.
+
+#define ACUM_BLOQUE_J 256  // columnas de C por acumulador (cabe en L1)
+#define ACUM_FILAS_BLOQUE 16
+
+typedef enum {
+    ACUM_INT32,
+    ACUM_SATURADO,
+    ACUM_INT64,
+    ACUM_PERIODICO,
+    ACUM_NUM_MODOS
+} modo_acumulador_t;
+
+#define ACUM_TODOS (-1)
+
+static inline const char *nombre_modo_acumulador(int modo) {
+    switch (modo) {
+        case ACUM_INT32:     return "int32";
+        case ACUM_SATURADO:  return "saturado";
+        case ACUM_INT64:     return "int64";
+        case ACUM_PERIODICO: return "periodico";
+        default:             return "todos";
+    }
+}
+
+// Modo elegido con --acumulador para los kernels medidos (no "todos")
+static inline int acumulador_en_kernels(int modo) {
+    return modo >= 0 && modo < ACUM_NUM_MODOS;
+}
+
+// Acepta "--acumulador=int32|saturado|int64|periodico|todos"
+static inline int parse_opcion_acumulador(const char *texto, int *modo) {
+    if (strncmp(texto, "--acumulador=", 13) != 0) return -1;
+    for (int m = ACUM_TODOS; m < ACUM_NUM_MODOS; m++) {
+        if (strcmp(texto + 13, nombre_modo_acumulador(m)) == 0) {
+            *modo = m;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Pasos de k que el modo periódico puede sumar en 32 bits sin desbordar:
+// INT32_MAX / (max|A| * max|B|), como mucho n. Devuelve 0 si un solo
+// producto ya no cabe en 32 bits (el modo periódico pasa a ser int64)
+static inline int tramo_periodico(int **A, int **B, int n) {
+    int64_t max_a = 0, max_b = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int64_t a = A[i][j] < 0 ? -(int64_t)A[i][j] : A[i][j];
+            int64_t b = B[i][j] < 0 ? -(int64_t)B[i][j] : B[i][j];
+            if (a > max_a) max_a = a;
+            if (b > max_b) max_b = b;
+        }
+    }
+    if (max_a == 0 || max_b == 0) return n;
+    int64_t tramo = INT32_MAX / (max_a * max_b);
+    return tramo < n ? (int)tramo : n;
+}
+
+// Filas [fila_inicio, fila_fin) de C = A * B; C es n x n contigua
+static inline void multiplicar_filas_acumulador(int **A, int **B, int64_t *C, int n,
+                                                int fila_inicio, int fila_fin,
+                                                modo_acumulador_t modo, int tramo) {
+    if (modo == ACUM_PERIODICO && tramo == 0) modo = ACUM_INT64;
+
+    for (int jj = 0; jj < n; jj += ACUM_BLOQUE_J) {
+        int ancho = (jj + ACUM_BLOQUE_J < n) ? ACUM_BLOQUE_J : n - jj;
+
+        for (int i = fila_inicio; i < fila_fin; i++) {
+            const int *a = A[i];
+            int64_t *c = C + (size_t)i * n + jj;
+
+            switch (modo) {
+                case ACUM_INT32: {
+                    uint32_t acc[ACUM_BLOQUE_J] = {0};
+                    for (int k = 0; k < n; k++) {
+                        uint32_t aik = (uint32_t)a[k];
+                        const int *b = B[k] + jj;
+#ifdef __GNUC__
+#pragma GCC ivdep
+#endif
+                        for (int j = 0; j < ancho; j++) acc[j] += aik * (uint32_t)b[j];
+                    }
+                    for (int j = 0; j < ancho; j++) c[j] = (int32_t)acc[j];
+                    break;
+                }
+                case ACUM_SATURADO: {
+                    int32_t acc[ACUM_BLOQUE_J] = {0};
+                    for (int k = 0; k < n; k++) {
+                        int64_t aik = a[k];
+                        const int *b = B[k] + jj;
+#ifdef __GNUC__
+#pragma GCC ivdep
+#endif
+                        for (int j = 0; j < ancho; j++) {
+                            int64_t s = (int64_t)acc[j] + aik * b[j];
+                            s = s > INT32_MAX ? INT32_MAX : s;
+                            s = s < INT32_MIN ? INT32_MIN : s;
+                            acc[j] = (int32_t)s;
+                        }
+                    }
+                    for (int j = 0; j < ancho; j++) c[j] = acc[j];
+                    break;
+                }
+                case ACUM_INT64: {
+                    int64_t acc[ACUM_BLOQUE_J] = {0};
+                    for (int k = 0; k < n; k++) {
+                        int64_t aik = a[k];
+                        const int *b = B[k] + jj;
+#ifdef __GNUC__
+#pragma GCC ivdep
+#endif
+                        for (int j = 0; j < ancho; j++) acc[j] += aik * b[j];
+                    }
+                    for (int j = 0; j < ancho; j++) c[j] = acc[j];
+                    break;
+                }
+                case ACUM_PERIODICO:
+                default: {
+                    int64_t total[ACUM_BLOQUE_J] = {0};
+                    int32_t parcial[ACUM_BLOQUE_J];
+                    for (int kk = 0; kk < n; kk += tramo) {
+                        int k_end = (kk + tramo < n) ? kk + tramo : n;
+                        memset(parcial, 0, ancho * sizeof(int32_t));
+                        for (int k = kk; k < k_end; k++) {
+                            int32_t aik = a[k];
+                            const int *b = B[k] + jj;
+#ifdef __GNUC__
+#pragma GCC ivdep
+#endif
+                            for (int j = 0; j < ancho; j++) parcial[j] += aik * b[j];
+                        }
+                        for (int j = 0; j < ancho; j++) total[j] += parcial[j];
+                    }
+                    for (int j = 0; j < ancho; j++) c[j] = total[j];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Filas [fila_inicio, fila_fin) de C = A * B como en los kernels originales:
+// un producto punto por elemento, k de 0 a n - 1 con los mismos tramos que
+// multiplicar_filas_acumulador
+static inline void multiplicar_filas_acumulador_original(int **A, int **B, int64_t *C, int n,
+                                                         int fila_inicio, int fila_fin,
+                                                         modo_acumulador_t modo, int tramo) {
+    if (modo == ACUM_PERIODICO && tramo == 0) modo = ACUM_INT64;
+
+    for (int i = fila_inicio; i < fila_fin; i++) {
+        const int *a = A[i];
+        for (int j = 0; j < n; j++) {
+            int64_t resultado = 0;
+            switch (modo) {
+                case ACUM_INT32: {
+                    uint32_t acc = 0;
+                    for (int k = 0; k < n; k++) acc += (uint32_t)a[k] * (uint32_t)B[k][j];
+                    resultado = (int32_t)acc;
+                    break;
+                }
+                case ACUM_SATURADO: {
+                    int32_t acc = 0;
+                    for (int k = 0; k < n; k++) {
+                        int64_t s = (int64_t)acc + (int64_t)a[k] * B[k][j];
+                        s = s > INT32_MAX ? INT32_MAX : s;
+                        s = s < INT32_MIN ? INT32_MIN : s;
+                        acc = (int32_t)s;
+                    }
+                    resultado = acc;
+                    break;
+                }
+                case ACUM_INT64: {
+                    for (int k = 0; k < n; k++) resultado += (int64_t)a[k] * B[k][j];
+                    break;
+                }
+                case ACUM_PERIODICO:
+                default: {
+                    for (int kk = 0; kk < n; kk += tramo) {
+                        int k_end = (kk + tramo < n) ? kk + tramo : n;
+                        int32_t parcial = 0;
+                        for (int k = kk; k < k_end; k++) parcial += a[k] * B[k][j];
+                        resultado += parcial;
+                    }
+                    break;
+                }
+            }
+            C[(size_t)i * n + j] = resultado;
+        }
+    }
+}
+
+// Resultados de 64 bits de los kernels original y optimizado en el modo
+// elegido, con su verificación
+static inline int64_t *crear_resultado_acumulador(int n) {
+    int64_t *C = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+    if (C == NULL) {
+        printf("Error: No se pudo asignar memoria para los resultados de 64 bits\n");
+        exit(1);
+    }
+    return C;
+}
+
+static inline void verificar_acumulador(const int64_t *original, const int64_t *optimizado, int n, int modo) {
+    int iguales = memcmp(original, optimizado, (size_t)n * n * sizeof(int64_t)) == 0;
+    printf("Verificación (original vs optimizada, acumulador %s): %s\n\n",
+           nombre_modo_acumulador(modo), iguales ? "correcta" : "INCORRECTA");
+}
+
+// Calcula C completa en el modo dado con la estrategia de paralelización
+// del programa (hilos, OpenMP, procesos...)
+typedef void (*ejecutor_acumulador_t)(int **A, int **B, int64_t *C, int n,
+                                      modo_acumulador_t modo, int tramo, void *contexto);
+
+static inline double acumulador_tiempo_s(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Mide int32 (referencia de costo), int64 (referencia de valor) y el modo
+// pedido, o los cuatro con ACUM_TODOS. C y R son n x n contiguas: R recibe
+// el resultado int64 y C el de cada modo, que se compara contra R
+static inline void comparar_modos_acumulador(int **A, int **B, int64_t *C, int64_t *R, int n,
+                                             int modo_pedido, ejecutor_acumulador_t ejecutor,
+                                             void *contexto) {
+    int tramo = tramo_periodico(A, B, n);
+    size_t elementos = (size_t)n * n;
+
+    printf("--- MODOS DE ACUMULACIÓN ---\n");
+    if (tramo > 0) {
+        printf("Tramo del modo periódico: %d pasos de k entre volcados a int64\n", tramo);
+    } else {
+        printf("Tramo del modo periódico: un producto no cabe en int32, se acumula en int64\n");
+    }
+
+    double inicio = acumulador_tiempo_s();
+    ejecutor(A, B, R, n, ACUM_INT64, tramo, contexto);
+    double tiempo_int64 = acumulador_tiempo_s() - inicio;
+
+    size_t fuera_de_rango = 0;
+    for (size_t e = 0; e < elementos; e++) {
+        fuera_de_rango += R[e] > INT32_MAX || R[e] < INT32_MIN;
+    }
+    printf("Elementos de C fuera del rango de int32: %zu\n\n", fuera_de_rango);
+
+    double operaciones = 2.0 * n * n * n;
+    double tiempo_int32 = 0.0;
+    printf("%-10s %12s %10s %16s %20s\n", "Modo", "Tiempo (s)", "GOPS", "Costo vs int32", "Distintos de int64");
+    for (int m = 0; m < ACUM_NUM_MODOS; m++) {
+        if (modo_pedido != ACUM_TODOS && m != modo_pedido && m != ACUM_INT32 && m != ACUM_INT64) continue;
+
+        double tiempo = tiempo_int64;
+        size_t distintos = 0;
+        if (m != ACUM_INT64) {
+            inicio = acumulador_tiempo_s();
+            ejecutor(A, B, C, n, (modo_acumulador_t)m, tramo, contexto);
+            tiempo = acumulador_tiempo_s() - inicio;
+            for (size_t e = 0; e < elementos; e++) distintos += C[e] != R[e];
+        }
+        if (m == ACUM_INT32) tiempo_int32 = tiempo;
+
+        printf("%-10s %12.6f %10.2f %15.2fx %20zu\n", nombre_modo_acumulador(m), tiempo,
+               operaciones / tiempo / 1e9, tiempo / tiempo_int32, distintos);
+    }
+    printf("\n");
+}
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef APROXIMADA_H
+#define APROXIMADA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+// Producto aproximado C ~ A * B con un presupuesto de error relativo de
+// Frobenius eps (||AB - C||_F <= eps ||AB||_F en esperanza). Los dos métodos
+// reducen el producto a uno de rango s: C = U (n x s) * V (s x n), 2 n^2 s
+// operaciones en lugar de 2 n^3.
+//
+//   - muestreo columna-fila: s índices k con probabilidad proporcional a
+//     |A[:, k]| |B[k, :]|, cada término A[:, k] B[k, :] escalado por
+//     1 / (s p_k). E||E||_F^2 <= (sum_k |A[:, k]| |B[k, :]|)^2 / s
+//   - CountSketch: S de s x n con un único +-1 por columna en una fila al
+//     azar; C = (A S^T)(S B). E||E||_F^2 <= 2 ||A||_F^2 ||B||_F^2 / s.
+//     Todo es entero: el producto se hace sin signo (aritmética módulo 2^32,
+//     como kernels_fijos.h) y el resultado, del orden de AB, cabe en int
+//
+// s se despeja de la cota con ||AB||_F estimado con APROX_SONDAS vectores
+// de signos aleatorios (||AB||_F^2 = E||A B g||^2); si ni con la cota
+// ||AB||_F <= ||A||_F ||B||_F sale s < n, no se estima. Si s sale >= n el
+// método hace el producto exacto (todos los índices, S = identidad): no
+// hay aproximación que compense. Las cotas son en esperanza; el programa
+// mide el error obtenido. Con eps = 0 el método es el producto exacto.
+
+#define APROX_SONDAS 32
+#define APROX_BLOQUE_J 256 // columnas de C por bloque: el bloque de V queda en L2
+
+typedef enum {
+    APROX_MUESTREO,
+    APROX_COUNTSKETCH,
+    APROX_NUM_METODOS
+} metodo_aproximado_t;
+
+static inline const char *nombre_metodo_aproximado(metodo_aproximado_t m) {
+    switch (m) {
+        case APROX_MUESTREO:    return "muestreo col-fila";
+        case APROX_COUNTSKETCH: return "CountSketch";
+        default:                return "desconocido";
+    }
+}
+
+static inline int aprox_a_entero(double x) { return (int)llround(x); }
+static inline int aprox_a_entero(unsigned int x) { return (int)x; }
+
+// C = U * V con U de n x s y V de s x n contiguas (U[i * s + t], V[t * n + j])
+template <typename T>
+static void aprox_producto_rango(const T *U, const T *V, int **C, int n, int s) {
+    #pragma omp parallel
+    {
+        T *acumulado = (T *)malloc(APROX_BLOQUE_J * sizeof(T));
+        #pragma omp for collapse(2) schedule(static)
+        for (int jj = 0; jj < n; jj += APROX_BLOQUE_J) {
+            for (int i = 0; i < n; i++) {
+                int j_end = (jj + APROX_BLOQUE_J < n) ? jj + APROX_BLOQUE_J : n;
+                int ancho = j_end - jj;
+                for (int j = 0; j < ancho; j++) acumulado[j] = T();
+                const T *u = U + (size_t)i * s;
+                for (int t = 0; t < s; t++) {
+                    const T uit = u[t];
+                    const T *v = V + (size_t)t * n + jj;
+                    for (int j = 0; j < ancho; j++) {
+                        acumulado[j] += uit * v[j];
+                    }
+                }
+                for (int j = 0; j < ancho; j++) C[i][jj + j] = aprox_a_entero(acumulado[j]);
+            }
+        }
+        free(acumulado);
+    }
+}
+
+static inline double aprox_norma_frobenius2(int **M, int n) {
+    double suma = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:suma)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) suma += (double)M[i][j] * M[i][j];
+    }
+    return suma;
+}
+
+// Estimación de ||AB||_F^2 con sondas de signos: media de ||A (B g)||^2
+static inline double aprox_estimar_norma_producto2(int **A, int **B, int n, unsigned int semilla) {
+    double *g = (double *)malloc(n * sizeof(double));
+    double *y = (double *)malloc(n * sizeof(double));
+    double suma = 0.0;
+    for (int p = 0; p < APROX_SONDAS; p++) {
+        for (int k = 0; k < n; k++) g[k] = (rand_r(&semilla) & 1) ? 1.0 : -1.0;
+        #pragma omp parallel for schedule(static)
+        for (int k = 0; k < n; k++) {
+            double yk = 0.0;
+            for (int j = 0; j < n; j++) yk += B[k][j] * g[j];
+            y[k] = yk;
+        }
+        double norma = 0.0;
+        #pragma omp parallel for schedule(static) reduction(+:norma)
+        for (int i = 0; i < n; i++) {
+            double zi = 0.0;
+            for (int k = 0; k < n; k++) zi += A[i][k] * y[k];
+            norma += zi * zi;
+        }
+        suma += norma;
+    }
+    free(g);
+    free(y);
+    return suma / APROX_SONDAS;
+}
+
+// Rango s que cumple el presupuesto: cota(s) = numerador / s <= eps^2 ||AB||^2.
+// norma_a2_b2 = ||A||_F^2 ||B||_F^2 >= ||AB||_F^2 da el s mínimo posible
+static inline int aprox_rango_para_error(int **A, int **B, int n, double numerador, double norma_a2_b2, double error,
+                                         unsigned int semilla) {
+    if (!(error > 0.0) || !(numerador > 0.0) || numerador / (error * error * norma_a2_b2) >= n) return n;
+    double norma_ab2 = aprox_estimar_norma_producto2(A, B, n, semilla);
+    double s = ceil(numerador / (error * error * norma_ab2));
+    return (s >= n || !(s > 0)) ? n : (int)s;
+}
+
+static inline int multiplicar_aprox_countsketch(int **A, int **B, int **C, int n, double error, unsigned int semilla);
+
+// Muestreo columna-fila. Devuelve el rango usado (n si hizo el producto exacto)
+static inline int multiplicar_aprox_muestreo(int **A, int **B, int **C, int n, double error, unsigned int semilla) {
+    int s = n;
+    double *peso = (double *)malloc(n * sizeof(double)); // |A[:, k]| |B[k, :]|
+    if (error > 0.0) {
+        double *norma_col_a = (double *)calloc(n, sizeof(double));
+        #pragma omp parallel for schedule(static)
+        for (int k = 0; k < n; k++) {
+            double fila_b = 0.0;
+            for (int j = 0; j < n; j++) fila_b += (double)B[k][j] * B[k][j];
+            peso[k] = fila_b;
+        }
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < n; k++) norma_col_a[k] += (double)A[i][k] * A[i][k];
+        }
+        double suma_pesos = 0.0, norma_a2 = 0.0, norma_b2 = 0.0;
+        for (int k = 0; k < n; k++) {
+            norma_a2 += norma_col_a[k];
+            norma_b2 += peso[k];
+            peso[k] = sqrt(peso[k] * norma_col_a[k]);
+            suma_pesos += peso[k];
+        }
+        free(norma_col_a);
+        s = aprox_rango_para_error(A, B, n, suma_pesos * suma_pesos, norma_a2 * norma_b2, error, semilla);
+    }
+    if (s == n) {
+        // Sin aproximación que compense: producto exacto entero
+        free(peso);
+        return multiplicar_aprox_countsketch(A, B, C, n, 0.0, semilla);
+    }
+
+    // Factor de cada índice: 1 / (s p_k) por cada vez que sale; los
+    // repetidos se juntan, así que el rango efectivo puede ser menor que s
+    double *factor = (double *)calloc(n, sizeof(double));
+    double *acumulada = (double *)malloc(n * sizeof(double));
+    double total = 0.0;
+    for (int k = 0; k < n; k++) acumulada[k] = (total += peso[k]);
+    for (int t = 0; t < s; t++) {
+        double x = (double)rand_r(&semilla) / ((double)RAND_MAX + 1.0) * total;
+        int izquierda = 0, derecha = n - 1;
+        while (izquierda < derecha) {
+            int medio = (izquierda + derecha) / 2;
+            if (acumulada[medio] > x) derecha = medio; else izquierda = medio + 1;
+        }
+        factor[izquierda] += total / (s * peso[izquierda]);
+    }
+    free(acumulada);
+    free(peso);
+
+    int *indices = (int *)malloc(n * sizeof(int));
+    int rango = 0;
+    for (int k = 0; k < n; k++) {
+        if (factor[k] != 0.0) indices[rango++] = k;
+    }
+    double *U = (double *)malloc((size_t)n * rango * sizeof(double));
+    double *V = (double *)malloc((size_t)rango * n * sizeof(double));
+    if (U == NULL || V == NULL) {
+        printf("Error: No se pudo asignar memoria para el producto de rango %d\n", rango);
+        exit(1);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        for (int t = 0; t < rango; t++) U[(size_t)i * rango + t] = factor[indices[t]] * A[i][indices[t]];
+    }
+    #pragma omp parallel for schedule(static)
+    for (int t = 0; t < rango; t++) {
+        for (int j = 0; j < n; j++) V[(size_t)t * n + j] = B[indices[t]][j];
+    }
+    aprox_producto_rango(U, V, C, n, rango);
+
+    free(factor);
+    free(indices);
+    free(U);
+    free(V);
+    return rango;
+}
+
+// CountSketch. Devuelve el rango usado (n si hizo el producto exacto)
+static inline int multiplicar_aprox_countsketch(int **A, int **B, int **C, int n, double error, unsigned int semilla) {
+    int s = n;
+    if (error > 0.0) {
+        double norma_a2_b2 = aprox_norma_frobenius2(A, n) * aprox_norma_frobenius2(B, n);
+        s = aprox_rango_para_error(A, B, n, 2.0 * norma_a2_b2, norma_a2_b2, error, semilla);
+    }
+
+    int *cubeta = (int *)malloc(n * sizeof(int));
+    unsigned int *signo = (unsigned int *)malloc(n * sizeof(unsigned int));
+    for (int k = 0; k < n; k++) {
+        cubeta[k] = s == n ? k : rand_r(&semilla) % s;
+        signo[k] = (s == n || (rand_r(&semilla) & 1)) ? 1u : (unsigned int)-1;
+    }
+
+    unsigned int *U = (unsigned int *)calloc((size_t)n * s, sizeof(unsigned int)); // A S^T
+    unsigned int *V = (unsigned int *)calloc((size_t)s * n, sizeof(unsigned int)); // S B
+    if (U == NULL || V == NULL) {
+        printf("Error: No se pudo asignar memoria para el producto de rango %d\n", s);
+        exit(1);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int *u = U + (size_t)i * s;
+        for (int k = 0; k < n; k++) u[cubeta[k]] += signo[k] * (unsigned int)A[i][k];
+    }
+    // Cada hilo suma las filas de B que caen en sus cubetas
+    #pragma omp parallel for schedule(static)
+    for (int t = 0; t < s; t++) {
+        unsigned int *v = V + (size_t)t * n;
+        for (int k = 0; k < n; k++) {
+            if (cubeta[k] != t) continue;
+            for (int j = 0; j < n; j++) v[j] += signo[k] * (unsigned int)B[k][j];
+        }
+    }
+    aprox_producto_rango(U, V, C, n, s);
+
+    free(cubeta);
+    free(signo);
+    free(U);
+    free(V);
+    return s;
+}
+
+static inline int multiplicar_aproximada(metodo_aproximado_t metodo, int **A, int **B, int **C, int n, double error,
+                                         unsigned int semilla) {
+    if (metodo == APROX_MUESTREO) return multiplicar_aprox_muestreo(A, B, C, n, error, semilla);
+    return multiplicar_aprox_countsketch(A, B, C, n, error, semilla);
+}
+
+// ||C_exacta - C||_F / ||C_exacta||_F
+static inline double error_frobenius_relativo(int **C_exacta, int **C, int n) {
+    double diferencia = 0.0, referencia = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:diferencia, referencia)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double d = (double)C_exacta[i][j] - C[i][j];
+            diferencia += d * d;
+            referencia += (double)C_exacta[i][j] * C_exacta[i][j];
+        }
+    }
+    return referencia > 0.0 ? sqrt(diferencia / referencia) : sqrt(diferencia);
+}
+
+#endif
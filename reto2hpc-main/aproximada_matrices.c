@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "aproximada.h"
+
+//aproximada_matrices.c
+// Producto aproximado con presupuesto de error (aproximada.h): muestreo
+// columna-fila y CountSketch frente al producto exacto. En n pequeño
+// (n <= N_ORIGINAL) el error se mide contra multiplicar_matrices_original
+// de multiplicacion_matrices.c; en n grande, contra el kernel por bloques.
+// El speedup se da frente al kernel por bloques y frente al producto de
+// rango n con el mismo kernel que usan las aproximaciones (eps = 0), que
+// separa lo que aporta reducir el rango de lo que aporta el kernel.
+
+#define N_ORIGINAL 512
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Función para crear una matriz cuadrada dinámicamente
+int **crear_matriz(int n) {
+    int **matriz = (int **)malloc(n * sizeof(int *));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        matriz[i] = (int *)malloc(n * sizeof(int));
+        if (matriz[i] == NULL) {
+            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(1);
+        }
+    }
+
+    return matriz;
+}
+
+// Función para liberar memoria de una matriz
+void liberar_matriz(int **matriz, int n) {
+    for (int i = 0; i < n; i++) {
+        free(matriz[i]);
+    }
+    free(matriz);
+}
+
+// Generación paralela con semilla por fila
+void generar_matriz_aleatoria_paralela(int **matriz, int n, unsigned int base) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int seed = base + i * 7919;
+        for (int j = 0; j < n; j++) {
+            matriz[i][j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// Función original de multiplicación (de multiplicacion_matrices.c)
+void multiplicar_matrices_original(int **A, int **B, int **C, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            C[i][j] = 0;
+            for (int k = 0; k < n; k++) {
+                C[i][j] += A[i][k] * B[k][j];
+            }
+        }
+    }
+}
+
+// El kernel por bloques de multiplicacion_openmp.c
+void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[i][k] * B[k][j];
+                        }
+                        C[i][j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Mide los dos métodos para un tamaño; devuelve 0 si alguno se pasa del
+// presupuesto
+int comparar_aproximaciones(int n, double error) {
+    int **A = crear_matriz(n);
+    int **B = crear_matriz(n);
+    int **C = crear_matriz(n);
+    int **C_exacta = crear_matriz(n);
+    generar_matriz_aleatoria_paralela(A, n, (unsigned int)time(NULL));
+    generar_matriz_aleatoria_paralela(B, n, (unsigned int)time(NULL) + 1);
+
+    double inicio = get_time_microseconds();
+    multiplicar_matrices_openmp_optimizada(A, B, C_exacta, n);
+    double tiempo_bloques = (get_time_microseconds() - inicio) / 1e6;
+
+    inicio = get_time_microseconds();
+    multiplicar_aprox_countsketch(A, B, C, n, 0.0, 0);
+    double tiempo_rango_n = (get_time_microseconds() - inicio) / 1e6;
+
+    printf("%6d %-18s %7d %12.6f %9.2fx %9.2fx %14s %8s\n", n, "exacto (bloques)", n, tiempo_bloques, 1.0,
+           tiempo_rango_n / tiempo_bloques, "-", "-");
+    printf("%6d %-18s %7d %12.6f %9.2fx %9.2fx %14.6f %8s\n", n, "exacto (rango n)", n, tiempo_rango_n,
+           tiempo_bloques / tiempo_rango_n, 1.0, error_frobenius_relativo(C_exacta, C, n), "-");
+
+    if (n <= N_ORIGINAL) {
+        inicio = get_time_microseconds();
+        multiplicar_matrices_original(A, B, C_exacta, n);
+        double tiempo_original = (get_time_microseconds() - inicio) / 1e6;
+        printf("%6d %-18s %7d %12.6f %9.2fx %9.2fx %14s %8s\n", n, "exacto (original)", n, tiempo_original,
+               tiempo_bloques / tiempo_original, tiempo_rango_n / tiempo_original, "-", "-");
+    }
+
+    int cumple_todos = 1;
+    for (int m = 0; m < APROX_NUM_METODOS; m++) {
+        inicio = get_time_microseconds();
+        int rango = multiplicar_aproximada((metodo_aproximado_t)m, A, B, C, n, error, 12345u + n);
+        double tiempo = (get_time_microseconds() - inicio) / 1e6;
+        double obtenido = error_frobenius_relativo(C_exacta, C, n);
+        int cumple = obtenido <= error;
+        cumple_todos &= cumple;
+        printf("%6d %-18s %7d %12.6f %9.2fx %9.2fx %14.6f %8s\n", n,
+               nombre_metodo_aproximado((metodo_aproximado_t)m), rango, tiempo, tiempo_bloques / tiempo,
+               tiempo_rango_n / tiempo, obtenido, cumple ? "sí" : "NO");
+    }
+
+    liberar_matriz(A, n);
+    liberar_matriz(B, n);
+    liberar_matriz(C, n);
+    liberar_matriz(C_exacta, n);
+    return cumple_todos;
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    double error = 0.05;
+    int barrido = 0;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (strncmp(argv[a], "--error=", 8) == 0 && atof(argv[a] + 8) > 0.0) {
+            error = atof(argv[a] + 8);
+        } else if (strcmp(argv[a], "--barrido") == 0) {
+            barrido = 1;
+        } else {
+            opciones_validas = 0;
+        }
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [--error=relativo] [--barrido]\n", argv[0]);
+        printf("  --error: presupuesto de error relativo de Frobenius (por defecto 0.05)\n");
+        printf("  --barrido: n = 128, 256, ... hasta tamaño_matriz\n");
+        printf("Ejemplo: %s 4096 4 --error=0.01 --barrido\n", argv[0]);
+        return 1;
+    }
+
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    if (n <= 0 || num_hilos <= 0) {
+        printf("Error: El tamaño de matriz y número de hilos deben ser positivos\n");
+        return 1;
+    }
+    omp_set_num_threads(num_hilos);
+
+    printf("=== MULTIPLICACIÓN APROXIMADA: MUESTREO Y COUNTSKETCH ===\n");
+    printf("Número de hilos: %d\n", num_hilos);
+    printf("Presupuesto de error relativo (Frobenius): %g\n", error);
+    printf("Error medido contra multiplicar_matrices_original con n <= %d y contra el kernel por bloques\n", N_ORIGINAL);
+    printf("con n mayor. Speedup frente al kernel por bloques y frente al mismo kernel de las\n");
+    printf("aproximaciones con rango n (producto exacto)\n\n");
+    printf("%6s %-18s %7s %12s %10s %10s %14s %8s\n", "n", "Método", "Rango", "Tiempo (s)", "vs bloques",
+           "vs rango n", "Error relativo", "Cumple");
+
+    int cumple = 1;
+    if (barrido) {
+        for (int m = 128; m <= n; m *= 2) {
+            cumple &= comparar_aproximaciones(m, error);
+        }
+    } else {
+        cumple = comparar_aproximaciones(n, error);
+    }
+
+    printf("\nPresupuesto de error: %s\n", cumple ? "cumplido" : "EXCEDIDO (las cotas son en esperanza)");
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return 0;
+}
@@ -0,0 +1,328 @@
+#ifndef ARENA_MATRICES_H
+#define ARENA_MATRICES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+// Arena de matrices: una sola reserva de memoria (alineada a 2 MB y
+// respaldada por páginas grandes cuando el sistema lo permite) de la que se
+// sacan matrices contiguas. Cada matriz conserva la interfaz int** de
+// crear_matriz, pero sus punteros de fila y sus datos viven en un solo bloque,
+// sin los n+1 malloc. Los bloques liberados se reutilizan (primero para
+// matrices del mismo tamaño), y la reserva se prefaulta en paralelo al crear
+// la arena.
+
+#define ARENA_PAGINA_GRANDE (2UL * 1024 * 1024)
+#define ARENA_MAX_BLOQUES 128
+
+typedef enum {
+    ARENA_PAGINAS_NORMALES, // páginas de 4 kB
+    ARENA_PAGINAS_THP,      // transparent huge pages (madvise)
+    ARENA_PAGINAS_HUGETLB   // páginas grandes explícitas (MAP_HUGETLB)
+} tipo_paginas_arena_t;
+
+typedef struct {
+    char *inicio;
+    size_t bytes;
+    int filas;
+    int columnas;
+    int en_uso;
+} BloqueArena;
+
+typedef struct {
+    char *base;
+    size_t capacidad;
+    size_t usado;
+    tipo_paginas_arena_t paginas;
+    BloqueArena bloques[ARENA_MAX_BLOQUES];
+    int num_bloques;
+    int reutilizados;
+    double tiempo_prefault; // microsegundos
+    long fallos_prefault;   // fallos de página menores del prefault
+} ArenaMatrices;
+
+static inline const char *nombre_paginas_arena(tipo_paginas_arena_t paginas) {
+    switch (paginas) {
+        case ARENA_PAGINAS_THP:     return "THP (2 MB, madvise)";
+        case ARENA_PAGINAS_HUGETLB: return "hugetlb (2 MB explícitas)";
+        default:                    return "normales (4 kB)";
+    }
+}
+
+// Acepta "--arena" (THP), "--arena=thp", "--arena=hugetlb" y "--arena=normal".
+// Devuelve 0 si el argumento es una opción de arena válida
+static inline int parse_opcion_arena(const char *texto, tipo_paginas_arena_t *paginas) {
+    if (strcmp(texto, "--arena") == 0 || strcmp(texto, "--arena=thp") == 0) {
+        *paginas = ARENA_PAGINAS_THP;
+    } else if (strcmp(texto, "--arena=hugetlb") == 0) {
+        *paginas = ARENA_PAGINAS_HUGETLB;
+    } else if (strcmp(texto, "--arena=normal") == 0) {
+        *paginas = ARENA_PAGINAS_NORMALES;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Fallos de página menores del proceso (minflt de getrusage)
+static inline long arena_fallos_de_pagina(void) {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_minflt;
+}
+
+static inline double arena_tiempo_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static inline size_t arena_redondear(size_t bytes, size_t alineacion) {
+    return (bytes + alineacion - 1) / alineacion * alineacion;
+}
+
+// Bytes que ocupa en la arena una matriz filas x columnas: punteros de fila,
+// datos alineados a 64 B, y el total redondeado a una página grande
+static inline size_t arena_tam_matriz_rect(int filas, int columnas) {
+    size_t punteros = arena_redondear(filas * sizeof(int *), 64);
+    return arena_redondear(punteros + (size_t)filas * columnas * sizeof(int), ARENA_PAGINA_GRANDE);
+}
+
+static inline size_t arena_tam_matriz(int n) {
+    return arena_tam_matriz_rect(n, n);
+}
+
+typedef struct {
+    char *inicio;
+    size_t bytes;
+} TramoPrefault;
+
+static inline void *arena_prefault_tramo(void *arg) {
+    TramoPrefault *tramo = (TramoPrefault *)arg;
+    long pagina = sysconf(_SC_PAGESIZE);
+    // Escribir un byte por página basta para que el kernel la asigne
+    for (size_t b = 0; b < tramo->bytes; b += pagina) {
+        tramo->inicio[b] = 0;
+    }
+    return NULL;
+}
+
+// Toca toda la reserva con num_hilos hilos, cada uno en un tramo contiguo
+// alineado a página grande
+static inline void arena_prefault(char *inicio, size_t bytes, int num_hilos) {
+    if (num_hilos < 1) num_hilos = 1;
+    size_t paginas_grandes = bytes / ARENA_PAGINA_GRANDE;
+    if ((size_t)num_hilos > paginas_grandes) num_hilos = paginas_grandes > 0 ? (int)paginas_grandes : 1;
+
+    pthread_t *hilos = (pthread_t *)malloc(num_hilos * sizeof(pthread_t));
+    TramoPrefault *tramos = (TramoPrefault *)malloc(num_hilos * sizeof(TramoPrefault));
+    size_t desplazamiento = 0;
+    for (int h = 0; h < num_hilos; h++) {
+        size_t paginas = paginas_grandes / num_hilos + ((size_t)h < paginas_grandes % num_hilos ? 1 : 0);
+        tramos[h].inicio = inicio + desplazamiento;
+        tramos[h].bytes = (h == num_hilos - 1) ? bytes - desplazamiento : paginas * ARENA_PAGINA_GRANDE;
+        desplazamiento += tramos[h].bytes;
+        pthread_create(&hilos[h], NULL, arena_prefault_tramo, &tramos[h]);
+    }
+    for (int h = 0; h < num_hilos; h++) {
+        pthread_join(hilos[h], NULL);
+    }
+    free(hilos);
+    free(tramos);
+}
+
+// Reserva capacidad bytes (redondeados a 2 MB). Si no hay páginas hugetlb
+// disponibles se usa THP en su lugar
+static inline void arena_crear(ArenaMatrices *arena, size_t capacidad, tipo_paginas_arena_t paginas,
+                               int hilos_prefault) {
+    memset(arena, 0, sizeof(*arena));
+    capacidad = arena_redondear(capacidad, ARENA_PAGINA_GRANDE);
+    void *base = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (paginas == ARENA_PAGINAS_HUGETLB) {
+        base = mmap(NULL, capacidad, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base == MAP_FAILED) {
+            printf("Aviso: No hay páginas hugetlb disponibles (ver /proc/sys/vm/nr_hugepages), se usa THP\n");
+            paginas = ARENA_PAGINAS_THP;
+        }
+    }
+#else
+    if (paginas == ARENA_PAGINAS_HUGETLB) paginas = ARENA_PAGINAS_THP;
+#endif
+
+    if (base == MAP_FAILED) {
+        // Reservar 2 MB de más para poder alinear la base a página grande
+        size_t reserva = capacidad + ARENA_PAGINA_GRANDE;
+        char *bruto = (char *)mmap(NULL, reserva, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (bruto == MAP_FAILED) {
+            printf("Error: No se pudo reservar la arena de %zu bytes\n", capacidad);
+            exit(1);
+        }
+        char *alineado = (char *)arena_redondear((uintptr_t)bruto, ARENA_PAGINA_GRANDE);
+        if (alineado > bruto) munmap(bruto, alineado - bruto);
+        size_t sobrante = (bruto + reserva) - (alineado + capacidad);
+        if (sobrante > 0) munmap(alineado + capacidad, sobrante);
+        base = alineado;
+#ifdef MADV_HUGEPAGE
+        if (paginas == ARENA_PAGINAS_THP) {
+            madvise(base, capacidad, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    arena->base = (char *)base;
+    arena->capacidad = capacidad;
+    arena->paginas = paginas;
+
+    double inicio = arena_tiempo_us();
+    long fallos = arena_fallos_de_pagina();
+    arena_prefault(arena->base, capacidad, hilos_prefault);
+    arena->tiempo_prefault = arena_tiempo_us() - inicio;
+    arena->fallos_prefault = arena_fallos_de_pagina() - fallos;
+}
+
+// Matriz filas x columnas con la misma interfaz que crear_matriz: reutiliza
+// un bloque libre de las mismas dimensiones si lo hay, si no el bloque libre
+// más chico en el que quepa, y si no lo toma del final de la arena. Devuelve
+// NULL si no hay espacio
+static inline int **arena_intentar_crear_matriz_rect(ArenaMatrices *arena, int filas, int columnas) {
+    size_t bytes = arena_tam_matriz_rect(filas, columnas);
+    BloqueArena *bloque = NULL;
+    for (int b = 0; b < arena->num_bloques; b++) {
+        BloqueArena *candidato = &arena->bloques[b];
+        if (candidato->en_uso || candidato->bytes < bytes) continue;
+        if (candidato->filas == filas && candidato->columnas == columnas) {
+            bloque = candidato;
+            break;
+        }
+        if (bloque == NULL || candidato->bytes < bloque->bytes) bloque = candidato;
+    }
+
+    if (bloque != NULL) {
+        arena->reutilizados++;
+        bloque->filas = filas;
+        bloque->columnas = columnas;
+    } else {
+        if (arena->num_bloques == ARENA_MAX_BLOQUES || arena->usado + bytes > arena->capacidad) {
+            return NULL;
+        }
+        bloque = &arena->bloques[arena->num_bloques++];
+        bloque->inicio = arena->base + arena->usado;
+        bloque->bytes = bytes;
+        bloque->filas = filas;
+        bloque->columnas = columnas;
+        arena->usado += bytes;
+    }
+    bloque->en_uso = 1;
+
+    int **matriz = (int **)bloque->inicio;
+    int *datos = (int *)(bloque->inicio + arena_redondear(filas * sizeof(int *), 64));
+    for (int i = 0; i < filas; i++) {
+        matriz[i] = datos + (size_t)i * columnas;
+    }
+    return matriz;
+}
+
+static inline int **arena_crear_matriz_rect(ArenaMatrices *arena, int filas, int columnas) {
+    int **matriz = arena_intentar_crear_matriz_rect(arena, filas, columnas);
+    if (matriz == NULL) {
+        printf("Error: La arena no tiene espacio para una matriz de %dx%d\n", filas, columnas);
+        exit(1);
+    }
+    return matriz;
+}
+
+static inline int **arena_crear_matriz(ArenaMatrices *arena, int n) {
+    return arena_crear_matriz_rect(arena, n, n);
+}
+
+// Devuelve el bloque a la arena para que lo reutilice otra matriz del mismo
+// tamaño; la memoria sigue mapeada y con sus páginas ya asignadas
+static inline void arena_liberar_matriz(ArenaMatrices *arena, int **matriz) {
+    for (int b = 0; b < arena->num_bloques; b++) {
+        if (arena->bloques[b].inicio == (char *)matriz) {
+            arena->bloques[b].en_uso = 0;
+            return;
+        }
+    }
+    printf("Error: La matriz no pertenece a la arena\n");
+    exit(1);
+}
+
+static inline int arena_contiene(const ArenaMatrices *arena, const void *puntero) {
+    return (const char *)puntero >= arena->base && (const char *)puntero < arena->base + arena->capacidad;
+}
+
+static inline void arena_destruir(ArenaMatrices *arena) {
+    munmap(arena->base, arena->capacidad);
+    arena->base = NULL;
+    arena->capacidad = 0;
+}
+
+// Mide, para num_llamadas ciclos de crear A, B y C, escribirlas y liberarlas,
+// el camino de crear_matriz (n+1 malloc por matriz) frente a la arena, en
+// tiempo y en fallos de página menores. Los fallos del prefault pasan fuera
+// del bucle medido, pero se cuentan del lado de la arena: sin ellos la arena
+// parecería no fallar nunca
+static inline void arena_comparar_con_malloc(ArenaMatrices *arena, int n, int num_llamadas) {
+    double inicio = arena_tiempo_us();
+    long fallos = arena_fallos_de_pagina();
+    for (int llamada = 0; llamada < num_llamadas; llamada++) {
+        int **matrices[3];
+        for (int m = 0; m < 3; m++) {
+            matrices[m] = (int **)malloc(n * sizeof(int *));
+            for (int i = 0; i < n; i++) {
+                matrices[m][i] = (int *)malloc(n * sizeof(int));
+                memset(matrices[m][i], 0, n * sizeof(int));
+            }
+        }
+        for (int m = 0; m < 3; m++) {
+            for (int i = 0; i < n; i++) free(matrices[m][i]);
+            free(matrices[m]);
+        }
+    }
+    double tiempo_malloc = arena_tiempo_us() - inicio;
+    long fallos_malloc = arena_fallos_de_pagina() - fallos;
+
+    inicio = arena_tiempo_us();
+    fallos = arena_fallos_de_pagina();
+    for (int llamada = 0; llamada < num_llamadas; llamada++) {
+        int **matrices[3];
+        for (int m = 0; m < 3; m++) {
+            matrices[m] = arena_crear_matriz(arena, n);
+            memset(matrices[m][0], 0, (size_t)n * n * sizeof(int));
+        }
+        for (int m = 0; m < 3; m++) {
+            arena_liberar_matriz(arena, matrices[m]);
+        }
+    }
+    double tiempo_arena = arena_tiempo_us() - inicio;
+    long fallos_arena = arena_fallos_de_pagina() - fallos;
+
+    printf("=== ASIGNACIÓN DE MEMORIA (%d llamadas de 3 matrices %dx%d) ===\n", num_llamadas, n, n);
+    printf("Páginas de la arena: %s\n", nombre_paginas_arena(arena->paginas));
+    printf("Prefault paralelo de la arena (preparación): %.2f microsegundos, %ld fallos de página\n",
+           arena->tiempo_prefault, arena->fallos_prefault);
+    printf("crear_matriz (malloc por fila): %.2f microsegundos, %ld fallos de página\n",
+           tiempo_malloc, fallos_malloc);
+    printf("Arena: %.2f microsegundos, %ld fallos de página (%ld con el prefault)\n",
+           tiempo_arena, fallos_arena, fallos_arena + arena->fallos_prefault);
+    printf("Tiempo de asignación ahorrado, sin la preparación: %.2f microsegundos (%.1f%%)\n",
+           tiempo_malloc - tiempo_arena,
+           tiempo_malloc > 0.0 ? (tiempo_malloc - tiempo_arena) / tiempo_malloc * 100 : 0.0);
+    printf("Fallos de página evitados, contando el prefault: %ld\n",
+           fallos_malloc - (fallos_arena + arena->fallos_prefault));
+    printf("Bloques reutilizados: %d\n\n", arena->reutilizados);
+}
+
+#endif
@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "ejecutor_asincrono.h"
+
+//asincrona_matrices.c
+// Mide la API asíncrona de ejecutor_asincrono.h con una carga intercalada:
+// cada producto necesita antes una preparación en el hilo que llama
+// (generar A y B y una espera que simula leerlas de disco o de red).
+//   - bloqueante: preparar, multiplicar con OpenMP, preparar el siguiente...
+//   - asíncrona esperando: la misma secuencia con asinc_enviar + asinc_esperar
+//   - asíncrona intercalada: se prepara el producto i + 1 mientras el pool
+//     calcula el i; la cola acotada frena al que llama si se adelanta
+// Además muestra el efecto de la prioridad en la latencia de un producto
+// urgente y la cancelación de productos en cola.
+
+#define CAPACIDAD_COLA 4
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Función para crear una matriz cuadrada dinámicamente
+int **crear_matriz(int n) {
+    int **matriz = (int **)malloc(n * sizeof(int *));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        matriz[i] = (int *)malloc(n * sizeof(int));
+        if (matriz[i] == NULL) {
+            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(1);
+        }
+    }
+
+    return matriz;
+}
+
+// Función para liberar memoria de una matriz
+void liberar_matriz(int **matriz, int n) {
+    for (int i = 0; i < n; i++) {
+        free(matriz[i]);
+    }
+    free(matriz);
+}
+
+// El kernel bloqueante de multiplicacion_openmp.c
+void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[i][k] * B[k][j];
+                        }
+                        C[i][j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Operandos y resultado de un producto de la carga
+typedef struct {
+    int **A;
+    int **B;
+    int **C;
+} Producto;
+
+// Preparación en el hilo que llama: A y B con semilla por producto (las tres
+// estrategias calculan los mismos productos) y la espera simulada de E/S
+void preparar_producto(Producto *p, int n, int indice, int espera_us) {
+    unsigned int semilla = 12345u + indice * 7919u;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            p->A[i][j] = rand_r(&semilla) % 100;
+            p->B[i][j] = rand_r(&semilla) % 100;
+        }
+    }
+    if (espera_us > 0) usleep(espera_us);
+}
+
+uint64_t suma_verificacion(int **C, int n) {
+    uint64_t suma = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            suma = suma * 31 + (uint32_t)C[i][j];
+        }
+    }
+    return suma;
+}
+
+void imprimir_fila(const char *estrategia, double segundos, int trabajos, double referencia) {
+    printf("%-24s %12.6f %14.2f %10.2fx\n", estrategia, segundos, trabajos / segundos, referencia / segundos);
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    int trabajos = 16;
+    int espera_us = 2000;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (strncmp(argv[a], "--espera=", 9) == 0 && atoi(argv[a] + 9) >= 0) {
+            espera_us = atoi(argv[a] + 9);
+        } else if (a == 3 && argv[a][0] != '-' && atoi(argv[a]) > 0) {
+            trabajos = atoi(argv[a]);
+        } else {
+            opciones_validas = 0;
+        }
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [trabajos] [--espera=microsegundos]\n", argv[0]);
+        printf("Ejemplo: %s 512 4 16 --espera=2000\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    if (n <= 0 || num_hilos <= 0) {
+        printf("Error: El tamaño de matriz y número de hilos deben ser positivos\n");
+        return 1;
+    }
+    omp_set_num_threads(num_hilos);
+
+    printf("=== API ASÍNCRONA DE MULTIPLICACIÓN ===\n");
+    printf("Tamaño de matriz: %dx%d\n", n, n);
+    printf("Hilos del pool (y de OpenMP): %d\n", num_hilos);
+    printf("Productos: %d, preparación con espera de E/S simulada de %d microsegundos\n", trabajos, espera_us);
+    printf("Capacidad de la cola: %d productos\n\n", CAPACIDAD_COLA);
+
+    Producto *productos = (Producto *)malloc(trabajos * sizeof(Producto));
+    uint64_t *referencia = (uint64_t *)malloc(trabajos * sizeof(uint64_t));
+    for (int t = 0; t < trabajos; t++) {
+        productos[t].A = crear_matriz(n);
+        productos[t].B = crear_matriz(n);
+        productos[t].C = crear_matriz(n);
+    }
+
+    EjecutorAsincrono ejecutor;
+    asinc_crear(&ejecutor, num_hilos, CAPACIDAD_COLA);
+    int correcto = 1;
+
+    // --- Carga intercalada ---
+    printf("--- CARGA INTERCALADA ---\n");
+    printf("%-24s %12s %14s %11s\n", "Estrategia", "Tiempo (s)", "Productos/s", "vs bloq.");
+
+    double inicio = get_time_microseconds();
+    for (int t = 0; t < trabajos; t++) {
+        preparar_producto(&productos[t], n, t, espera_us);
+        multiplicar_matrices_openmp_optimizada(productos[t].A, productos[t].B, productos[t].C, n);
+    }
+    double tiempo_bloqueante = (get_time_microseconds() - inicio) / 1e6;
+    for (int t = 0; t < trabajos; t++) referencia[t] = suma_verificacion(productos[t].C, n);
+    imprimir_fila("bloqueante (OpenMP)", tiempo_bloqueante, trabajos, tiempo_bloqueante);
+
+    inicio = get_time_microseconds();
+    for (int t = 0; t < trabajos; t++) {
+        preparar_producto(&productos[t], n, t, espera_us);
+        FuturoProducto *f = asinc_enviar(&ejecutor, productos[t].A, productos[t].B, productos[t].C, n, 0);
+        asinc_esperar(f);
+        asinc_liberar(f);
+    }
+    double tiempo_esperando = (get_time_microseconds() - inicio) / 1e6;
+    for (int t = 0; t < trabajos; t++) correcto &= suma_verificacion(productos[t].C, n) == referencia[t];
+    imprimir_fila("asíncrona esperando", tiempo_esperando, trabajos, tiempo_bloqueante);
+
+    FuturoProducto **futuros = (FuturoProducto **)malloc(trabajos * sizeof(FuturoProducto *));
+    inicio = get_time_microseconds();
+    for (int t = 0; t < trabajos; t++) {
+        preparar_producto(&productos[t], n, t, espera_us);
+        futuros[t] = asinc_enviar(&ejecutor, productos[t].A, productos[t].B, productos[t].C, n, 0);
+    }
+    for (int t = 0; t < trabajos; t++) {
+        asinc_esperar(futuros[t]);
+        asinc_liberar(futuros[t]);
+    }
+    double tiempo_intercalado = (get_time_microseconds() - inicio) / 1e6;
+    for (int t = 0; t < trabajos; t++) correcto &= suma_verificacion(productos[t].C, n) == referencia[t];
+    imprimir_fila("asíncrona intercalada", tiempo_intercalado, trabajos, tiempo_bloqueante);
+    printf("Ganancia de intercalar frente a esperar cada producto: %.2fx\n\n", tiempo_esperando / tiempo_intercalado);
+
+    // --- Prioridad ---
+    // Con la cola llena de productos normales, un producto urgente enviado al
+    // final espera a todos (misma prioridad) o sólo a las bandas en curso
+    printf("--- PRIORIDAD ---\n");
+    int normales = trabajos - 1 < CAPACIDAD_COLA - 1 ? trabajos - 1 : CAPACIDAD_COLA - 1;
+    for (int prioridad = 0; prioridad <= 1; prioridad++) {
+        for (int t = 0; t < normales; t++) {
+            futuros[t] = asinc_enviar(&ejecutor, productos[t].A, productos[t].B, productos[t].C, n, 0);
+        }
+        Producto *urgente = &productos[normales];
+        FuturoProducto *f = asinc_enviar(&ejecutor, urgente->A, urgente->B, urgente->C, n, prioridad);
+        asinc_esperar(f);
+        printf("Latencia del producto urgente con prioridad %d (%d normales en cola): %.6f segundos\n",
+               prioridad, normales, f->fin - f->envio);
+        asinc_liberar(f);
+        for (int t = 0; t < normales; t++) {
+            asinc_esperar(futuros[t]);
+            asinc_liberar(futuros[t]);
+        }
+    }
+    printf("\n");
+
+    // --- Cancelación ---
+    printf("--- CANCELACIÓN ---\n");
+    int por_lote = CAPACIDAD_COLA;
+    int completados = 0, cancelados = 0, tardios = 0, completados_correctos = 0;
+    for (int base = 0; base < trabajos; base += por_lote) {
+        int fin = base + por_lote < trabajos ? base + por_lote : trabajos;
+        for (int t = base; t < fin; t++) {
+            futuros[t] = asinc_enviar(&ejecutor, productos[t].A, productos[t].B, productos[t].C, n, 0);
+        }
+        for (int t = base + 1; t < fin; t += 2) {
+            if (!asinc_cancelar(futuros[t])) tardios++; // todas sus bandas ya repartidas
+        }
+        for (int t = base; t < fin; t++) {
+            if (asinc_esperar(futuros[t]) == ASINC_COMPLETADO) {
+                completados++;
+                completados_correctos += suma_verificacion(productos[t].C, n) == referencia[t];
+            } else {
+                cancelados++;
+            }
+            asinc_liberar(futuros[t]);
+        }
+    }
+    correcto &= completados_correctos == completados;
+    printf("Enviados: %d, cancelados: %d, completados: %d (%d correctos)\n",
+           trabajos, cancelados, completados, completados_correctos);
+    printf("Cancelaciones tardías (se completaron igual): %d\n\n", tardios);
+
+    asinc_destruir(&ejecutor);
+    for (int t = 0; t < trabajos; t++) {
+        liberar_matriz(productos[t].A, n);
+        liberar_matriz(productos[t].B, n);
+        liberar_matriz(productos[t].C, n);
+    }
+    free(productos);
+    free(referencia);
+    free(futuros);
+
+    printf("Verificación contra la versión bloqueante: %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return correcto ? 0 : 1;
+}
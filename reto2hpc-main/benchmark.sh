@@ -31,9 +31,31 @@ show_system_info() {
     echo "Memoria total: $(free -h | grep 'Mem:' | awk '{print $2}')" | tee -a "$RESULTS_FILE"
     echo "Memoria disponible: $(free -h | grep 'Mem:' | awk '{print $7}')" | tee -a "$RESULTS_FILE"
     echo "Versión GCC: $(gcc --version | head -n1)" | tee -a "$RESULTS_FILE"
+    echo "Energía RAPL: $(rapl_status)" | tee -a "$RESULTS_FILE"
     echo "" | tee -a "$RESULTS_FILE"
 }
 
+# Dominios RAPL legibles en powercap (los programas usan energia.h)
+rapl_status() {
+    local domains=""
+    for domain in /sys/class/powercap/intel-rapl:*; do
+        [ -r "$domain/energy_uj" ] || continue
+        domains="$domains $(cat "$domain/name")"
+    done
+    if [ -n "$domains" ]; then
+        echo "disponible ($(echo $domains))"
+    elif ls -d /sys/class/powercap/intel-rapl:* > /dev/null 2>&1; then
+        echo "sin permiso de lectura en energy_uj (ejecutar como root)"
+    else
+        echo "no disponible"
+    fi
+}
+
+# Extrae "julios vatios GOP/J" de una línea "Energía ...: X J (...), potencia media X W, X GOP/J"
+parse_energy() {
+    sed -n 's/^Energía .*: \([0-9.]*\) J (.*potencia media \([0-9.]*\) W, \([0-9.]*\) GOP\/J$/\1 \2 \3/p'
+}
+
 # Función para verificar que los ejecutables existen
 check_executables() {
     local missing=0
@@ -87,10 +109,18 @@ run_test() {
         # Extraer tiempo de ejecución
         local time_result=$(grep "Tiempo de multiplicación" "$temp_file" | tail -1 | awk '{print $4}')
         local memory_result=$(grep "Memoria final" "$temp_file" | tail -1 | awk '{print $3, $4}')
+        # Energía del último kernel medido (el optimizado)
+        local energy_result=$(grep "^Energía" "$temp_file" | tail -1 | parse_energy)
         
         echo -e "${GREEN}✓ $test_name completado${NC}"
         echo "Tiempo: $time_result segundos" | tee -a "$RESULTS_FILE"
         echo "Memoria: $memory_result" | tee -a "$RESULTS_FILE"
+        if [ -n "$energy_result" ]; then
+            read joules watts gop_per_joule <<< "$energy_result"
+            echo "Energía: $joules J, potencia media: $watts W, eficiencia: $gop_per_joule GOP/J" | tee -a "$RESULTS_FILE"
+        else
+            echo "Energía: no disponible" | tee -a "$RESULTS_FILE"
+        fi
         
         # Extraer speedup si está disponible
         local speedup=$(grep "Speedup:" "$temp_file" | tail -1 | awk '{print $2}')
@@ -182,37 +212,85 @@ run_quick_benchmark() {
     echo "Resultados en: $quick_file"
 }
 
-# Función para benchmark de escalabilidad
+# Función para benchmark de escalabilidad: fuerte y débil con ajuste de
+# Amdahl/Gustafson (scalability_test.sh; HILOS, REPETICIONES y
+# UMBRAL_EFICIENCIA se pasan por el entorno)
 run_scalability_benchmark() {
     echo -e "${BLUE}=== BENCHMARK DE ESCALABILIDAD ===${NC}"
-    local scalability_file="$RESULTS_DIR/scalability_$TIMESTAMP.txt"
+    ./scalability_test.sh todo 1000
+}
+
+# Función para benchmark de modos de acumulación
+run_accumulator_benchmark() {
+    echo -e "${BLUE}=== BENCHMARK DE MODOS DE ACUMULACIÓN ===${NC}"
+    local accumulator_file="$RESULTS_DIR/acumuladores_$TIMESTAMP.txt"
     
     mkdir -p "$RESULTS_DIR"
-    show_system_info > "$scalability_file"
+    show_system_info > "$accumulator_file"
     
-    local max_threads=$(nproc)
     local test_size=1000
+    local threads=$(nproc)
     
-    echo -e "${BLUE}=== ESCALABILIDAD (${test_size}x${test_size}) ===${NC}" | tee -a "$scalability_file"
-    
-    # Probar con diferentes números de hilos
-    for threads in 1 2 4 8 16; do
-        if [ "$threads" -le "$max_threads" ] && [ "$threads" -le "$test_size" ]; then
-            echo -e "${YELLOW}Probando con $threads hilos/procesos${NC}"
-            
-            echo "--- OpenMP con $threads hilos ---" | tee -a "$scalability_file"
-            run_test "$BUILD_DIR/matrices_openmp" "$test_size" "$threads" "OpenMP" "$scalability_file"
-            
-            echo "--- Pthread con $threads hilos ---" | tee -a "$scalability_file"
-            run_test "$BUILD_DIR/matrices_pthread" "$test_size" "$threads" "Pthread" "$scalability_file"
-            
-            echo "--- Procesos con $threads procesos ---" | tee -a "$scalability_file"
-            run_test "$BUILD_DIR/matrices_procesos" "$test_size" "$threads" "Procesos" "$scalability_file"
+    # Cada programa imprime la tabla de tiempo, GOPS y costo frente a int32
+    for executable in matrices_seq matrices_openmp matrices_pthread matrices_procesos; do
+        echo -e "${YELLOW}Probando $executable (${test_size}x${test_size})${NC}"
+        echo "--- $executable ---" | tee -a "$accumulator_file"
+        if [ "$executable" = "matrices_seq" ]; then
+            timeout 300s "$BUILD_DIR/$executable" "$test_size" --acumulador=todos > /tmp/benchmark_acumuladores 2>&1
+        else
+            timeout 300s "$BUILD_DIR/$executable" "$test_size" "$threads" --acumulador=todos > /tmp/benchmark_acumuladores 2>&1
         fi
+        sed -n '/MODOS DE ACUMULACIÓN/,/^periodico/p' /tmp/benchmark_acumuladores | tee -a "$accumulator_file"
+    done
+    
+    echo -e "${GREEN}Benchmark de modos de acumulación completado${NC}"
+    echo "Resultados en: $accumulator_file"
+}
+
+# Función para benchmark de energía: tabla de julios, vatios y GOP/J por
+# backend y número de hilos/procesos
+run_energy_benchmark() {
+    echo -e "${BLUE}=== BENCHMARK DE ENERGÍA (RAPL) ===${NC}"
+    local energy_file="$RESULTS_DIR/energia_$TIMESTAMP.txt"
+    
+    mkdir -p "$RESULTS_DIR"
+    show_system_info > "$energy_file"
+    
+    local test_size=1000
+    local max_threads=$(nproc)
+    
+    printf "%-12s %6s %6s %12s %12s %10s %10s\n" "Backend" "n" "Hilos" "Tiempo (s)" "Energía (J)" "Potencia" "GOP/J" | tee -a "$energy_file"
+    for backend in Secuencial OpenMP Pthread Procesos; do
+        local executable=""
+        local counts=("${THREAD_COUNTS[@]}")
+        case "$backend" in
+            Secuencial) executable="matrices_seq"; counts=(1) ;;
+            OpenMP) executable="matrices_openmp" ;;
+            Pthread) executable="matrices_pthread" ;;
+            Procesos) executable="matrices_procesos" ;;
+        esac
+        for threads in "${counts[@]}"; do
+            if [ "$threads" -gt "$max_threads" ] && [ "$threads" -gt 1 ]; then
+                continue
+            fi
+            if [ "$executable" = "matrices_seq" ]; then
+                timeout 300s "$BUILD_DIR/$executable" "$test_size" > /tmp/benchmark_energia 2>&1
+            else
+                timeout 300s "$BUILD_DIR/$executable" "$test_size" "$threads" > /tmp/benchmark_energia 2>&1
+            fi
+            local time_result=$(grep "Tiempo de multiplicación" /tmp/benchmark_energia | tail -1 | awk '{print $(NF-1)}')
+            local energy_result=$(grep "^Energía" /tmp/benchmark_energia | tail -1 | parse_energy)
+            if [ -n "$energy_result" ]; then
+                read joules watts gop_per_joule <<< "$energy_result"
+                printf "%-12s %6s %6s %12s %12s %8s W %10s\n" "$backend" "$test_size" "$threads" "$time_result" "$joules" "$watts" "$gop_per_joule" | tee -a "$energy_file"
+            else
+                printf "%-12s %6s %6s %12s %12s %10s %10s\n" "$backend" "$test_size" "$threads" "$time_result" "n/d" "n/d" "n/d" | tee -a "$energy_file"
+            fi
+        done
     done
     
-    echo -e "${GREEN}Benchmark de escalabilidad completado${NC}"
-    echo "Resultados en: $scalability_file"
+    echo -e "${GREEN}Benchmark de energía completado${NC}"
+    echo "Resultados en: $energy_file"
 }
 
 # Función para mostrar ayuda
@@ -222,13 +300,17 @@ show_help() {
     echo "Opciones:"
     echo "  full        - Ejecutar benchmark completo (por defecto)"
     echo "  quick       - Ejecutar benchmark rápido"
-    echo "  scalability - Ejecutar benchmark de escalabilidad"
+    echo "  scalability - Escalabilidad fuerte y débil con ajuste de Amdahl/Gustafson"
+    echo "  acumuladores - Costo de cada modo de acumulación (int32, saturado, int64, periódico)"
+    echo "  energia     - Julios, vatios y GOP/J por backend y número de hilos (RAPL)"
     echo "  help        - Mostrar esta ayuda"
     echo ""
     echo "Ejemplos:"
     echo "  $0 full"
     echo "  $0 quick"
     echo "  $0 scalability"
+    echo "  $0 acumuladores"
+    echo "  $0 energia"
 }
 
 # Función para limpiar archivos temporales
@@ -250,6 +332,12 @@ case "${1:-full}" in
     "scalability")
         run_scalability_benchmark
         ;;
+    "acumuladores")
+        run_accumulator_benchmark
+        ;;
+    "energia")
+        run_energy_benchmark
+        ;;
     "help"|"-h"|"--help")
         show_help
         ;;
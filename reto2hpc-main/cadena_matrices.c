@@ -0,0 +1,599 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+#include <chrono>
+#include "arena_matrices.h"
+#include "kernels_fijos.h"
+
+//cadena_matrices.c
+// Motor de cadenas de productos (A1·A2·...·Ak) y potencias (A^k) sobre el
+// kernel por bloques de OpenMP:
+//   - paréntesis óptimos por programación dinámica
+//   - potencias por cuadrados sucesivos
+//   - intermedios en una arena reutilizada (malloc si no queda espacio), con
+//     doble buffer en las potencias y en la referencia izquierda a derecha
+//   - caché de subproductos por hash del contenido, dimensiones y rango de
+//     los operandos
+//
+// Los productos se acumulan en aritmética sin signo (módulo 2^32), que es
+// asociativa también cuando hay desbordamiento: el resultado no depende de
+// los paréntesis y se puede verificar comparando hashes.
+
+#define MAX_MATRICES_CADENA 32
+#define MAX_ENTRADAS_CACHE 16
+
+typedef struct {
+    int **datos;
+    int filas;
+    int columnas;
+    uint64_t hash;
+    int entrada; // índice en la caché, o -1 si no está en ella
+    // Producto de los operandos base primero..primero+largo-1 (las
+    // repeticiones de una cadena comparten índices, como comparten contenido)
+    int primero;
+    int largo;
+} MatrizCadena;
+
+typedef struct {
+    MatrizCadena izq; // sólo la clave: hash, dimensiones y rango
+    MatrizCadena der;
+    MatrizCadena resultado;
+    unsigned long ultimo_uso;
+    int fijada; // operandos en uso por un producto en curso
+    int ocupada;
+} EntradaCache;
+
+typedef struct {
+    ArenaMatrices arena;
+    EntradaCache cache[MAX_ENTRADAS_CACHE];
+    unsigned long reloj;
+    int aciertos;
+    int fallos;
+    int productos;
+    int fuera_de_arena; // intermedios que no cupieron en la arena
+    long long multiplicaciones_escalares;
+} MotorCadena;
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// C (m x p) = A (m x q) * B (q x p), por bloques como
+// multiplicar_matrices_openmp_optimizada pero con matrices rectangulares
+void multiplicar_bloques_rect(int **A, int **B, int **C, int m, int q, int p) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    // Productos cuadrados pequeños de tamaño fijo: kernel especializado
+    kernel_fijo_t kernel_fijo = (m == q && q == p) ? buscar_kernel_fijo(m) : NULL;
+    if (kernel_fijo != NULL) {
+        kernel_fijo(A, B, C);
+        return;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < m; i++) {
+        memset(C[i], 0, p * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < m; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < p; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < q; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < m) ? ii + BLOCK_SIZE : m;
+                int j_end = (jj + BLOCK_SIZE < p) ? jj + BLOCK_SIZE : p;
+                int k_end = (kk + BLOCK_SIZE < q) ? kk + BLOCK_SIZE : q;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        unsigned int sum = (unsigned int)C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += (unsigned int)A[i][k] * (unsigned int)B[k][j];
+                        }
+                        C[i][j] = (int)sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// FNV-1a de 64 bits sobre dimensiones y contenido
+uint64_t hash_matriz(int **M, int filas, int columnas) {
+    uint64_t h = 1469598103934665603ULL;
+    h = (h ^ (uint64_t)filas) * 1099511628211ULL;
+    h = (h ^ (uint64_t)columnas) * 1099511628211ULL;
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            h = (h ^ (uint32_t)M[i][j]) * 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+// ---------------------------------------------------------------------------
+// Caché de subproductos
+// ---------------------------------------------------------------------------
+
+// El hash solo no basta: una colisión devolvería otro producto
+static int misma_clave(const MatrizCadena *a, const MatrizCadena *b) {
+    return a->hash == b->hash && a->filas == b->filas && a->columnas == b->columnas &&
+           a->primero == b->primero && a->largo == b->largo;
+}
+
+static int buscar_en_cache(MotorCadena *motor, const MatrizCadena *I, const MatrizCadena *D) {
+    for (int e = 0; e < MAX_ENTRADAS_CACHE; e++) {
+        EntradaCache *entrada = &motor->cache[e];
+        if (entrada->ocupada && misma_clave(&entrada->izq, I) && misma_clave(&entrada->der, D)) {
+            entrada->ultimo_uso = ++motor->reloj;
+            return e;
+        }
+    }
+    return -1;
+}
+
+// Intermedio de la arena o, si la fragmentación no deja un bloque libre,
+// contiguo con malloc (punteros de fila seguidos de los datos)
+static int **crear_intermedio(MotorCadena *motor, int filas, int columnas) {
+    int **matriz = arena_intentar_crear_matriz_rect(&motor->arena, filas, columnas);
+    if (matriz != NULL) return matriz;
+    matriz = (int **)malloc(filas * sizeof(int *) + (size_t)filas * columnas * sizeof(int));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para una matriz de %dx%d\n", filas, columnas);
+        exit(1);
+    }
+    int *datos = (int *)(matriz + filas);
+    for (int i = 0; i < filas; i++) {
+        matriz[i] = datos + (size_t)i * columnas;
+    }
+    motor->fuera_de_arena++;
+    return matriz;
+}
+
+static void liberar_intermedio(MotorCadena *motor, int **matriz) {
+    if (arena_contiene(&motor->arena, matriz)) {
+        arena_liberar_matriz(&motor->arena, matriz);
+    } else {
+        free(matriz);
+    }
+}
+
+// Entrada libre o, si no hay, la menos usada recientemente que no esté fijada;
+// su bloque vuelve a la arena
+static int reservar_entrada(MotorCadena *motor) {
+    int victima = -1;
+    for (int e = 0; e < MAX_ENTRADAS_CACHE; e++) {
+        EntradaCache *entrada = &motor->cache[e];
+        if (!entrada->ocupada) return e;
+        if (entrada->fijada == 0 &&
+            (victima < 0 || entrada->ultimo_uso < motor->cache[victima].ultimo_uso)) {
+            victima = e;
+        }
+    }
+    if (victima < 0) {
+        printf("Error: Todas las entradas de la caché están en uso\n");
+        exit(1);
+    }
+    liberar_intermedio(motor, motor->cache[victima].resultado.datos);
+    motor->cache[victima].ocupada = 0;
+    return victima;
+}
+
+static void fijar(MotorCadena *motor, const MatrizCadena *M, int delta) {
+    if (M->entrada >= 0) motor->cache[M->entrada].fijada += delta;
+}
+
+// Producto I * D, servido desde la caché si ya se calculó para operandos con
+// el mismo contenido, dimensiones y rango
+MatrizCadena multiplicar_con_cache(MotorCadena *motor, const MatrizCadena *I, const MatrizCadena *D) {
+    int e = buscar_en_cache(motor, I, D);
+    if (e >= 0) {
+        motor->aciertos++;
+        return motor->cache[e].resultado;
+    }
+    motor->fallos++;
+
+    fijar(motor, I, 1);
+    fijar(motor, D, 1);
+    e = reservar_entrada(motor);
+
+    MatrizCadena R;
+    R.filas = I->filas;
+    R.columnas = D->columnas;
+    R.datos = crear_intermedio(motor, R.filas, R.columnas);
+    multiplicar_bloques_rect(I->datos, D->datos, R.datos, I->filas, I->columnas, D->columnas);
+    R.hash = hash_matriz(R.datos, R.filas, R.columnas);
+    R.entrada = e;
+    R.primero = I->primero;
+    R.largo = I->largo + D->largo;
+    motor->productos++;
+    motor->multiplicaciones_escalares += (long long)I->filas * I->columnas * D->columnas;
+
+    EntradaCache *entrada = &motor->cache[e];
+    entrada->izq = *I;
+    entrada->der = *D;
+    entrada->resultado = R;
+    entrada->ultimo_uso = ++motor->reloj;
+    entrada->fijada = 0;
+    entrada->ocupada = 1;
+
+    fijar(motor, I, -1);
+    fijar(motor, D, -1);
+    return R;
+}
+
+// ---------------------------------------------------------------------------
+// Cadenas: paréntesis óptimos por programación dinámica
+// ---------------------------------------------------------------------------
+
+// dims tiene k+1 elementos: la matriz i es dims[i] x dims[i+1]. Llena
+// division[i][j] con el punto de corte óptimo de A_i..A_j y devuelve el
+// número de multiplicaciones escalares
+long long parentesis_optimos(const int *dims, int k, int division[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA]) {
+    long long costo[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA];
+    for (int i = 0; i < k; i++) costo[i][i] = 0;
+
+    for (int largo = 2; largo <= k; largo++) {
+        for (int i = 0; i + largo - 1 < k; i++) {
+            int j = i + largo - 1;
+            costo[i][j] = -1;
+            for (int s = i; s < j; s++) {
+                long long c = costo[i][s] + costo[s + 1][j] +
+                              (long long)dims[i] * dims[s + 1] * dims[j + 1];
+                if (costo[i][j] < 0 || c < costo[i][j]) {
+                    costo[i][j] = c;
+                    division[i][j] = s;
+                }
+            }
+        }
+    }
+    return costo[0][k - 1];
+}
+
+long long costo_izquierda_a_derecha(const int *dims, int k) {
+    long long costo = 0;
+    for (int i = 1; i < k; i++) {
+        costo += (long long)dims[0] * dims[i] * dims[i + 1];
+    }
+    return costo;
+}
+
+void imprimir_parentesis(int division[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA], int i, int j) {
+    if (i == j) {
+        printf("A%d", i + 1);
+        return;
+    }
+    printf("(");
+    imprimir_parentesis(division, i, division[i][j]);
+    printf("·");
+    imprimir_parentesis(division, division[i][j] + 1, j);
+    printf(")");
+}
+
+MatrizCadena evaluar_cadena(MotorCadena *motor, const MatrizCadena *matrices,
+                            int division[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA], int i, int j) {
+    if (i == j) return matrices[i];
+    MatrizCadena I = evaluar_cadena(motor, matrices, division, i, division[i][j]);
+    fijar(motor, &I, 1); // que evaluar el lado derecho no lo desaloje
+    MatrizCadena D = evaluar_cadena(motor, matrices, division, division[i][j] + 1, j);
+    fijar(motor, &I, -1);
+    return multiplicar_con_cache(motor, &I, &D);
+}
+
+// Tamaños en la arena de los productos del plan, uno por nodo interno
+int tam_intermedios(const int *dims, int division[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA],
+                    int i, int j, size_t *tams) {
+    if (i == j) return 0;
+    int s = division[i][j];
+    int cuantos = tam_intermedios(dims, division, i, s, tams);
+    cuantos += tam_intermedios(dims, division, s + 1, j, tams + cuantos);
+    tams[cuantos] = arena_tam_matriz_rect(dims[i], dims[j + 1]);
+    return cuantos + 1;
+}
+
+static int comparar_tam_desc(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return x < y ? 1 : (x > y ? -1 : 0);
+}
+
+// Referencia sin caché: cada producto se calcula, alternando entre dos
+// buffers de la arena con las filas de A1 y las columnas del mayor intermedio
+MatrizCadena evaluar_izquierda_a_derecha(MotorCadena *motor, const MatrizCadena *matrices, int k,
+                                         int **buffers[2]) {
+    MatrizCadena R = matrices[0];
+    int actual = 0;
+    for (int i = 1; i < k; i++) {
+        const MatrizCadena *D = &matrices[i];
+        int **destino = buffers[actual];
+        for (int f = 1; f < R.filas; f++) {
+            destino[f] = destino[0] + (size_t)f * D->columnas;
+        }
+        multiplicar_bloques_rect(R.datos, D->datos, destino, R.filas, R.columnas, D->columnas);
+        motor->productos++;
+        motor->multiplicaciones_escalares += (long long)R.filas * R.columnas * D->columnas;
+        R.datos = destino;
+        R.columnas = D->columnas;
+        R.largo += D->largo;
+        R.entrada = -1;
+        actual ^= 1;
+    }
+    return R;
+}
+
+// ---------------------------------------------------------------------------
+// Potencias por cuadrados sucesivos
+// ---------------------------------------------------------------------------
+
+// A^k con O(log k) productos. Los cuadrados A, A^2, A^4, ... pasan por la
+// caché (otra potencia de la misma matriz los reutiliza); el acumulador
+// alterna entre dos buffers de la arena
+MatrizCadena potencia_por_cuadrados(MotorCadena *motor, const MatrizCadena *A, int k,
+                                    int **buffers[2]) {
+    int n = A->filas;
+    MatrizCadena cuadrado = *A;
+    MatrizCadena acumulado = {NULL, n, n, 0, -1, A->primero, 0};
+    int hay_acumulado = 0;
+    int actual = 0;
+
+    while (k > 0) {
+        if (k & 1) {
+            if (!hay_acumulado) {
+                acumulado = cuadrado;
+                hay_acumulado = 1;
+            } else {
+                int **destino = buffers[actual];
+                multiplicar_bloques_rect(acumulado.datos, cuadrado.datos, destino, n, n, n);
+                motor->productos++;
+                motor->multiplicaciones_escalares += (long long)n * n * n;
+                acumulado.hash = hash_matriz(destino, n, n);
+                acumulado.datos = destino;
+                acumulado.entrada = -1;
+                acumulado.largo += cuadrado.largo;
+                actual ^= 1;
+            }
+        }
+        k >>= 1;
+        if (k > 0) {
+            fijar(motor, &acumulado, 1);
+            MatrizCadena siguiente = multiplicar_con_cache(motor, &cuadrado, &cuadrado);
+            fijar(motor, &acumulado, -1);
+            cuadrado = siguiente;
+        }
+    }
+    return acumulado;
+}
+
+// Referencia: k-1 productos sucesivos, también con doble buffer
+uint64_t potencia_ingenua(const MatrizCadena *A, int k, int **buffers[2]) {
+    int n = A->filas;
+    int **anterior = A->datos;
+    int actual = 0;
+    for (int p = 1; p < k; p++) {
+        multiplicar_bloques_rect(anterior, A->datos, buffers[actual], n, n, n);
+        anterior = buffers[actual];
+        actual ^= 1;
+    }
+    return hash_matriz(anterior, n, n);
+}
+
+// ---------------------------------------------------------------------------
+
+void generar_matriz_aleatoria_rect(int **M, int filas, int columnas, unsigned int semilla) {
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            M[i][j] = rand_r(&semilla) % 100;
+        }
+    }
+}
+
+MatrizCadena crear_operando(MotorCadena *motor, int filas, int columnas, unsigned int semilla, int indice) {
+    MatrizCadena M;
+    M.filas = filas;
+    M.columnas = columnas;
+    M.datos = arena_crear_matriz_rect(&motor->arena, filas, columnas);
+    generar_matriz_aleatoria_rect(M.datos, filas, columnas, semilla);
+    M.hash = hash_matriz(M.datos, filas, columnas);
+    M.entrada = -1;
+    M.primero = indice;
+    M.largo = 1;
+    return M;
+}
+
+void iniciar_motor(MotorCadena *motor, size_t capacidad) {
+    memset(motor, 0, sizeof(*motor));
+    arena_crear(&motor->arena, capacidad, ARENA_PAGINAS_THP, omp_get_max_threads());
+}
+
+// Libera los intermedios de la caché que quedaron fuera de la arena y la arena
+void destruir_motor(MotorCadena *motor) {
+    for (int e = 0; e < MAX_ENTRADAS_CACHE; e++) {
+        if (motor->cache[e].ocupada) liberar_intermedio(motor, motor->cache[e].resultado.datos);
+    }
+    arena_destruir(&motor->arena);
+    free(motor);
+}
+
+void imprimir_estadisticas(MotorCadena *motor, const char *etapa) {
+    printf("%s: %d productos calculados, %d aciertos de caché, %d fallos, %.3e multiplicaciones escalares\n",
+           etapa, motor->productos, motor->aciertos, motor->fallos, (double)motor->multiplicaciones_escalares);
+    if (motor->fuera_de_arena > 0) {
+        printf("  %d intermedios con malloc (sin espacio en la arena)\n", motor->fuera_de_arena);
+    }
+    motor->productos = motor->aciertos = motor->fallos = motor->fuera_de_arena = 0;
+    motor->multiplicaciones_escalares = 0;
+}
+
+int ejecutar_cadena(const int *dims, int k, int repeticiones) {
+    int total = k * repeticiones;
+    int dims_total[MAX_MATRICES_CADENA + 1];
+    for (int r = 0; r < repeticiones; r++) {
+        for (int i = 0; i < k; i++) dims_total[r * k + i] = dims[i];
+    }
+    dims_total[total] = dims[k];
+
+    int division[MAX_MATRICES_CADENA][MAX_MATRICES_CADENA];
+    long long costo_optimo = parentesis_optimos(dims_total, total, division);
+    long long costo_lineal = costo_izquierda_a_derecha(dims_total, total);
+
+    // Espacio: operandos, el pico de intermedios vivos del plan (la caché
+    // retiene hasta MAX_ENTRADAS_CACHE; se cuentan los más grandes) y los dos
+    // buffers de la referencia. Si la fragmentación no deja sitio, malloc
+    size_t operandos = 0;
+    for (int i = 0; i < total; i++) {
+        operandos += arena_tam_matriz_rect(dims_total[i], dims_total[i + 1]);
+    }
+    size_t tams[MAX_MATRICES_CADENA];
+    int num_intermedios = tam_intermedios(dims_total, division, 0, total - 1, tams);
+    qsort(tams, num_intermedios, sizeof(size_t), comparar_tam_desc);
+    size_t pico = 0;
+    for (int i = 0; i < num_intermedios && i < MAX_ENTRADAS_CACHE; i++) {
+        pico += tams[i];
+    }
+    int columnas_referencia = 1;
+    for (int i = 2; i <= total; i++) {
+        if (dims_total[i] > columnas_referencia) columnas_referencia = dims_total[i];
+    }
+    MotorCadena *motor = (MotorCadena *)malloc(sizeof(MotorCadena));
+    iniciar_motor(motor, operandos + pico + 2 * arena_tam_matriz_rect(dims_total[0], columnas_referencia));
+
+    // Las repeticiones usan las mismas semillas y los mismos índices de
+    // operando: mismo contenido, misma clave de caché
+    MatrizCadena matrices[MAX_MATRICES_CADENA];
+    unsigned int semilla = time(NULL);
+    for (int i = 0; i < total; i++) {
+        matrices[i] = crear_operando(motor, dims_total[i], dims_total[i + 1], semilla + i % k, i % k);
+    }
+    int **buffers[2] = {arena_crear_matriz_rect(&motor->arena, dims_total[0], columnas_referencia),
+                        arena_crear_matriz_rect(&motor->arena, dims_total[0], columnas_referencia)};
+
+    printf("=== CADENA DE PRODUCTOS DE MATRICES ===\n");
+    printf("Matrices: %d (%d repeticiones de %d)\n", total, repeticiones, k);
+    printf("Dimensiones:");
+    for (int i = 0; i <= total; i++) printf(" %d", dims_total[i]);
+    printf("\nHilos: %d\n", omp_get_max_threads());
+    printf("Paréntesis óptimos: ");
+    imprimir_parentesis(division, 0, total - 1);
+    printf("\nCosto óptimo: %.3e multiplicaciones escalares\n", (double)costo_optimo);
+    printf("Costo izquierda a derecha: %.3e multiplicaciones escalares (%.2fx)\n\n",
+           (double)costo_lineal, (double)costo_lineal / costo_optimo);
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    MatrizCadena optima = evaluar_cadena(motor, matrices, division, 0, total - 1);
+    std::chrono::duration<double> t_optima = std::chrono::high_resolution_clock::now() - inicio;
+    uint64_t hash_optima = hash_matriz(optima.datos, optima.filas, optima.columnas);
+    printf("Tiempo de multiplicación con paréntesis óptimos: %f segundos\n", t_optima.count());
+    imprimir_estadisticas(motor, "  Caché fría");
+
+    inicio = std::chrono::high_resolution_clock::now();
+    evaluar_cadena(motor, matrices, division, 0, total - 1);
+    std::chrono::duration<double> t_repetida = std::chrono::high_resolution_clock::now() - inicio;
+    printf("Tiempo de la misma cadena otra vez: %f segundos\n", t_repetida.count());
+    imprimir_estadisticas(motor, "  Caché caliente");
+
+    // Referencia sin caché: no reutiliza productos de las corridas anteriores
+    inicio = std::chrono::high_resolution_clock::now();
+    MatrizCadena lineal = evaluar_izquierda_a_derecha(motor, matrices, total, buffers);
+    std::chrono::duration<double> t_lineal = std::chrono::high_resolution_clock::now() - inicio;
+    uint64_t hash_lineal = hash_matriz(lineal.datos, lineal.filas, lineal.columnas);
+    printf("Tiempo de multiplicación izquierda a derecha: %f segundos\n", t_lineal.count());
+    imprimir_estadisticas(motor, "  Izquierda a derecha");
+
+    int correcto = hash_optima == hash_lineal;
+    printf("\nVerificación (óptima vs izquierda a derecha): %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("Speedup por paréntesis óptimos: %.2fx\n", t_lineal.count() / t_optima.count());
+
+    destruir_motor(motor);
+    return correcto ? 0 : 1;
+}
+
+int ejecutar_potencia(int n, int k) {
+    // A, dos pares de buffers y un cuadrado en caché por bit del exponente
+    int bits = 0;
+    while ((k + 1) >> bits) bits++;
+    size_t tam = arena_tam_matriz(n);
+    MotorCadena *motor = (MotorCadena *)malloc(sizeof(MotorCadena));
+    iniciar_motor(motor, (size_t)(1 + 4 + bits + 1) * tam);
+
+    MatrizCadena A = crear_operando(motor, n, n, time(NULL), 0);
+    int **buffers[2] = {arena_crear_matriz(&motor->arena, n), arena_crear_matriz(&motor->arena, n)};
+    int **buffers_ingenua[2] = {arena_crear_matriz(&motor->arena, n), arena_crear_matriz(&motor->arena, n)};
+
+    printf("=== POTENCIA DE MATRIZ POR CUADRADOS ===\n");
+    printf("Tamaño de matriz: %dx%d\n", n, n);
+    printf("Exponente: %d\n", k);
+    printf("Hilos: %d\n\n", omp_get_max_threads());
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    MatrizCadena P = potencia_por_cuadrados(motor, &A, k, buffers);
+    std::chrono::duration<double> t_cuadrados = std::chrono::high_resolution_clock::now() - inicio;
+    uint64_t hash_cuadrados = hash_matriz(P.datos, n, n);
+    printf("Tiempo de potencia por cuadrados: %f segundos\n", t_cuadrados.count());
+    imprimir_estadisticas(motor, "  Caché fría");
+
+    // A^(k+1) reutiliza los cuadrados ya calculados
+    inicio = std::chrono::high_resolution_clock::now();
+    potencia_por_cuadrados(motor, &A, k + 1, buffers);
+    std::chrono::duration<double> t_siguiente = std::chrono::high_resolution_clock::now() - inicio;
+    printf("Tiempo de A^%d con los cuadrados en caché: %f segundos\n", k + 1, t_siguiente.count());
+    imprimir_estadisticas(motor, "  Caché caliente");
+
+    inicio = std::chrono::high_resolution_clock::now();
+    uint64_t hash_ingenua = potencia_ingenua(&A, k, buffers_ingenua);
+    std::chrono::duration<double> t_ingenua = std::chrono::high_resolution_clock::now() - inicio;
+    printf("Tiempo de potencia ingenua (%d productos): %f segundos\n", k - 1, t_ingenua.count());
+
+    int correcto = hash_cuadrados == hash_ingenua;
+    printf("\nVerificación (cuadrados vs ingenua): %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("Speedup por cuadrados: %.2fx\n", t_ingenua.count() / t_cuadrados.count());
+
+    destruir_motor(motor);
+    return correcto ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 5 && strcmp(argv[1], "potencia") == 0) {
+        int n = atoi(argv[2]);
+        int k = atoi(argv[3]);
+        int num_hilos = atoi(argv[4]);
+        if (n > 0 && k > 0 && num_hilos > 0) {
+            omp_set_num_threads(num_hilos);
+            return ejecutar_potencia(n, k);
+        }
+    } else if (argc >= 6 && strcmp(argv[1], "cadena") == 0) {
+        int num_hilos = atoi(argv[2]);
+        int repeticiones = 1;
+        int ultimo = argc - 1;
+        if (strncmp(argv[ultimo], "--repetir=", 10) == 0) {
+            repeticiones = atoi(argv[ultimo] + 10);
+            ultimo--;
+        }
+        int k = ultimo - 3; // dimensiones argv[3..ultimo]
+        int dims[MAX_MATRICES_CADENA + 1];
+        int validos = num_hilos > 0 && k >= 2 && repeticiones > 0 && k * repeticiones <= MAX_MATRICES_CADENA;
+        for (int i = 0; validos && i <= k; i++) {
+            dims[i] = atoi(argv[3 + i]);
+            validos = dims[i] > 0;
+        }
+        // Repetir la cadena sólo tiene sentido si es cuadrada de extremo a extremo
+        if (validos && repeticiones > 1 && dims[0] != dims[k]) {
+            printf("Error: Para --repetir la primera y la última dimensión deben coincidir\n");
+            return 1;
+        }
+        if (validos) {
+            omp_set_num_threads(num_hilos);
+            return ejecutar_cadena(dims, k, repeticiones);
+        }
+    }
+
+    printf("Uso: %s potencia <tamaño_matriz> <exponente> <num_hilos>\n", argv[0]);
+    printf("     %s cadena <num_hilos> <d0> <d1> ... <dk> [--repetir=r]\n", argv[0]);
+    printf("Ejemplo: %s potencia 512 13 4\n", argv[0]);
+    printf("         %s cadena 4 300 20 800 40 300 --repetir=2\n", argv[0]);
+    return 1;
+}
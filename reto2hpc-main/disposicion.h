@@ -0,0 +1,279 @@
+#ifndef DISPOSICION_H
+#define DISPOSICION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <omp.h>
+
+// Disposiciones de una matriz n x n en memoria y conversión entre ellas:
+//   - filas:    la interfaz int** de siempre (B[k][j] recorre B por columnas)
+//   - columnas: la traspuesta contigua; B en columnas hace que el producto
+//               punto de la fila i de A con la columna j de B sea contiguo
+//   - teselas:  teselas de DISP_TESELA x DISP_TESELA contiguas, en orden de
+//               filas de teselas; los bordes se rellenan con ceros
+//   - morton:   las mismas teselas en orden Z (Morton), así que teselas
+//               vecinas en las dos dimensiones quedan cerca en memoria
+//
+// La conversión es recursiva (cache-oblivious): divide la matriz por la
+// dimensión más larga hasta hojas de DISP_HOJA x DISP_HOJA, que caben en L1
+// tanto en el origen como en el destino, y reparte las mitades grandes como
+// tareas OpenMP. Cada disposición tiene su kernel en este archivo.
+
+#define DISP_TESELA 64 // potencia de 2, múltiplo de DISP_HOJA
+#define DISP_HOJA 32
+#define DISP_AREA_TAREA (256 * 256) // por debajo, la recursión sigue en la misma tarea
+
+typedef enum {
+    DISP_FILAS,
+    DISP_COLUMNAS,
+    DISP_TESELAS,
+    DISP_MORTON,
+    DISP_NUM_DISPOSICIONES
+} disposicion_t;
+
+typedef struct {
+    disposicion_t tipo;
+    int n;
+    int n_relleno;    // n redondeado a teselas (teselas y morton) o n
+    int teselas;      // teselas por lado
+    int **filas;      // DISP_FILAS: vista int**, no es propiedad de la matriz
+    int *datos;       // resto: bloque contiguo alineado a 64 bytes
+    size_t *offset;   // teselas y morton: inicio de cada tesela (ti * teselas + tj)
+    int *tesela_de_rango; // tesela guardada en la posición r de la memoria
+} MatrizDispuesta;
+
+static inline const char *nombre_disposicion(disposicion_t tipo) {
+    switch (tipo) {
+        case DISP_FILAS:    return "filas";
+        case DISP_COLUMNAS: return "columnas";
+        case DISP_TESELAS:  return "teselas";
+        case DISP_MORTON:   return "morton";
+        default:            return "desconocida";
+    }
+}
+
+// Intercala los bits de fila y columna: ...f1 c1 f0 c0
+static inline uint64_t codigo_morton(uint32_t fila, uint32_t columna) {
+    uint64_t codigo = 0;
+    for (int b = 0; b < 32; b++) {
+        codigo |= (uint64_t)((columna >> b) & 1) << (2 * b);
+        codigo |= (uint64_t)((fila >> b) & 1) << (2 * b + 1);
+    }
+    return codigo;
+}
+
+typedef struct {
+    uint64_t codigo;
+    int tesela;
+} TeselaMorton;
+
+static inline int comparar_teselas_morton(const void *a, const void *b) {
+    uint64_t ca = ((const TeselaMorton *)a)->codigo;
+    uint64_t cb = ((const TeselaMorton *)b)->codigo;
+    return (ca > cb) - (ca < cb);
+}
+
+// Vista de una matriz int** existente como disposición por filas
+static inline MatrizDispuesta disposicion_vista_filas(int **matriz, int n) {
+    MatrizDispuesta m;
+    memset(&m, 0, sizeof(m));
+    m.tipo = DISP_FILAS;
+    m.n = m.n_relleno = n;
+    m.filas = matriz;
+    return m;
+}
+
+// Reserva una matriz en la disposición dada (no DISP_FILAS); el relleno de
+// las teselas queda en cero, y el primer toque se hace en paralelo
+static inline MatrizDispuesta disposicion_crear(disposicion_t tipo, int n) {
+    MatrizDispuesta m;
+    memset(&m, 0, sizeof(m));
+    m.tipo = tipo;
+    m.n = n;
+    m.teselas = (n + DISP_TESELA - 1) / DISP_TESELA;
+    m.n_relleno = tipo == DISP_COLUMNAS ? n : m.teselas * DISP_TESELA;
+
+    size_t elementos = (size_t)m.n_relleno * m.n_relleno;
+    size_t bytes = (elementos * sizeof(int) + 63) & ~(size_t)63;
+    m.datos = (int *)aligned_alloc(64, bytes);
+    if (m.datos == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz en disposición %s\n", nombre_disposicion(tipo));
+        exit(1);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < m.n_relleno; i++) {
+        memset(m.datos + (size_t)i * m.n_relleno, 0, m.n_relleno * sizeof(int));
+    }
+
+    if (tipo == DISP_TESELAS || tipo == DISP_MORTON) {
+        int total = m.teselas * m.teselas;
+        m.offset = (size_t *)malloc(total * sizeof(size_t));
+        m.tesela_de_rango = (int *)malloc(total * sizeof(int));
+        if (m.offset == NULL || m.tesela_de_rango == NULL) {
+            printf("Error: No se pudo asignar memoria para la tabla de teselas\n");
+            exit(1);
+        }
+        for (int t = 0; t < total; t++) m.tesela_de_rango[t] = t;
+        if (tipo == DISP_MORTON) {
+            // Orden Z aunque el número de teselas no sea potencia de 2: se
+            // ordenan los códigos de las teselas que existen
+            TeselaMorton *orden = (TeselaMorton *)malloc(total * sizeof(TeselaMorton));
+            for (int t = 0; t < total; t++) {
+                orden[t].codigo = codigo_morton(t / m.teselas, t % m.teselas);
+                orden[t].tesela = t;
+            }
+            qsort(orden, total, sizeof(TeselaMorton), comparar_teselas_morton);
+            for (int r = 0; r < total; r++) m.tesela_de_rango[r] = orden[r].tesela;
+            free(orden);
+        }
+        for (int r = 0; r < total; r++) {
+            m.offset[m.tesela_de_rango[r]] = (size_t)r * DISP_TESELA * DISP_TESELA;
+        }
+    }
+    return m;
+}
+
+static inline void disposicion_destruir(MatrizDispuesta *m) {
+    if (m->tipo == DISP_FILAS) return; // vista: la matriz es de quien la creó
+    free(m->datos);
+    free(m->offset);
+    free(m->tesela_de_rango);
+}
+
+// Puntero al elemento (i, j) y distancia entre (i, j) y (i, j + 1). Dentro de
+// una hoja alineada los elementos de una fila nunca cruzan de tesela
+static inline int *disposicion_elemento(const MatrizDispuesta *m, int i, int j, size_t *paso) {
+    switch (m->tipo) {
+        case DISP_FILAS:
+            *paso = 1;
+            return &m->filas[i][j];
+        case DISP_COLUMNAS:
+            *paso = m->n_relleno;
+            return m->datos + (size_t)j * m->n_relleno + i;
+        default:
+            *paso = 1;
+            return m->datos + m->offset[(i / DISP_TESELA) * m->teselas + j / DISP_TESELA]
+                   + (i % DISP_TESELA) * DISP_TESELA + j % DISP_TESELA;
+    }
+}
+
+static inline void disposicion_copiar_hoja(const MatrizDispuesta *origen, MatrizDispuesta *destino,
+                                           int i0, int i1, int j0, int j1) {
+    for (int i = i0; i < i1; i++) {
+        size_t paso_o, paso_d;
+        const int *o = disposicion_elemento(origen, i, j0, &paso_o);
+        int *d = disposicion_elemento(destino, i, j0, &paso_d);
+        if (paso_o == 1 && paso_d == 1) {
+            memcpy(d, o, (j1 - j0) * sizeof(int));
+        } else {
+            for (int j = 0; j < j1 - j0; j++) {
+                d[j * paso_d] = o[j * paso_o];
+            }
+        }
+    }
+}
+
+static inline void disposicion_copiar_recursivo(const MatrizDispuesta *origen, MatrizDispuesta *destino,
+                                                int i0, int i1, int j0, int j1) {
+    int alto = i1 - i0, ancho = j1 - j0;
+    if (alto <= DISP_HOJA && ancho <= DISP_HOJA) {
+        disposicion_copiar_hoja(origen, destino, i0, i1, j0, j1);
+        return;
+    }
+    // Cortar la dimensión más larga en un múltiplo de DISP_HOJA: así las
+    // hojas quedan alineadas a las teselas
+    int tarea = (size_t)alto * ancho > DISP_AREA_TAREA;
+    if (alto >= ancho) {
+        int medio = i0 + ((alto / 2 + DISP_HOJA - 1) / DISP_HOJA) * DISP_HOJA;
+        #pragma omp task if (tarea)
+        disposicion_copiar_recursivo(origen, destino, i0, medio, j0, j1);
+        disposicion_copiar_recursivo(origen, destino, medio, i1, j0, j1);
+    } else {
+        int medio = j0 + ((ancho / 2 + DISP_HOJA - 1) / DISP_HOJA) * DISP_HOJA;
+        #pragma omp task if (tarea)
+        disposicion_copiar_recursivo(origen, destino, i0, i1, j0, medio);
+        disposicion_copiar_recursivo(origen, destino, i0, i1, medio, j1);
+    }
+    #pragma omp taskwait
+}
+
+// Copia los n x n elementos de origen a destino, en cualquier par de
+// disposiciones del mismo tamaño
+static inline void disposicion_convertir(const MatrizDispuesta *origen, MatrizDispuesta *destino) {
+    #pragma omp parallel
+    #pragma omp single
+    disposicion_copiar_recursivo(origen, destino, 0, origen->n, 0, origen->n);
+}
+
+// C = A * B con B en columnas: cada C[i][j] es un producto punto contiguo.
+// Bloques de columnas de B y de k para que el tramo de B quepa en L2
+static inline void multiplicar_disposicion_columnas(int **A, const MatrizDispuesta *Bc, int **C, int n) {
+    const int BLOQUE_J = 64, BLOQUE_K = 256;
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += DISP_TESELA) {
+        for (int jj = 0; jj < n; jj += BLOQUE_J) {
+            int i_end = (ii + DISP_TESELA < n) ? ii + DISP_TESELA : n;
+            int j_end = (jj + BLOQUE_J < n) ? jj + BLOQUE_J : n;
+            for (int i = ii; i < i_end; i++) {
+                for (int j = jj; j < j_end; j++) C[i][j] = 0;
+            }
+            for (int kk = 0; kk < n; kk += BLOQUE_K) {
+                int k_end = (kk + BLOQUE_K < n) ? kk + BLOQUE_K : n;
+                for (int i = ii; i < i_end; i++) {
+                    const int *a = A[i];
+                    for (int j = jj; j < j_end; j++) {
+                        const int *b = Bc->datos + (size_t)j * Bc->n_relleno;
+                        int sum = 0;
+                        #pragma omp simd reduction(+:sum)
+                        for (int k = kk; k < k_end; k++) {
+                            sum += a[k] * b[k];
+                        }
+                        C[i][j] += sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C = A * B con A y B en teselas (o en orden Morton): cada tesela de C se
+// acumula en un buffer local con el orden i-k-j, contiguo en las tres
+// teselas, y se recorre en el orden de memoria de la disposición. El relleno
+// en cero hace innecesario tratar los bordes salvo al escribir C
+static inline void multiplicar_disposicion_teselas(const MatrizDispuesta *A, const MatrizDispuesta *B,
+                                                   int **C, int n) {
+    const int T = DISP_TESELA;
+    int nt = A->teselas;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int r = 0; r < nt * nt; r++) {
+        int tesela = A->tesela_de_rango[r];
+        int ti = tesela / nt, tj = tesela % nt;
+        int acumulado[DISP_TESELA * DISP_TESELA] __attribute__((aligned(64))) = {0};
+
+        for (int tk = 0; tk < nt; tk++) {
+            const int *a = A->datos + A->offset[ti * nt + tk];
+            const int *b = B->datos + B->offset[tk * nt + tj];
+            for (int i = 0; i < T; i++) {
+                int *c = acumulado + i * T;
+                for (int k = 0; k < T; k++) {
+                    int aik = a[i * T + k];
+                    const int *bk = b + k * T;
+                    #pragma omp simd
+                    for (int j = 0; j < T; j++) {
+                        c[j] += aik * bk[j];
+                    }
+                }
+            }
+        }
+
+        int i_end = (ti + 1) * T < n ? T : n - ti * T;
+        int j_end = (tj + 1) * T < n ? T : n - tj * T;
+        for (int i = 0; i < i_end; i++) {
+            memcpy(&C[ti * T + i][tj * T], acumulado + i * T, j_end * sizeof(int));
+        }
+    }
+}
+
+#endif
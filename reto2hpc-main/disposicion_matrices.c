@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "disposicion.h"
+
+//disposicion_matrices.c
+// ¿Compensa cambiar la disposición de las matrices antes de multiplicar?
+// Para cada n compara el kernel por bloques de multiplicacion_openmp.c, que
+// lee B[k][j] por columnas, con los kernels de disposicion.h sobre B en
+// columnas y sobre A y B en teselas y en orden Morton. El tiempo de cada
+// disposición incluye convertir los operandos desde int**; si no compensa en
+// un solo producto se reporta cuántos productos con los mismos operandos
+// hacen falta para amortizar la conversión.
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Función para crear una matriz cuadrada dinámicamente
+int **crear_matriz(int n) {
+    int **matriz = (int **)malloc(n * sizeof(int *));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        matriz[i] = (int *)malloc(n * sizeof(int));
+        if (matriz[i] == NULL) {
+            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(1);
+        }
+    }
+
+    return matriz;
+}
+
+// Función para liberar memoria de una matriz
+void liberar_matriz(int **matriz, int n) {
+    for (int i = 0; i < n; i++) {
+        free(matriz[i]);
+    }
+    free(matriz);
+}
+
+// Generación paralela con semilla por fila
+void generar_matriz_aleatoria_paralela(int **matriz, int n) {
+    unsigned int base = time(NULL);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int seed = base + i * 7919;
+        for (int j = 0; j < n; j++) {
+            matriz[i][j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// Referencia: el kernel por bloques de multiplicacion_openmp.c sobre int**
+void multiplicar_disposicion_filas(int **A, int **B, int **C, int n) {
+    const int BLOCK_SIZE = 64;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[i][k] * B[k][j];
+                        }
+                        C[i][j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int matrices_iguales(int **X, int **Y, int n) {
+    int iguales = 1;
+    #pragma omp parallel for schedule(static) reduction(&&:iguales)
+    for (int i = 0; i < n; i++) {
+        iguales = iguales && memcmp(X[i], Y[i], n * sizeof(int)) == 0;
+    }
+    return iguales;
+}
+
+typedef struct {
+    double conversion; // segundos
+    double producto;
+    int correcto;
+} ResultadoDisposicion;
+
+// Convierte los operandos que usa el kernel de la disposición, multiplica y
+// compara con la referencia
+ResultadoDisposicion medir_disposicion(disposicion_t tipo, int **A, int **B, int **C, int **C_ref, int n) {
+    ResultadoDisposicion r = {0.0, 0.0, 1};
+    MatrizDispuesta vista_A = disposicion_vista_filas(A, n);
+    MatrizDispuesta vista_B = disposicion_vista_filas(B, n);
+
+    if (tipo == DISP_COLUMNAS) {
+        MatrizDispuesta Bc = disposicion_crear(DISP_COLUMNAS, n);
+        double inicio = get_time_microseconds();
+        disposicion_convertir(&vista_B, &Bc);
+        r.conversion = (get_time_microseconds() - inicio) / 1e6;
+
+        inicio = get_time_microseconds();
+        multiplicar_disposicion_columnas(A, &Bc, C, n);
+        r.producto = (get_time_microseconds() - inicio) / 1e6;
+        disposicion_destruir(&Bc);
+    } else {
+        // La reserva y el primer toque no cuentan: también se excluyen de la
+        // referencia, que recibe A, B y C ya creadas
+        MatrizDispuesta At = disposicion_crear(tipo, n);
+        MatrizDispuesta Bt = disposicion_crear(tipo, n);
+        double inicio = get_time_microseconds();
+        disposicion_convertir(&vista_A, &At);
+        disposicion_convertir(&vista_B, &Bt);
+        r.conversion = (get_time_microseconds() - inicio) / 1e6;
+
+        inicio = get_time_microseconds();
+        multiplicar_disposicion_teselas(&At, &Bt, C, n);
+        r.producto = (get_time_microseconds() - inicio) / 1e6;
+        disposicion_destruir(&At);
+        disposicion_destruir(&Bt);
+    }
+    r.correcto = matrices_iguales(C, C_ref, n);
+    return r;
+}
+
+// Mide todas las disposiciones para un tamaño; devuelve 0 si alguna falla
+int comparar_disposiciones(int n) {
+    int **A = crear_matriz(n);
+    int **B = crear_matriz(n);
+    int **C = crear_matriz(n);
+    int **C_ref = crear_matriz(n);
+    generar_matriz_aleatoria_paralela(A, n);
+    generar_matriz_aleatoria_paralela(B, n);
+
+    double inicio = get_time_microseconds();
+    multiplicar_disposicion_filas(A, B, C_ref, n);
+    double referencia = (get_time_microseconds() - inicio) / 1e6;
+    double operaciones = 2.0 * n * n * n;
+
+    printf("%6d %-9s %12s %12.6f %12.6f %8.2f %9s %12s\n", n, "filas", "-", referencia, referencia,
+           operaciones / referencia / 1e9, "-", "-");
+
+    int correcto = 1;
+    for (int t = DISP_COLUMNAS; t < DISP_NUM_DISPOSICIONES; t++) {
+        ResultadoDisposicion r = medir_disposicion((disposicion_t)t, A, B, C, C_ref, n);
+        double total = r.conversion + r.producto;
+        char amortizar[32];
+        if (total < referencia) {
+            snprintf(amortizar, sizeof(amortizar), "1");
+        } else if (r.producto < referencia) {
+            // k productos con los operandos ya convertidos: conversion + k * producto < k * referencia
+            snprintf(amortizar, sizeof(amortizar), "%d", (int)(r.conversion / (referencia - r.producto)) + 1);
+        } else {
+            snprintf(amortizar, sizeof(amortizar), "nunca");
+        }
+        printf("%6d %-9s %12.6f %12.6f %12.6f %8.2f %9s %12s%s\n", n, nombre_disposicion((disposicion_t)t),
+               r.conversion, r.producto, total, operaciones / r.producto / 1e9,
+               total < referencia ? "sí" : "no", amortizar, r.correcto ? "" : "  INCORRECTO");
+        correcto &= r.correcto;
+    }
+
+    liberar_matriz(A, n);
+    liberar_matriz(B, n);
+    liberar_matriz(C, n);
+    liberar_matriz(C_ref, n);
+    return correcto;
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    int barrido = argc == 4 && strcmp(argv[3], "--barrido") == 0;
+    if (argc < 3 || argc > 4 || (argc == 4 && !barrido)) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [--barrido]\n", argv[0]);
+        printf("  --barrido: n = 128, 256, ... hasta tamaño_matriz\n");
+        printf("Ejemplo: %s 8192 4 --barrido\n", argv[0]);
+        return 1;
+    }
+
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    if (n <= 0 || num_hilos <= 0) {
+        printf("Error: El tamaño de matriz y número de hilos deben ser positivos\n");
+        return 1;
+    }
+    omp_set_num_threads(num_hilos);
+
+    printf("=== DISPOSICIONES DE MATRICES: FILAS, COLUMNAS, TESELAS Y MORTON ===\n");
+    printf("Número de hilos: %d\n", num_hilos);
+    printf("Tesela: %dx%d, hoja de conversión: %dx%d\n\n", DISP_TESELA, DISP_TESELA, DISP_HOJA, DISP_HOJA);
+    printf("Tiempos en segundos; la conversión es de int** a la disposición (B en columnas, A y B en teselas)\n");
+    printf("'Productos' es cuántos productos con los mismos operandos amortizan la conversión\n\n");
+    printf("%6s %-9s %12s %12s %12s %8s %9s %12s\n", "n", "Disp.", "Conversión", "Producto", "Total",
+           "GOPS", "Compensa", "Productos");
+
+    int correcto = 1;
+    if (barrido) {
+        for (int m = 128; m <= n; m *= 2) {
+            correcto &= comparar_disposiciones(m);
+        }
+    } else {
+        correcto = comparar_disposiciones(n);
+    }
+
+    printf("\nVerificación contra la disposición por filas: %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,346 @@
+#ifndef EJECUTOR_ASINCRONO_H
+#define EJECUTOR_ASINCRONO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "kernels_fijos.h"
+
+// API asíncrona de multiplicación: asinc_enviar(A, B, C) devuelve enseguida
+// un futuro y el producto se calcula en un pool compartido de hilos, de modo
+// que quien llama puede preparar la siguiente entrada (leerla, generarla...)
+// mientras tanto.
+//
+//   EjecutorAsincrono e;
+//   asinc_crear(&e, num_hilos, capacidad_cola);
+//   FuturoProducto *f = asinc_enviar(&e, A, B, C, n, prioridad);
+//   ... otro trabajo ...
+//   asinc_esperar(f);        // ASINC_COMPLETADO o ASINC_CANCELADO
+//   asinc_liberar(f);
+//   asinc_destruir(&e);
+//
+// Cada producto se parte en bandas de ASINC_BANDA filas de C y los hilos del
+// pool toman bandas del producto de mayor prioridad (a igual prioridad, del
+// más antiguo). Varios productos concurrentes comparten así los mismos
+// num_hilos hilos, sin sobresuscripción, y un producto urgente entra en
+// cuanto un hilo termina su banda actual.
+//
+// La cola está acotada: asinc_enviar bloquea y asinc_intentar_enviar
+// devuelve NULL mientras haya capacidad_cola productos con bandas por
+// repartir. asinc_cancelar quita de la cola las bandas que no han empezado;
+// las que están en curso terminan, y el contenido de C queda indefinido. Si
+// ya no queda ninguna banda por repartir es tarde para cancelar: el producto
+// termina COMPLETADO y C es válida.
+
+#define ASINC_BANDA 64 // filas de C por tarea; múltiplo del bloque de 64
+
+typedef enum {
+    ASINC_PENDIENTE,
+    ASINC_EN_CURSO,
+    ASINC_COMPLETADO,
+    ASINC_CANCELADO
+} estado_futuro_t;
+
+typedef struct EjecutorAsincrono EjecutorAsincrono;
+
+typedef struct {
+    EjecutorAsincrono *ejecutor;
+    int **A;
+    int **B;
+    int **C;
+    int n;
+    int prioridad;           // mayor primero
+    unsigned long secuencia; // orden de envío, desempata prioridades
+    int posicion;            // índice en el montículo, -1 fuera de la cola
+
+    int bandas;
+    int siguiente_banda;     // próxima banda por repartir
+    int bandas_terminadas;
+    int cancelado;
+    estado_futuro_t estado;
+
+    double envio;            // segundos (CLOCK_MONOTONIC)
+    double inicio;
+    double fin;
+} FuturoProducto;
+
+struct EjecutorAsincrono {
+    pthread_t *hilos;
+    int num_hilos;
+
+    // Montículo de máximos por (prioridad, -secuencia) con los productos que
+    // aún tienen bandas sin repartir
+    FuturoProducto **cola;
+    int en_cola;
+    int capacidad;
+    unsigned long secuencia;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t hay_trabajo;
+    pthread_cond_t hay_espacio;
+    pthread_cond_t terminado; // algún futuro pasó a completado o cancelado
+    int terminar;
+};
+
+static inline double asinc_tiempo_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline int asinc_antes(const FuturoProducto *a, const FuturoProducto *b) {
+    if (a->prioridad != b->prioridad) return a->prioridad > b->prioridad;
+    return a->secuencia < b->secuencia;
+}
+
+static inline void asinc_colocar(EjecutorAsincrono *e, int posicion, FuturoProducto *f) {
+    e->cola[posicion] = f;
+    f->posicion = posicion;
+}
+
+static inline void asinc_subir(EjecutorAsincrono *e, int posicion) {
+    FuturoProducto *f = e->cola[posicion];
+    while (posicion > 0) {
+        int padre = (posicion - 1) / 2;
+        if (!asinc_antes(f, e->cola[padre])) break;
+        asinc_colocar(e, posicion, e->cola[padre]);
+        posicion = padre;
+    }
+    asinc_colocar(e, posicion, f);
+}
+
+static inline void asinc_bajar(EjecutorAsincrono *e, int posicion) {
+    FuturoProducto *f = e->cola[posicion];
+    for (;;) {
+        int hijo = 2 * posicion + 1;
+        if (hijo >= e->en_cola) break;
+        if (hijo + 1 < e->en_cola && asinc_antes(e->cola[hijo + 1], e->cola[hijo])) hijo++;
+        if (!asinc_antes(e->cola[hijo], f)) break;
+        asinc_colocar(e, posicion, e->cola[hijo]);
+        posicion = hijo;
+    }
+    asinc_colocar(e, posicion, f);
+}
+
+// Con el mutex tomado
+static inline void asinc_quitar_de_cola(EjecutorAsincrono *e, FuturoProducto *f) {
+    int posicion = f->posicion;
+    FuturoProducto *ultimo = e->cola[--e->en_cola];
+    f->posicion = -1;
+    if (ultimo != f) {
+        asinc_colocar(e, posicion, ultimo);
+        asinc_subir(e, posicion);
+        asinc_bajar(e, ultimo->posicion);
+    }
+    pthread_cond_signal(&e->hay_espacio);
+}
+
+// Filas [fila_inicio, fila_fin) de C = A * B, por bloques como
+// multiplicar_matrices_openmp_optimizada
+static inline void asinc_multiplicar_banda(int **A, int **B, int **C, int n, int fila_inicio, int fila_fin) {
+    const int BLOCK_SIZE = 64;
+    for (int i = fila_inicio; i < fila_fin; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+    for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+        for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+            int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+            int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+            for (int i = fila_inicio; i < fila_fin; i++) {
+                for (int j = jj; j < j_end; j++) {
+                    int sum = C[i][j];
+                    for (int k = kk; k < k_end; k++) {
+                        sum += A[i][k] * B[k][j];
+                    }
+                    C[i][j] = sum;
+                }
+            }
+        }
+    }
+}
+
+static inline void *asinc_trabajador(void *arg) {
+    EjecutorAsincrono *e = (EjecutorAsincrono *)arg;
+    pthread_mutex_lock(&e->mutex);
+    for (;;) {
+        while (e->en_cola == 0 && !e->terminar) {
+            pthread_cond_wait(&e->hay_trabajo, &e->mutex);
+        }
+        if (e->en_cola == 0) break; // terminar y sin trabajo pendiente
+
+        FuturoProducto *f = e->cola[0];
+        int banda = f->siguiente_banda++;
+        if (f->siguiente_banda == f->bandas) asinc_quitar_de_cola(e, f);
+        if (f->estado == ASINC_PENDIENTE) {
+            f->estado = ASINC_EN_CURSO;
+            f->inicio = asinc_tiempo_s();
+        }
+        pthread_mutex_unlock(&e->mutex);
+
+        int fila_inicio = banda * ASINC_BANDA;
+        int fila_fin = (fila_inicio + ASINC_BANDA < f->n) ? fila_inicio + ASINC_BANDA : f->n;
+        kernel_fijo_t kernel_fijo = f->bandas == 1 ? buscar_kernel_fijo(f->n) : NULL;
+        if (kernel_fijo != NULL) {
+            kernel_fijo(f->A, f->B, f->C);
+        } else {
+            asinc_multiplicar_banda(f->A, f->B, f->C, f->n, fila_inicio, fila_fin);
+        }
+
+        pthread_mutex_lock(&e->mutex);
+        f->bandas_terminadas++;
+        // Terminado cuando no quedan bandas en curso ni por repartir
+        if (f->bandas_terminadas == f->siguiente_banda && (f->cancelado || f->siguiente_banda == f->bandas)) {
+            f->estado = f->cancelado ? ASINC_CANCELADO : ASINC_COMPLETADO;
+            f->fin = asinc_tiempo_s();
+            pthread_cond_broadcast(&e->terminado);
+        }
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return NULL;
+}
+
+static inline void asinc_crear(EjecutorAsincrono *e, int num_hilos, int capacidad_cola) {
+    memset(e, 0, sizeof(*e));
+    e->num_hilos = num_hilos;
+    e->capacidad = capacidad_cola;
+    e->cola = (FuturoProducto **)malloc(capacidad_cola * sizeof(FuturoProducto *));
+    e->hilos = (pthread_t *)malloc(num_hilos * sizeof(pthread_t));
+    if (e->cola == NULL || e->hilos == NULL) {
+        printf("Error: No se pudo asignar memoria para el ejecutor asíncrono\n");
+        exit(1);
+    }
+    pthread_mutex_init(&e->mutex, NULL);
+    pthread_cond_init(&e->hay_trabajo, NULL);
+    pthread_cond_init(&e->hay_espacio, NULL);
+    pthread_cond_init(&e->terminado, NULL);
+    for (int h = 0; h < num_hilos; h++) {
+        pthread_create(&e->hilos[h], NULL, asinc_trabajador, e);
+    }
+}
+
+static inline FuturoProducto *asinc_enviar_con_espera(EjecutorAsincrono *e, int **A, int **B, int **C,
+                                                      int n, int prioridad, int esperar_espacio) {
+    FuturoProducto *f = (FuturoProducto *)calloc(1, sizeof(FuturoProducto));
+    if (f == NULL) {
+        printf("Error: No se pudo asignar memoria para el futuro\n");
+        exit(1);
+    }
+    f->ejecutor = e;
+    f->A = A;
+    f->B = B;
+    f->C = C;
+    f->n = n;
+    f->prioridad = prioridad;
+    f->posicion = -1;
+    f->estado = ASINC_PENDIENTE;
+    f->envio = asinc_tiempo_s();
+
+    // Un producto vacío (n <= 0) no tiene bandas y ningún hilo lo terminaría:
+    // se devuelve completado sin pasar por la cola
+    if (n <= 0) {
+        f->estado = ASINC_COMPLETADO;
+        f->inicio = f->fin = f->envio;
+        return f;
+    }
+
+    pthread_mutex_lock(&e->mutex);
+    while (e->en_cola == e->capacidad && esperar_espacio) {
+        pthread_cond_wait(&e->hay_espacio, &e->mutex);
+    }
+    if (e->en_cola == e->capacidad) {
+        pthread_mutex_unlock(&e->mutex);
+        free(f);
+        return NULL;
+    }
+    f->secuencia = e->secuencia++;
+    f->bandas = (n + ASINC_BANDA - 1) / ASINC_BANDA;
+
+    asinc_colocar(e, e->en_cola++, f);
+    asinc_subir(e, f->posicion);
+    // Una banda por hilo despierto como mucho
+    if (f->bandas >= e->num_hilos) {
+        pthread_cond_broadcast(&e->hay_trabajo);
+    } else {
+        for (int b = 0; b < f->bandas; b++) pthread_cond_signal(&e->hay_trabajo);
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return f;
+}
+
+// Envía C = A * B; bloquea mientras la cola esté llena
+static inline FuturoProducto *asinc_enviar(EjecutorAsincrono *e, int **A, int **B, int **C, int n, int prioridad) {
+    return asinc_enviar_con_espera(e, A, B, C, n, prioridad, 1);
+}
+
+// Como asinc_enviar, pero devuelve NULL si la cola está llena
+static inline FuturoProducto *asinc_intentar_enviar(EjecutorAsincrono *e, int **A, int **B, int **C, int n, int prioridad) {
+    return asinc_enviar_con_espera(e, A, B, C, n, prioridad, 0);
+}
+
+static inline int asinc_terminado(estado_futuro_t estado) {
+    return estado == ASINC_COMPLETADO || estado == ASINC_CANCELADO;
+}
+
+// Estado actual sin bloquear
+static inline estado_futuro_t asinc_consultar(FuturoProducto *f) {
+    pthread_mutex_lock(&f->ejecutor->mutex);
+    estado_futuro_t estado = f->estado;
+    pthread_mutex_unlock(&f->ejecutor->mutex);
+    return estado;
+}
+
+static inline estado_futuro_t asinc_esperar(FuturoProducto *f) {
+    EjecutorAsincrono *e = f->ejecutor;
+    pthread_mutex_lock(&e->mutex);
+    while (!asinc_terminado(f->estado)) {
+        pthread_cond_wait(&e->terminado, &e->mutex);
+    }
+    estado_futuro_t estado = f->estado;
+    pthread_mutex_unlock(&e->mutex);
+    return estado;
+}
+
+// Devuelve 1 si alguna banda se quedó sin hacer (el producto termina
+// CANCELADO), 0 si era tarde: ya completado o con todas sus bandas repartidas
+static inline int asinc_cancelar(FuturoProducto *f) {
+    EjecutorAsincrono *e = f->ejecutor;
+    pthread_mutex_lock(&e->mutex);
+    if (!f->cancelado && f->estado != ASINC_COMPLETADO && f->siguiente_banda < f->bandas) {
+        f->cancelado = 1;
+        if (f->posicion >= 0) asinc_quitar_de_cola(e, f);
+        if (f->bandas_terminadas == f->siguiente_banda) {
+            f->estado = ASINC_CANCELADO; // ninguna banda en curso
+            f->fin = asinc_tiempo_s();
+            pthread_cond_broadcast(&e->terminado);
+        }
+    }
+    int cancelado = f->cancelado;
+    pthread_mutex_unlock(&e->mutex);
+    return cancelado;
+}
+
+// Sólo después de asinc_esperar (o de asinc_consultar terminado)
+static inline void asinc_liberar(FuturoProducto *f) {
+    free(f);
+}
+
+// Termina lo que quede en la cola y detiene los hilos
+static inline void asinc_destruir(EjecutorAsincrono *e) {
+    pthread_mutex_lock(&e->mutex);
+    e->terminar = 1;
+    pthread_cond_broadcast(&e->hay_trabajo);
+    pthread_mutex_unlock(&e->mutex);
+    for (int h = 0; h < e->num_hilos; h++) {
+        pthread_join(e->hilos[h], NULL);
+    }
+    pthread_mutex_destroy(&e->mutex);
+    pthread_cond_destroy(&e->hay_trabajo);
+    pthread_cond_destroy(&e->hay_espacio);
+    pthread_cond_destroy(&e->terminado);
+    free(e->cola);
+    free(e->hilos);
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <dirent.h>
+
+// Energía de los kernels con RAPL a través de powercap de Linux
+// (/sys/class/powercap/intel-rapl*). Se leen los contadores energy_uj de los
+// dominios de paquete (package-N) y de DRAM (dram, subdominio del paquete)
+// antes y después de cada multiplicación; con la diferencia y el tiempo de
+// pared se reportan julios, potencia media y GOP/J.
+//
+// Los contadores son de todo el socket, no del proceso: incluyen lo que
+// consuma el resto del sistema durante la medida. El dominio psys (toda la
+// plataforma) se ignora porque contiene al de paquete.
+//
+// Si no hay RAPL (máquinas virtuales, ARM, kernels sin powercap) o
+// energy_uj no es legible (desde Linux 5.10 sólo root puede leerlo), los
+// programas imprimen "Energía ...: no disponible" con el motivo y siguen.
+
+#ifndef ENERGIA_RUTA_POWERCAP
+#define ENERGIA_RUTA_POWERCAP "/sys/class/powercap"
+#endif
+#define ENERGIA_MAX_DOMINIOS 16
+
+typedef enum {
+    ENERGIA_PAQUETE,
+    ENERGIA_DRAM
+} tipo_dominio_energia_t;
+
+typedef struct {
+    char ruta[160];              // .../intel-rapl:0:0/energy_uj
+    tipo_dominio_energia_t tipo;
+    unsigned long long rango_uj; // max_energy_range_uj: el contador vuelve a 0 al llegar aquí
+} DominioEnergia;
+
+typedef struct {
+    unsigned long long uj[ENERGIA_MAX_DOMINIOS];
+    double segundos; // reloj monótono
+    int valida;
+} LecturaEnergia;
+
+// Energía consumida entre dos lecturas (o la suma de varias medidas)
+typedef struct {
+    double paquete_j;
+    double dram_j;
+    double segundos;
+    int hay_dram;
+    int valida;
+} MedidaEnergia;
+
+static struct {
+    int iniciado;
+    int num_dominios;
+    DominioEnergia dominios[ENERGIA_MAX_DOMINIOS];
+    char motivo[128]; // por qué no hay medida, si num_dominios == 0
+} energia_estado;
+
+static inline int energia_leer_entero(const char *ruta, unsigned long long *valor) {
+    FILE *f = fopen(ruta, "r");
+    if (f == NULL) return -errno;
+    int leidos = fscanf(f, "%llu", valor);
+    fclose(f);
+    return leidos == 1 ? 0 : -EIO;
+}
+
+static inline void energia_iniciar(void) {
+    if (energia_estado.iniciado) return;
+    energia_estado.iniciado = 1;
+
+    DIR *dir = opendir(ENERGIA_RUTA_POWERCAP);
+    if (dir == NULL) {
+        snprintf(energia_estado.motivo, sizeof(energia_estado.motivo), "no existe %s", ENERGIA_RUTA_POWERCAP);
+        return;
+    }
+    int sin_permiso = 0;
+    struct dirent *entrada;
+    while ((entrada = readdir(dir)) != NULL && energia_estado.num_dominios < ENERGIA_MAX_DOMINIOS) {
+        // intel-rapl:N (paquete) e intel-rapl:N:M (subdominios); el propio
+        // intel-rapl es el tipo de control, no un dominio
+        if (strncmp(entrada->d_name, "intel-rapl:", 11) != 0) continue;
+
+        char ruta[160], nombre[32] = "";
+        snprintf(ruta, sizeof(ruta), "%s/%.40s/name", ENERGIA_RUTA_POWERCAP, entrada->d_name);
+        FILE *f = fopen(ruta, "r");
+        if (f == NULL) continue;
+        int leido = fscanf(f, "%31s", nombre);
+        fclose(f);
+        if (leido != 1) continue;
+
+        DominioEnergia *d = &energia_estado.dominios[energia_estado.num_dominios];
+        if (strncmp(nombre, "package", 7) == 0) {
+            d->tipo = ENERGIA_PAQUETE;
+        } else if (strcmp(nombre, "dram") == 0) {
+            d->tipo = ENERGIA_DRAM;
+        } else {
+            continue; // core, uncore y psys están contenidos en otros dominios
+        }
+
+        snprintf(ruta, sizeof(ruta), "%s/%.40s/max_energy_range_uj", ENERGIA_RUTA_POWERCAP, entrada->d_name);
+        if (energia_leer_entero(ruta, &d->rango_uj) != 0) d->rango_uj = 0;
+        snprintf(d->ruta, sizeof(d->ruta), "%s/%.40s/energy_uj", ENERGIA_RUTA_POWERCAP, entrada->d_name);
+        unsigned long long prueba;
+        int error = energia_leer_entero(d->ruta, &prueba);
+        if (error == 0) {
+            energia_estado.num_dominios++;
+        } else if (error == -EACCES) {
+            sin_permiso = 1;
+        }
+    }
+    closedir(dir);
+
+    if (energia_estado.num_dominios == 0) {
+        snprintf(energia_estado.motivo, sizeof(energia_estado.motivo), "%s",
+                 sin_permiso ? "sin permiso de lectura en energy_uj (requiere root)"
+                             : "no hay dominios RAPL de paquete o DRAM");
+    }
+}
+
+static inline LecturaEnergia energia_leer(void) {
+    LecturaEnergia l;
+    memset(&l, 0, sizeof(l));
+    energia_iniciar();
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    l.segundos = ts.tv_sec + ts.tv_nsec / 1e9;
+    l.valida = energia_estado.num_dominios > 0;
+    for (int d = 0; d < energia_estado.num_dominios; d++) {
+        if (energia_leer_entero(energia_estado.dominios[d].ruta, &l.uj[d]) != 0) l.valida = 0;
+    }
+    return l;
+}
+
+// Diferencia entre dos lecturas. Corrige una vuelta del contador (con
+// cientos de vatios ocurre cada pocos minutos), no más de una; si el
+// contador retrocede y no se conoce max_energy_range_uj la medida no es válida
+static inline MedidaEnergia energia_diferencia(const LecturaEnergia *antes, const LecturaEnergia *despues) {
+    MedidaEnergia m = {0.0, 0.0, despues->segundos - antes->segundos, 0, antes->valida && despues->valida};
+    if (!m.valida) return m;
+    for (int d = 0; d < energia_estado.num_dominios; d++) {
+        unsigned long long delta = despues->uj[d] - antes->uj[d];
+        if (despues->uj[d] < antes->uj[d]) {
+            unsigned long long rango = energia_estado.dominios[d].rango_uj;
+            if (rango == 0 || antes->uj[d] > rango) {
+                m.valida = 0;
+                return m;
+            }
+            delta = rango - antes->uj[d] + despues->uj[d];
+        }
+        if (energia_estado.dominios[d].tipo == ENERGIA_DRAM) {
+            m.dram_j += delta / 1e6;
+            m.hay_dram = 1;
+        } else {
+            m.paquete_j += delta / 1e6;
+        }
+    }
+    return m;
+}
+
+// Acumula medidas de varias repeticiones del mismo kernel; el total empieza
+// en ENERGIA_MEDIDA_VACIA y deja de ser válido si alguna medida no lo es
+#define ENERGIA_MEDIDA_VACIA {0.0, 0.0, 0.0, 0, 1}
+
+static inline void energia_sumar(MedidaEnergia *total, const MedidaEnergia *m) {
+    total->paquete_j += m->paquete_j;
+    total->dram_j += m->dram_j;
+    total->segundos += m->segundos;
+    total->hay_dram = total->hay_dram || m->hay_dram;
+    total->valida = total->valida && m->valida;
+}
+
+// Imprime "Energía <etiqueta>: X J (paquete X J, DRAM X J), potencia media
+// X W, X GOP/J" para operaciones enteras (2 n^3 en un producto); benchmark.sh
+// extrae los valores de esta línea
+static inline void energia_reportar(const char *etiqueta, const MedidaEnergia *m, double operaciones) {
+    if (!m->valida) {
+        energia_iniciar();
+        printf("Energía %s: no disponible (%s)\n", etiqueta,
+               energia_estado.num_dominios == 0 ? energia_estado.motivo : "fallo al leer energy_uj o contador sin rango");
+        return;
+    }
+    double total = m->paquete_j + m->dram_j;
+    char dram[32];
+    if (m->hay_dram) {
+        snprintf(dram, sizeof(dram), "%.3f J", m->dram_j);
+    } else {
+        snprintf(dram, sizeof(dram), "no disponible");
+    }
+    printf("Energía %s: %.3f J (paquete %.3f J, DRAM %s), potencia media %.2f W, %.3f GOP/J\n", etiqueta,
+           total, m->paquete_j, dram, m->segundos > 0.0 ? total / m->segundos : 0.0,
+           total > 0.0 ? operaciones / total / 1e9 : 0.0);
+}
+
+#endif
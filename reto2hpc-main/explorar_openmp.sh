@@ -0,0 +1,98 @@
+#!/bin/bash
+
+# Script de Exploración de Planificación OpenMP
+# Ejecuta matrices_openmp --explorar con cada combinación de hilos,
+# OMP_PROC_BIND y OMP_PLACES (que OpenMP sólo lee al arrancar) y junta en un
+# CSV el tiempo y el desbalance de cada tipo de schedule, chunk y collapse
+
+# Colores para output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+# Configuración
+BUILD_DIR="build"
+RESULTS_DIR="results"
+TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RESULTS_FILE="$RESULTS_DIR/exploracion_openmp_$TIMESTAMP.csv"
+
+# Configuración de pruebas
+MATRIX_SIZE=${1:-512}
+MAX_THREADS=$(nproc)
+THREAD_SEQUENCE=(1 2 4 8 16 32 64)
+PROC_BIND_VALUES=(false close spread)
+PLACES_VALUES=(threads cores sockets)
+
+# Función para ejecutar una configuración y agregar sus filas al CSV
+run_exploration() {
+    local threads="$1"
+    local proc_bind="$2"
+    local places="$3"
+
+    echo -e "${YELLOW}Explorando $threads hilos, OMP_PROC_BIND=$proc_bind, OMP_PLACES=$places...${NC}"
+
+    local output
+    if [ "$proc_bind" = "false" ]; then
+        output=$(OMP_PROC_BIND=false timeout 900s "$BUILD_DIR/matrices_openmp" "$MATRIX_SIZE" "$threads" --explorar 2>&1)
+    else
+        output=$(OMP_PROC_BIND="$proc_bind" OMP_PLACES="$places" timeout 900s "$BUILD_DIR/matrices_openmp" "$MATRIX_SIZE" "$threads" --explorar 2>&1)
+    fi
+
+    local exit_code=$?
+
+    if [ $exit_code -eq 0 ]; then
+        echo "$output" | grep -E "^(simple|bloques)," >> "$RESULTS_FILE"
+        echo -e "${GREEN}✓ $(echo "$output" | grep "Mejor configuración")${NC}"
+    else
+        echo -e "${RED}ERROR: $threads hilos, OMP_PROC_BIND=$proc_bind, OMP_PLACES=$places (código: $exit_code)${NC}"
+    fi
+}
+
+# Función principal
+main() {
+    echo -e "${BLUE}=== EXPLORACIÓN DE PLANIFICACIÓN OPENMP ===${NC}"
+    echo "Tamaño de matriz: ${MATRIX_SIZE}x${MATRIX_SIZE}"
+    echo "Máximo de hilos disponibles: $MAX_THREADS"
+    echo "Resultados se guardarán en: $RESULTS_FILE"
+    echo ""
+
+    mkdir -p "$RESULTS_DIR"
+
+    if [ ! -f "$BUILD_DIR/matrices_openmp" ]; then
+        echo -e "${RED}Error: $BUILD_DIR/matrices_openmp no encontrado. Ejecuta 'make all' primero.${NC}"
+        exit 1
+    fi
+
+    # Crear archivo CSV con headers (los mismos que imprime --explorar)
+    echo "kernel,collapse,schedule,chunk,proc_bind,places,hilos,tiempo_s,ocupado_min_s,ocupado_max_s,desbalance" > "$RESULTS_FILE"
+
+    for threads in "${THREAD_SEQUENCE[@]}"; do
+        if [ "$threads" -le "$MAX_THREADS" ]; then
+            for proc_bind in "${PROC_BIND_VALUES[@]}"; do
+                if [ "$proc_bind" = "false" ]; then
+                    # Sin afinidad los lugares no se usan
+                    run_exploration "$threads" "$proc_bind" "sin definir"
+                else
+                    for places in "${PLACES_VALUES[@]}"; do
+                        run_exploration "$threads" "$proc_bind" "$places"
+                    done
+                fi
+            done
+        fi
+    done
+
+    # Mejor configuración por número de hilos (menor tiempo)
+    echo ""
+    echo -e "${GREEN}=== MEJOR CONFIGURACIÓN POR NÚMERO DE HILOS ===${NC}"
+    echo "kernel,collapse,schedule,chunk,proc_bind,places,hilos,tiempo_s,ocupado_min_s,ocupado_max_s,desbalance"
+    tail -n +2 "$RESULTS_FILE" | sort -t',' -k7,7n -k8,8g | awk -F',' '$7 != previo { print; previo = $7 }'
+
+    echo ""
+    echo -e "${GREEN}Exploración completada${NC}"
+    echo "Resultados en: $RESULTS_FILE"
+}
+
+# Ejecutar función principal
+main "$@"
@@ -0,0 +1,355 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/time.h>
+#include <omp.h>
+
+//gemv_matrices.c
+// Matriz por vector (GEMV, k = 1) y matriz por un lote pequeño de vectores
+// (n x k con k <= 16). Son operaciones limitadas por ancho de banda: cada
+// elemento de A se usa k veces, así que lo que importa es leer A una sola vez
+// y a la velocidad de la memoria, no el tiling de los kernels cuadrados.
+//   - A contigua y alineada a 64 bytes, recorrida por filas
+//   - las filas se reparten entre hilos con schedule(static); la misma
+//     partición inicializa A, así que con primer toque cada hilo lee páginas
+//     de su propio nodo NUMA
+//   - productos punto con #pragma omp simd sobre tramos de fila reutilizados
+//     para los k vectores; el tramo se elige según k y la L1 de /sys
+// El benchmark compara los GB/s de A con el ancho de banda de lectura medido
+// en la misma máquina. Esa comparación solo vale si A no cabe en la última
+// cache (LLC): si cabe, A se lee desde la cache y el porcentaje no se muestra.
+
+#define MAX_VECTORES_LOTE 16
+#define BYTES_L1_POR_DEFECTO 32768
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Matriz filas x columnas con la interfaz int** de crear_matriz pero con los
+// datos contiguos y sin tocar: las páginas se asignan en primer_toque
+int **crear_matriz_contigua(int filas, int columnas) {
+    int **matriz = (int **)malloc(filas * sizeof(int *));
+    size_t bytes = ((size_t)filas * columnas * sizeof(int) + 63) & ~(size_t)63;
+    int *datos = (int *)aligned_alloc(64, bytes);
+    if (matriz == NULL || datos == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+    for (int i = 0; i < filas; i++) {
+        matriz[i] = datos + (size_t)i * columnas;
+    }
+    return matriz;
+}
+
+void liberar_matriz_contigua(int **matriz) {
+    free(matriz[0]);
+    free(matriz);
+}
+
+// Tamaño en bytes de la cache de datos o unificada de la CPU 0 del nivel
+// pedido (0: la de mayor nivel, la LLC); 0 si /sys no lo informa
+size_t tamano_cache(int nivel) {
+    size_t mejor = 0;
+    int mejor_nivel = 0;
+    for (int indice = 0; indice < 16; indice++) {
+        char ruta[128], tipo[32] = "", unidad = 'K';
+        int nivel_cache = 0;
+        size_t tamano = 0;
+        FILE *f;
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/level", indice);
+        if ((f = fopen(ruta, "r")) == NULL) break;
+        if (fscanf(f, "%d", &nivel_cache) != 1) nivel_cache = 0;
+        fclose(f);
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/type", indice);
+        if ((f = fopen(ruta, "r")) != NULL) {
+            if (fscanf(f, "%31s", tipo) != 1) tipo[0] = '\0';
+            fclose(f);
+        }
+        snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu0/cache/index%d/size", indice);
+        if ((f = fopen(ruta, "r")) != NULL) {
+            if (fscanf(f, "%zu%c", &tamano, &unidad) < 1) tamano = 0;
+            fclose(f);
+        }
+        if (strcmp(tipo, "Instruction") == 0 || tamano == 0) continue;
+        tamano *= unidad == 'M' ? 1024 * 1024 : unidad == 'G' ? 1024UL * 1024 * 1024 : 1024;
+        if (nivel == 0 ? nivel_cache > mejor_nivel : nivel_cache == nivel) {
+            mejor = tamano;
+            mejor_nivel = nivel_cache;
+        }
+    }
+    return mejor;
+}
+
+// Enteros por tramo de fila en gemm_lote: el tramo de a y los de los hasta
+// cuatro vectores que lo recorren a la vez ocupan media L1, así el tramo de
+// a sigue en L1 para el siguiente grupo de cuatro vectores
+int tramo_fila(size_t bytes_l1, int k) {
+    int vectores = k < 4 ? k : 4;
+    int tramo = (int)(bytes_l1 / 2 / (sizeof(int) * (1 + vectores))) & ~15;
+    return tramo >= 16 ? tramo : 16;
+}
+
+// Inicializa A con la misma partición por filas que usan los kernels
+void primer_toque(int **A, int filas, int columnas) {
+    unsigned int base = time(NULL);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < filas; i++) {
+        unsigned int seed = base + i;
+        for (int j = 0; j < columnas; j++) {
+            A[i][j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// y = A x
+void gemv(int **A, const int *x, int *y, int filas, int columnas) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < filas; i++) {
+        const int *a = A[i];
+        int sum = 0;
+        #pragma omp simd reduction(+:sum)
+        for (int j = 0; j < columnas; j++) {
+            sum += a[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+// Y = A X con X guardada traspuesta (Xt es k x columnas, Yt es k x filas):
+// cada tramo de la fila i se lee de memoria una vez y se reutiliza desde L1
+// para los k productos punto
+void gemm_lote(int **A, int **Xt, int **Yt, int filas, int columnas, int k, int tramo) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < filas; i++) {
+        const int *a = A[i];
+        int acumulado[MAX_VECTORES_LOTE] = {0};
+        for (int jj = 0; jj < columnas; jj += tramo) {
+            int j_end = (jj + tramo < columnas) ? jj + tramo : columnas;
+            // De cuatro en cuatro vectores: cada carga de a sirve a cuatro sumas
+            int c = 0;
+            for (; c + 4 <= k; c += 4) {
+                const int *x0 = Xt[c], *x1 = Xt[c + 1], *x2 = Xt[c + 2], *x3 = Xt[c + 3];
+                int s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+                #pragma omp simd reduction(+:s0, s1, s2, s3)
+                for (int j = jj; j < j_end; j++) {
+                    s0 += a[j] * x0[j];
+                    s1 += a[j] * x1[j];
+                    s2 += a[j] * x2[j];
+                    s3 += a[j] * x3[j];
+                }
+                acumulado[c] += s0;
+                acumulado[c + 1] += s1;
+                acumulado[c + 2] += s2;
+                acumulado[c + 3] += s3;
+            }
+            for (; c < k; c++) {
+                const int *x = Xt[c];
+                int sum = 0;
+                #pragma omp simd reduction(+:sum)
+                for (int j = jj; j < j_end; j++) {
+                    sum += a[j] * x[j];
+                }
+                acumulado[c] += sum;
+            }
+        }
+        for (int c = 0; c < k; c++) {
+            Yt[c][i] = acumulado[c];
+        }
+    }
+}
+
+// Referencia secuencial sin SIMD ni tramos
+void gemm_lote_referencia(int **A, int **Xt, int **Yt, int filas, int columnas, int k) {
+    for (int c = 0; c < k; c++) {
+        for (int i = 0; i < filas; i++) {
+            int sum = 0;
+            for (int j = 0; j < columnas; j++) {
+                sum += A[i][j] * Xt[c][j];
+            }
+            Yt[c][i] = sum;
+        }
+    }
+}
+
+// Ancho de banda de lectura (GB/s): suma en paralelo de un arreglo mucho
+// mayor que la cache, inicializado con la misma partición; mejor de varias.
+// La suma se compara con la fórmula cerrada para verificar la lectura
+double medir_ancho_de_banda(size_t bytes, int repeticiones, int *correcto) {
+    size_t elementos = bytes / sizeof(long);
+    long *datos = (long *)aligned_alloc(64, elementos * sizeof(long));
+    if (datos == NULL) {
+        printf("Error: No se pudo asignar memoria para medir el ancho de banda\n");
+        exit(1);
+    }
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < elementos; e++) {
+        datos[e] = (long)e;
+    }
+
+    double mejor = 0.0;
+    long esperada = (long)elementos * (long)(elementos - 1) / 2;
+    *correcto = 1;
+    for (int r = 0; r < repeticiones; r++) {
+        double inicio = get_time_microseconds();
+        long suma = 0;
+        #pragma omp parallel for schedule(static) reduction(+:suma)
+        for (size_t e = 0; e < elementos; e++) {
+            suma += datos[e];
+        }
+        double segundos = (get_time_microseconds() - inicio) / 1e6;
+        if (suma != esperada) *correcto = 0;
+        double gbs = elementos * sizeof(long) / segundos / 1e9;
+        if (gbs > mejor) mejor = gbs;
+    }
+    free(datos);
+    return mejor;
+}
+
+int contar_nodos_numa() {
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (dir == NULL) return 1;
+    int nodos = 0;
+    struct dirent *entrada;
+    while ((entrada = readdir(dir)) != NULL) {
+        if (strncmp(entrada->d_name, "node", 4) == 0 && entrada->d_name[4] >= '0' && entrada->d_name[4] <= '9') {
+            nodos++;
+        }
+    }
+    closedir(dir);
+    return nodos > 0 ? nodos : 1;
+}
+
+const char *nombre_proc_bind() {
+    switch (omp_get_proc_bind()) {
+        case omp_proc_bind_true:   return "true";
+        case omp_proc_bind_master: return "master";
+        case omp_proc_bind_close:  return "close";
+        case omp_proc_bind_spread: return "spread";
+        default:                   return "false (sin fijar; usar OMP_PROC_BIND=spread en NUMA)";
+    }
+}
+
+typedef struct {
+    double segundos; // mejor tiempo de una llamada
+    double gbs;      // bytes de A, X e Y movidos por segundo
+    int correcto;
+} ResultadoLote;
+
+ResultadoLote medir_lote(int **A, int n, int k, int tramo, int repeticiones) {
+    int **Xt = crear_matriz_contigua(k, n);
+    int **Yt = crear_matriz_contigua(k, n);
+    int **Yt_ref = crear_matriz_contigua(k, n);
+    unsigned int seed = time(NULL) + k;
+    for (int c = 0; c < k; c++) {
+        for (int j = 0; j < n; j++) Xt[c][j] = rand_r(&seed) % 100;
+    }
+
+    ResultadoLote r = {0.0, 0.0, 1};
+    for (int rep = 0; rep < repeticiones; rep++) {
+        double inicio = get_time_microseconds();
+        if (k == 1) {
+            gemv(A, Xt[0], Yt[0], n, n);
+        } else {
+            gemm_lote(A, Xt, Yt, n, n, k, tramo);
+        }
+        double segundos = (get_time_microseconds() - inicio) / 1e6;
+        if (rep == 0 || segundos < r.segundos) r.segundos = segundos;
+    }
+    double bytes = (double)n * n * sizeof(int) + 2.0 * k * n * sizeof(int);
+    r.gbs = bytes / r.segundos / 1e9;
+
+    gemm_lote_referencia(A, Xt, Yt_ref, n, n, k);
+    for (int c = 0; c < k && r.correcto; c++) {
+        r.correcto = memcmp(Yt[c], Yt_ref[c], n * sizeof(int)) == 0;
+    }
+
+    liberar_matriz_contigua(Xt);
+    liberar_matriz_contigua(Yt);
+    liberar_matriz_contigua(Yt_ref);
+    return r;
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    int barrido = argc == 4 && strcmp(argv[3], "--barrido") == 0;
+    if (argc < 3 || argc > 4) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [k|--barrido]\n", argv[0]);
+        printf("Ejemplo: %s 8192 4 8\n", argv[0]);
+        return 1;
+    }
+
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    int k = (argc == 4 && !barrido) ? atoi(argv[3]) : 1;
+    if (n <= 0 || num_hilos <= 0 || k <= 0 || k > MAX_VECTORES_LOTE) {
+        printf("Error: El tamaño de matriz y número de hilos deben ser positivos y 1 <= k <= %d\n",
+               MAX_VECTORES_LOTE);
+        return 1;
+    }
+    omp_set_num_threads(num_hilos);
+
+    printf("=== MATRIZ POR VECTOR Y POR LOTES PEQUEÑOS ===\n");
+    printf("Tamaño de matriz: %dx%d (%.1f MB)\n", n, n, (double)n * n * sizeof(int) / (1024 * 1024));
+    printf("Número de hilos: %d\n", num_hilos);
+    printf("Nodos NUMA: %d\n", contar_nodos_numa());
+    printf("OMP_PROC_BIND: %s\n", nombre_proc_bind());
+    size_t bytes_A = (size_t)n * n * sizeof(int);
+    size_t bytes_l1 = tamano_cache(1), bytes_llc = tamano_cache(0);
+    if (bytes_l1 == 0) bytes_l1 = BYTES_L1_POR_DEFECTO;
+    printf("L1 de datos: %zu kB, LLC: %.1f MB%s\n", bytes_l1 / 1024, (double)bytes_llc / (1024 * 1024),
+           bytes_llc == 0 ? " (desconocida)" : "");
+
+    // Ancho de banda de referencia con al menos 256 MB leídos y al menos el
+    // doble de la LLC, para que se lea de memoria
+    size_t bytes_medicion = bytes_A;
+    if (bytes_medicion < 256UL * 1024 * 1024) bytes_medicion = 256UL * 1024 * 1024;
+    if (bytes_medicion < 2 * bytes_llc) bytes_medicion = 2 * bytes_llc;
+    int correcto_ancho;
+    double ancho_de_banda = medir_ancho_de_banda(bytes_medicion, 5, &correcto_ancho);
+    printf("Ancho de banda de lectura medido: %.2f GB/s\n\n", ancho_de_banda);
+
+    double start_gen = get_time_microseconds();
+    int **A = crear_matriz_contigua(n, n);
+    primer_toque(A, n, n);
+    printf("Tiempo de generación de A (primer toque por filas): %.2f microsegundos\n\n",
+           get_time_microseconds() - start_gen);
+
+    int lotes[] = {1, 2, 4, 8, 16};
+    int num_lotes = barrido ? 5 : 1;
+    if (!barrido) lotes[0] = k;
+
+    // Con A dentro de la LLC los GB/s salen de la cache y superan al medido
+    int a_en_llc = bytes_llc > 0 && bytes_A <= bytes_llc;
+    int correcto = 1;
+    printf("%4s %8s %14s %10s %14s %14s\n", "k", "Tramo", "Tiempo (ms)", "GB/s", "% del medido", "GFLOP/s");
+    for (int l = 0; l < num_lotes; l++) {
+        int tramo = tramo_fila(bytes_l1, lotes[l]);
+        ResultadoLote r = medir_lote(A, n, lotes[l], tramo, 10);
+        double gflops = 2.0 * n * n * lotes[l] / r.segundos / 1e9;
+        printf("%4d %8d %14.3f %10.2f ", lotes[l], lotes[l] == 1 ? n : tramo, r.segundos * 1000, r.gbs);
+        if (a_en_llc) {
+            printf("%14s", "-");
+        } else {
+            printf("%13.1f%%", 100.0 * r.gbs / ancho_de_banda);
+        }
+        printf(" %14.2f%s\n", gflops, r.correcto ? "" : "  INCORRECTO");
+        correcto &= r.correcto;
+    }
+    if (a_en_llc) {
+        printf("\nA (%.1f MB) cabe en la LLC: el %% del ancho de banda medido solo tiene sentido con A mayor que la LLC\n",
+               (double)bytes_A / (1024 * 1024));
+    }
+    printf("\nVerificación contra la referencia secuencial: %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("Verificación de la suma del ancho de banda: %s\n", correcto_ancho ? "correcta" : "INCORRECTA");
+    correcto &= correcto_ancho;
+
+    liberar_matriz_contigua(A);
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,315 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+// Recálculo incremental de C = A * B cuando cambian unas pocas filas o
+// columnas de A o de B. El estado guarda A, B y C (int**, no son propiedad
+// del estado) y un mapa de teselas de C sucias. Invariante: toda tesela
+// limpia vale A * B con los A y B actuales.
+//
+// Cambiar k filas o columnas es sumar a C una corrección de rango k, que se
+// aplica al momento y sólo sobre las teselas limpias que toca:
+//   - filas R de A:     C[R, :] += dA[R, :] * B      (teselas de esas filas)
+//   - columnas J de B:  C[:, J] += A * dB[:, J]      (teselas de esas columnas)
+//   - columnas J de A:  C += dA[:, J] * B[J, :]      (todas)
+//   - filas K de B:     C += A[:, K] * dB[K, :]      (todas)
+// Cada una cuesta 2 n^2 k operaciones en lugar de 2 n^3. Con k > n /
+// INCR_RANGO_MAX la corrección deja de compensar frente al kernel por
+// bloques: en su lugar se marcan sucias las teselas afectadas e
+// incremental_aplicar las recalcula (64 x 64 x n por tesela).
+//
+// Las correcciones usan el otro operando tal como está en ese momento, así
+// que las actualizaciones se pueden encadenar en cualquier orden antes de
+// llamar a incremental_aplicar.
+
+#define INCR_TESELA 64
+#define INCR_RANGO_MAX 8 // rango k máximo de una corrección: n / INCR_RANGO_MAX
+
+typedef struct {
+    int **A;
+    int **B;
+    int **C;
+    int n;
+    int teselas;          // teselas por lado
+    unsigned char *sucia; // ti * teselas + tj
+    int num_sucias;
+    int *lista;           // teselas sucias pendientes, para repartirlas entre hilos
+    long corregidas;      // teselas limpias tocadas por correcciones (estadística)
+} EstadoIncremental;
+
+static inline void incremental_marcar(EstadoIncremental *inc, int ti, int tj) {
+    unsigned char *s = &inc->sucia[ti * inc->teselas + tj];
+    if (!*s) {
+        *s = 1;
+        inc->lista[inc->num_sucias++] = ti * inc->teselas + tj;
+    }
+}
+
+static inline void incremental_marcar_todo(EstadoIncremental *inc) {
+    for (int ti = 0; ti < inc->teselas; ti++) {
+        for (int tj = 0; tj < inc->teselas; tj++) {
+            incremental_marcar(inc, ti, tj);
+        }
+    }
+}
+
+// Recalcula las teselas sucias con el kernel por bloques de
+// multiplicacion_openmp.c. Devuelve cuántas teselas recalculó
+static inline int incremental_aplicar(EstadoIncremental *inc) {
+    int **A = inc->A;
+    int **B = inc->B;
+    int **C = inc->C;
+    const int n = inc->n;
+    const int T = INCR_TESELA;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < inc->num_sucias; s++) {
+        int ii = inc->lista[s] / inc->teselas * T;
+        int jj = inc->lista[s] % inc->teselas * T;
+        int i_end = (ii + T < n) ? ii + T : n;
+        int j_end = (jj + T < n) ? jj + T : n;
+        for (int i = ii; i < i_end; i++) {
+            memset(C[i] + jj, 0, (j_end - jj) * sizeof(int));
+        }
+        for (int kk = 0; kk < n; kk += T) {
+            int k_end = (kk + T < n) ? kk + T : n;
+            for (int i = ii; i < i_end; i++) {
+                for (int j = jj; j < j_end; j++) {
+                    int sum = C[i][j];
+                    for (int k = kk; k < k_end; k++) {
+                        sum += A[i][k] * B[k][j];
+                    }
+                    C[i][j] = sum;
+                }
+            }
+        }
+    }
+
+    int recalculadas = inc->num_sucias;
+    for (int s = 0; s < inc->num_sucias; s++) {
+        inc->sucia[inc->lista[s]] = 0;
+    }
+    inc->num_sucias = 0;
+    return recalculadas;
+}
+
+// Crea el estado y calcula C = A * B completo
+static inline void incremental_crear(EstadoIncremental *inc, int **A, int **B, int **C, int n) {
+    inc->A = A;
+    inc->B = B;
+    inc->C = C;
+    inc->n = n;
+    inc->teselas = (n + INCR_TESELA - 1) / INCR_TESELA;
+    inc->sucia = (unsigned char *)calloc((size_t)inc->teselas * inc->teselas, 1);
+    inc->lista = (int *)malloc((size_t)inc->teselas * inc->teselas * sizeof(int));
+    if (inc->sucia == NULL || inc->lista == NULL) {
+        printf("Error: No se pudo asignar memoria para el mapa de teselas\n");
+        exit(1);
+    }
+    inc->num_sucias = 0;
+    inc->corregidas = 0;
+    incremental_marcar_todo(inc);
+    incremental_aplicar(inc);
+}
+
+static inline void incremental_destruir(EstadoIncremental *inc) {
+    free(inc->sucia);
+    free(inc->lista);
+    inc->sucia = NULL;
+    inc->lista = NULL;
+}
+
+// C += U * V sobre las teselas limpias, con U de n x k (U[i * k + r]) y V
+// de k filas de n. Las teselas sucias se saltan: se recalculan después
+static inline void incremental_corregir(EstadoIncremental *inc, const int *U, const int *const *V, int k) {
+    int **C = inc->C;
+    const int n = inc->n;
+    const int T = INCR_TESELA;
+    long corregidas = 0;
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1) reduction(+:corregidas)
+    for (int ii = 0; ii < n; ii += T) {
+        for (int jj = 0; jj < n; jj += T) {
+            if (inc->sucia[ii / T * inc->teselas + jj / T]) continue;
+            corregidas++;
+            int i_end = (ii + T < n) ? ii + T : n;
+            int j_end = (jj + T < n) ? jj + T : n;
+            for (int i = ii; i < i_end; i++) {
+                int *fila_c = C[i];
+                const int *u = U + (size_t)i * k;
+                for (int r = 0; r < k; r++) {
+                    const int uir = u[r];
+                    if (uir == 0) continue;
+                    const int *v = V[r];
+                    for (int j = jj; j < j_end; j++) {
+                        fila_c[j] += uir * v[j];
+                    }
+                }
+            }
+        }
+    }
+    inc->corregidas += corregidas;
+}
+
+// Reemplaza las filas filas[0..k) de A por nuevas[0..k) (n enteros cada
+// una): C[R, :] += dA[R, :] * B, recorriendo B una sola vez
+static inline void incremental_actualizar_filas_A(EstadoIncremental *inc, const int *filas, int k, const int *const *nuevas) {
+    const int n = inc->n;
+    const int T = INCR_TESELA;
+    if ((long)k * INCR_RANGO_MAX > n) {
+        for (int r = 0; r < k; r++) {
+            memcpy(inc->A[filas[r]], nuevas[r], n * sizeof(int));
+            for (int tj = 0; tj < inc->teselas; tj++) incremental_marcar(inc, filas[r] / T, tj);
+        }
+        return;
+    }
+
+    int *dA = (int *)malloc((size_t)k * n * sizeof(int));
+    if (dA == NULL) {
+        printf("Error: No se pudo asignar memoria para la corrección de rango %d\n", k);
+        exit(1);
+    }
+    for (int r = 0; r < k; r++) {
+        int *d = dA + (size_t)r * n;
+        for (int j = 0; j < n; j++) d[j] = nuevas[r][j] - inc->A[filas[r]][j];
+        memcpy(inc->A[filas[r]], nuevas[r], n * sizeof(int));
+    }
+
+    int **B = inc->B;
+    int **C = inc->C;
+    long corregidas = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:corregidas)
+    for (int jj = 0; jj < n; jj += T) {
+        int j_end = (jj + T < n) ? jj + T : n;
+        for (int r = 0; r < k; r++) corregidas += !inc->sucia[filas[r] / T * inc->teselas + jj / T];
+        for (int kk = 0; kk < n; kk++) {
+            const int *fila_b = B[kk];
+            for (int r = 0; r < k; r++) {
+                const int d = dA[(size_t)r * n + kk];
+                if (d == 0 || inc->sucia[filas[r] / T * inc->teselas + jj / T]) continue;
+                int *fila_c = C[filas[r]];
+                for (int j = jj; j < j_end; j++) {
+                    fila_c[j] += d * fila_b[j];
+                }
+            }
+        }
+    }
+    inc->corregidas += corregidas;
+    free(dA);
+}
+
+// Reemplaza las columnas columnas[0..k) de B por nuevas[0..k) (n enteros,
+// de arriba abajo): C[:, J] += A * dB[:, J], un producto punto por elemento
+static inline void incremental_actualizar_columnas_B(EstadoIncremental *inc, const int *columnas, int k, const int *const *nuevas) {
+    const int n = inc->n;
+    const int T = INCR_TESELA;
+    if ((long)k * INCR_RANGO_MAX > n) {
+        for (int r = 0; r < k; r++) {
+            for (int i = 0; i < n; i++) inc->B[i][columnas[r]] = nuevas[r][i];
+            for (int ti = 0; ti < inc->teselas; ti++) incremental_marcar(inc, ti, columnas[r] / T);
+        }
+        return;
+    }
+
+    int *dB = (int *)malloc((size_t)k * n * sizeof(int)); // columna r contigua
+    if (dB == NULL) {
+        printf("Error: No se pudo asignar memoria para la corrección de rango %d\n", k);
+        exit(1);
+    }
+    for (int r = 0; r < k; r++) {
+        int *d = dB + (size_t)r * n;
+        for (int i = 0; i < n; i++) {
+            d[i] = nuevas[r][i] - inc->B[i][columnas[r]];
+            inc->B[i][columnas[r]] = nuevas[r][i];
+        }
+    }
+
+    int **A = inc->A;
+    int **C = inc->C;
+    long corregidas = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:corregidas)
+    for (int ii = 0; ii < n; ii += T) {
+        int i_end = (ii + T < n) ? ii + T : n;
+        for (int r = 0; r < k; r++) {
+            if (inc->sucia[ii / T * inc->teselas + columnas[r] / T]) continue;
+            corregidas++;
+            const int *d = dB + (size_t)r * n;
+            for (int i = ii; i < i_end; i++) {
+                const int *fila_a = A[i];
+                int sum = 0;
+                for (int kk = 0; kk < n; kk++) {
+                    sum += fila_a[kk] * d[kk];
+                }
+                C[i][columnas[r]] += sum;
+            }
+        }
+    }
+    inc->corregidas += corregidas;
+    free(dB);
+}
+
+// Reemplaza las columnas columnas[0..k) de A: corrección C += dA * B[J, :]
+static inline void incremental_actualizar_columnas_A(EstadoIncremental *inc, const int *columnas, int k, const int *const *nuevas) {
+    const int n = inc->n;
+    if ((long)k * INCR_RANGO_MAX > n) {
+        for (int r = 0; r < k; r++) {
+            for (int i = 0; i < n; i++) inc->A[i][columnas[r]] = nuevas[r][i];
+        }
+        incremental_marcar_todo(inc);
+        return;
+    }
+
+    int *U = (int *)malloc((size_t)n * k * sizeof(int));
+    const int **V = (const int **)malloc(k * sizeof(int *));
+    if (U == NULL || V == NULL) {
+        printf("Error: No se pudo asignar memoria para la corrección de rango %d\n", k);
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int r = 0; r < k; r++) {
+            U[(size_t)i * k + r] = nuevas[r][i] - inc->A[i][columnas[r]];
+            inc->A[i][columnas[r]] = nuevas[r][i];
+        }
+    }
+    for (int r = 0; r < k; r++) V[r] = inc->B[columnas[r]];
+    incremental_corregir(inc, U, V, k);
+    free(U);
+    free(V);
+}
+
+// Reemplaza las filas filas[0..k) de B: corrección C += A[:, K] * dB
+static inline void incremental_actualizar_filas_B(EstadoIncremental *inc, const int *filas, int k, const int *const *nuevas) {
+    const int n = inc->n;
+    if ((long)k * INCR_RANGO_MAX > n) {
+        for (int r = 0; r < k; r++) memcpy(inc->B[filas[r]], nuevas[r], n * sizeof(int));
+        incremental_marcar_todo(inc);
+        return;
+    }
+
+    int *U = (int *)malloc((size_t)n * k * sizeof(int));
+    int *dB = (int *)malloc((size_t)k * n * sizeof(int));
+    const int **V = (const int **)malloc(k * sizeof(int *));
+    if (U == NULL || dB == NULL || V == NULL) {
+        printf("Error: No se pudo asignar memoria para la corrección de rango %d\n", k);
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int r = 0; r < k; r++) U[(size_t)i * k + r] = inc->A[i][filas[r]];
+    }
+    for (int r = 0; r < k; r++) {
+        int *d = dB + (size_t)r * n;
+        for (int j = 0; j < n; j++) d[j] = nuevas[r][j] - inc->B[filas[r]][j];
+        memcpy(inc->B[filas[r]], nuevas[r], n * sizeof(int));
+        V[r] = d;
+    }
+    incremental_corregir(inc, U, V, k);
+    free(U);
+    free(dB);
+    free(V);
+}
+
+#endif
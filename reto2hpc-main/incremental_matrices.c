@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <sys/time.h>
+#include <omp.h>
+#include "incremental.h"
+
+//incremental_matrices.c
+// Cuánto cuesta mantener C = A * B al día cuando entre una ejecución y la
+// siguiente cambian k filas o columnas de A o de B, frente a recalcular el
+// producto completo con el kernel por bloques de multiplicacion_openmp.c.
+// Cada escenario parte de un C correcto, aplica la actualización con
+// incremental.h y compara el resultado con el recálculo completo.
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Función para crear una matriz cuadrada dinámicamente
+int **crear_matriz(int n) {
+    int **matriz = (int **)malloc(n * sizeof(int *));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        matriz[i] = (int *)malloc(n * sizeof(int));
+        if (matriz[i] == NULL) {
+            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(1);
+        }
+    }
+
+    return matriz;
+}
+
+// Función para liberar memoria de una matriz
+void liberar_matriz(int **matriz, int n) {
+    for (int i = 0; i < n; i++) {
+        free(matriz[i]);
+    }
+    free(matriz);
+}
+
+// Generación paralela con semilla por fila
+void generar_matriz_aleatoria_paralela(int **matriz, int n, unsigned int base) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int seed = base + i * 7919;
+        for (int j = 0; j < n; j++) {
+            matriz[i][j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// El kernel por bloques de multiplicacion_openmp.c: el recálculo completo
+void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[i][k] * B[k][j];
+                        }
+                        C[i][j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int matrices_iguales(int **X, int **Y, int n) {
+    int iguales = 1;
+    #pragma omp parallel for schedule(static) reduction(&&:iguales)
+    for (int i = 0; i < n; i++) {
+        iguales = iguales && memcmp(X[i], Y[i], n * sizeof(int)) == 0;
+    }
+    return iguales;
+}
+
+typedef enum {
+    CAMBIO_FILAS_A,
+    CAMBIO_COLUMNAS_B,
+    CAMBIO_COLUMNAS_A,
+    CAMBIO_FILAS_B,
+    CAMBIO_MIXTO,
+    CAMBIO_NUM_ESCENARIOS
+} escenario_t;
+
+const char *nombre_escenario(escenario_t e) {
+    switch (e) {
+        case CAMBIO_FILAS_A:    return "filas de A";
+        case CAMBIO_COLUMNAS_B: return "columnas de B";
+        case CAMBIO_COLUMNAS_A: return "columnas de A";
+        case CAMBIO_FILAS_B:    return "filas de B";
+        case CAMBIO_MIXTO:      return "mixto";
+        default:                return "desconocido";
+    }
+}
+
+// k índices distintos en [0, n) y k vectores nuevos de n valores
+void generar_cambio(int *indices, int **nuevos, int k, int n, unsigned int *semilla) {
+    for (int r = 0; r < k; r++) {
+        int repetido;
+        do {
+            indices[r] = rand_r(semilla) % n;
+            repetido = 0;
+            for (int s = 0; s < r; s++) repetido |= indices[s] == indices[r];
+        } while (repetido);
+        for (int j = 0; j < n; j++) {
+            nuevos[r][j] = rand_r(semilla) % 100;
+        }
+    }
+}
+
+// Aplica la actualización del escenario; el mixto reparte k entre los
+// cuatro tipos (al menos 1 de cada uno)
+void actualizar(EstadoIncremental *inc, escenario_t e, int *indices, int **nuevos, int k, unsigned int *semilla) {
+    const int *const *v = (const int *const *)nuevos;
+    int n = inc->n;
+    switch (e) {
+        case CAMBIO_FILAS_A:
+            generar_cambio(indices, nuevos, k, n, semilla);
+            incremental_actualizar_filas_A(inc, indices, k, v);
+            break;
+        case CAMBIO_COLUMNAS_B:
+            generar_cambio(indices, nuevos, k, n, semilla);
+            incremental_actualizar_columnas_B(inc, indices, k, v);
+            break;
+        case CAMBIO_COLUMNAS_A:
+            generar_cambio(indices, nuevos, k, n, semilla);
+            incremental_actualizar_columnas_A(inc, indices, k, v);
+            break;
+        case CAMBIO_FILAS_B:
+            generar_cambio(indices, nuevos, k, n, semilla);
+            incremental_actualizar_filas_B(inc, indices, k, v);
+            break;
+        default: {
+            int parte = k / 4 > 0 ? k / 4 : 1;
+            for (int t = CAMBIO_FILAS_A; t <= CAMBIO_FILAS_B; t++) {
+                actualizar(inc, (escenario_t)t, indices, nuevos, parte, semilla);
+            }
+            break;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    if (argc < 3 || argc > 4) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [filas_o_columnas_cambiadas]\n", argv[0]);
+        printf("Ejemplo: %s 2048 4 8\n", argv[0]);
+        return 1;
+    }
+
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    int k = argc == 4 ? atoi(argv[3]) : 8;
+    if (n <= 0 || num_hilos <= 0 || k <= 0 || k > n) {
+        printf("Error: El tamaño de matriz y número de hilos deben ser positivos y 0 < k <= n\n");
+        return 1;
+    }
+    omp_set_num_threads(num_hilos);
+
+    printf("=== RECÁLCULO INCREMENTAL DE C ===\n");
+    printf("Tamaño de matriz: %dx%d\n", n, n);
+    printf("Número de hilos: %d\n", num_hilos);
+    printf("Cambios por actualización: k = %d filas o columnas\n", k);
+    printf("Tesela: %dx%d; correcciones de rango k hasta k = n/%d = %d\n\n", INCR_TESELA, INCR_TESELA,
+           INCR_RANGO_MAX, n / INCR_RANGO_MAX);
+
+    int **A = crear_matriz(n);
+    int **B = crear_matriz(n);
+    int **C = crear_matriz(n);
+    int **C_ref = crear_matriz(n);
+    int **nuevos = (int **)malloc(k * sizeof(int *)); // k filas o columnas de n valores
+    for (int r = 0; r < k; r++) {
+        nuevos[r] = (int *)malloc(n * sizeof(int));
+        if (nuevos[r] == NULL) {
+            printf("Error: No se pudo asignar memoria para los cambios\n");
+            exit(1);
+        }
+    }
+    int *indices = (int *)malloc(k * sizeof(int));
+    generar_matriz_aleatoria_paralela(A, n, (unsigned int)time(NULL));
+    generar_matriz_aleatoria_paralela(B, n, (unsigned int)time(NULL) + 1);
+
+    EstadoIncremental inc;
+    double inicio = get_time_microseconds();
+    incremental_crear(&inc, A, B, C, n);
+    printf("Cálculo inicial de C: %.6f segundos\n\n", (get_time_microseconds() - inicio) / 1e6);
+
+    printf("%-14s %10s %12s %14s %14s %10s %12s\n", "Cambio", "Corregidas", "Recalculadas", "Incremental",
+           "Completo", "Speedup", "Verificación");
+
+    unsigned int semilla = 2024;
+    int correcto = 1;
+    for (int e = 0; e < CAMBIO_NUM_ESCENARIOS; e++) {
+        inc.corregidas = 0;
+        inicio = get_time_microseconds();
+        actualizar(&inc, (escenario_t)e, indices, nuevos, k, &semilla);
+        int recalculadas = incremental_aplicar(&inc);
+        double tiempo_incremental = (get_time_microseconds() - inicio) / 1e6;
+
+        inicio = get_time_microseconds();
+        multiplicar_matrices_openmp_optimizada(A, B, C_ref, n);
+        double tiempo_completo = (get_time_microseconds() - inicio) / 1e6;
+
+        int iguales = matrices_iguales(C, C_ref, n);
+        correcto &= iguales;
+        printf("%-14s %10ld %12d %12.6f s %12.6f s %9.2fx %12s\n", nombre_escenario((escenario_t)e),
+               inc.corregidas, recalculadas, tiempo_incremental, tiempo_completo,
+               tiempo_completo / tiempo_incremental, iguales ? "correcta" : "INCORRECTA");
+    }
+    printf("\nDe %d teselas de C: corregidas con rango k (una vez por fila o columna que\n",
+           inc.teselas * inc.teselas);
+    printf("cambia) y recalculadas con el kernel por bloques (con k > n/%d)\n\n", INCR_RANGO_MAX);
+
+    incremental_destruir(&inc);
+    liberar_matriz(A, n);
+    liberar_matriz(B, n);
+    liberar_matriz(C, n);
+    liberar_matriz(C_ref, n);
+    for (int r = 0; r < k; r++) free(nuevos[r]);
+    free(nuevos);
+    free(indices);
+
+    printf("Verificación contra el recálculo completo: %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#ifndef KERNELS_FIJOS_H
+#define KERNELS_FIJOS_H
+
+#include <stddef.h>
+#include <string.h>
+
+// Kernels de tamaño fijo para matrices pequeñas (n = 4, 8, 16, 32, 64). Con
+// n <= 64 los kernels por bloques gastan la mayor parte del tiempo en los
+// límites i_end / j_end / k_end, en un bloque más grande que la matriz y,
+// en las versiones OpenMP, en abrir la región paralela. Aquí n es un
+// parámetro de plantilla: los bucles tienen límites constantes, el bucle
+// sobre k se desenrolla por completo hasta n = 16 y la fila de C se acumula
+// en vectores de 8 enteros que quedan en registros (64 enteros = 8 registros
+// AVX2). Frente al kernel por bloques son del orden de 10 veces más rápidos
+// en n = 8 ... 64.
+//
+// Los programas buscan el kernel en una tabla con buscar_kernel_fijo(n) y,
+// si existe, lo llaman directamente en lugar de la maquinaria de bloques.
+// La suma es sin signo: desborda igual que int en complemento a 2 pero sin
+// comportamiento indefinido (las potencias de cadena_matrices.c desbordan).
+//
+// Sólo se compila como C++ (los programas se compilan con g++).
+
+#define KERNEL_FIJO_MAX 64
+
+typedef void (*kernel_fijo_t)(const int *const *A, const int *const *B, int *const *C);
+
+template <int N>
+static void multiplicar_fijo(const int *const *A, const int *const *B, int *const *C) {
+    // Vectores de hasta 8 enteros (extensión de GCC); memcpy compila a
+    // cargas sin alinear, las filas de int** no tienen alineación garantizada
+    const int ANCHO = N < 8 ? N : 8;
+    const int VECTORES = N / ANCHO;
+    typedef unsigned int vector_t __attribute__((vector_size(ANCHO * sizeof(unsigned int))));
+
+    for (int i = 0; i < N; i++) {
+        const int *a = A[i];
+        vector_t c[VECTORES];
+        for (int v = 0; v < VECTORES; v++) c[v] = vector_t{};
+#pragma GCC unroll 16
+        for (int k = 0; k < N; k++) {
+            const vector_t aik = vector_t{} + (unsigned int)a[k];
+            const int *b = B[k];
+#pragma GCC unroll 8
+            for (int v = 0; v < VECTORES; v++) {
+                vector_t bv;
+                memcpy(&bv, b + v * ANCHO, sizeof(bv));
+                c[v] += aik * bv;
+            }
+        }
+        int *fila_c = C[i];
+        for (int v = 0; v < VECTORES; v++) memcpy(fila_c + v * ANCHO, &c[v], sizeof(c[v]));
+    }
+}
+
+typedef struct {
+    int n;
+    kernel_fijo_t kernel;
+} EntradaKernelFijo;
+
+static const EntradaKernelFijo tabla_kernels_fijos[] = {
+    {4, multiplicar_fijo<4>},
+    {8, multiplicar_fijo<8>},
+    {16, multiplicar_fijo<16>},
+    {32, multiplicar_fijo<32>},
+    {64, multiplicar_fijo<64>},
+};
+
+// Kernel para matrices n x n, o NULL si n no tiene uno
+static inline kernel_fijo_t buscar_kernel_fijo(int n) {
+    if (n > KERNEL_FIJO_MAX) return NULL;
+    for (size_t e = 0; e < sizeof(tabla_kernels_fijos) / sizeof(tabla_kernels_fijos[0]); e++) {
+        if (tabla_kernels_fijos[e].n == n) return tabla_kernels_fijos[e].kernel;
+    }
+    return NULL;
+}
+
+// Versión para matrices contiguas (fila i en M + i * n). Devuelve 0 si n no
+// tiene kernel fijo y el llamador debe usar el kernel general
+static inline int multiplicar_fijo_contiguas(const int *A, const int *B, int *C, int n) {
+    kernel_fijo_t kernel = buscar_kernel_fijo(n);
+    if (kernel == NULL) return 0;
+    const int *filas_a[KERNEL_FIJO_MAX];
+    const int *filas_b[KERNEL_FIJO_MAX];
+    int *filas_c[KERNEL_FIJO_MAX];
+    for (int i = 0; i < n; i++) {
+        filas_a[i] = A + (size_t)i * n;
+        filas_b[i] = B + (size_t)i * n;
+        filas_c[i] = C + (size_t)i * n;
+    }
+    kernel(filas_a, filas_b, filas_c);
+    return 1;
+}
+
+#endif
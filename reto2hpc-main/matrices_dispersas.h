@@ -0,0 +1,360 @@
+#ifndef MATRICES_DISPERSAS_H
+#define MATRICES_DISPERSAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+// Matrices dispersas en formato CSR (filas comprimidas) y BCSR (CSR de
+// bloques densos de BCSR_BLOQUE x BCSR_BLOQUE), con productos paralelizados
+// por filas como multiplicar_matrices_openmp_simple:
+//   - SpMM:   dispersa x densa  -> densa
+//   - SpGEMM: dispersa x dispersa -> dispersa (Gustavson, dos pasadas)
+//
+// medir_densidad recorre una matriz densa una sola vez y devuelve la fracción
+// de elementos no nulos y el llenado medio de los bloques no vacíos; con eso
+// elegir_ruta_producto decide entre la ruta densa por bloques y las dispersas.
+
+#define BCSR_BLOQUE 4
+
+// Densidad de A a partir de la cual se usa la ruta densa. Con n = 800 la SpMM
+// en CSR (que recorre B por filas) fue más rápida que la densa por bloques
+// en todo el rango medido; por encima de la mitad de no nulos se prefiere la
+// densa igualmente porque no convierte y CSR ocupa el doble que la matriz
+#define UMBRAL_DENSIDAD 0.5
+// Densidad máxima de A, B y C (estimada) para multiplicar todo en CSR
+#define UMBRAL_DENSIDAD_SPGEMM 0.10
+// Llenado mínimo de los bloques para preferir BCSR sobre CSR
+#define UMBRAL_LLENADO_BCSR 0.5
+
+typedef struct {
+    int filas;
+    int columnas;
+    int nnz;
+    int *inicio_fila; // filas + 1 elementos
+    int *columna;
+    int *valor;
+} MatrizCSR;
+
+typedef struct {
+    int filas;
+    int columnas;
+    int filas_bloque;    // ceil(filas / BCSR_BLOQUE)
+    int num_bloques;
+    int *inicio_fila;    // filas_bloque + 1 elementos
+    int *columna_bloque;
+    int *valores;        // num_bloques bloques de BCSR_BLOQUE^2, por filas
+} MatrizBCSR;
+
+typedef enum {
+    RUTA_DENSA,
+    RUTA_SPMM_CSR,
+    RUTA_SPMM_BCSR,
+    RUTA_SPGEMM
+} ruta_producto_t;
+
+typedef struct {
+    double densidad;        // no nulos / (filas * columnas)
+    double llenado_bloques; // no nulos / (bloques no vacíos * BCSR_BLOQUE^2)
+} DensidadMatriz;
+
+static inline const char *nombre_ruta_producto(ruta_producto_t ruta) {
+    switch (ruta) {
+        case RUTA_SPMM_CSR:  return "SpMM (CSR x densa)";
+        case RUTA_SPMM_BCSR: return "SpMM (BCSR x densa)";
+        case RUTA_SPGEMM:    return "SpGEMM (CSR x CSR)";
+        default:             return "densa por bloques";
+    }
+}
+
+static inline void *dispersa_reservar(size_t bytes) {
+    void *p = malloc(bytes > 0 ? bytes : 1);
+    if (p == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz dispersa\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Una pasada por la matriz: no nulos totales y bloques BCSR no vacíos
+static inline DensidadMatriz medir_densidad(int **M, int n) {
+    long no_nulos = 0, bloques_no_vacios = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:no_nulos, bloques_no_vacios)
+    for (int ii = 0; ii < n; ii += BCSR_BLOQUE) {
+        int i_end = (ii + BCSR_BLOQUE < n) ? ii + BCSR_BLOQUE : n;
+        for (int jj = 0; jj < n; jj += BCSR_BLOQUE) {
+            int j_end = (jj + BCSR_BLOQUE < n) ? jj + BCSR_BLOQUE : n;
+            int en_bloque = 0;
+            for (int i = ii; i < i_end; i++) {
+                for (int j = jj; j < j_end; j++) {
+                    en_bloque += M[i][j] != 0;
+                }
+            }
+            no_nulos += en_bloque;
+            bloques_no_vacios += en_bloque > 0;
+        }
+    }
+
+    DensidadMatriz d;
+    d.densidad = (double)no_nulos / ((double)n * n);
+    d.llenado_bloques = bloques_no_vacios > 0
+        ? (double)no_nulos / ((double)bloques_no_vacios * BCSR_BLOQUE * BCSR_BLOQUE) : 0.0;
+    return d;
+}
+
+// Densa si A no es dispersa; SpGEMM si A y B lo son y el producto también lo
+// será; si no, SpMM con B densa, en BCSR cuando los bloques de A están llenos.
+// La densidad esperada de C para posiciones aleatorias es 1 - exp(-n·dA·dB)
+static inline ruta_producto_t elegir_ruta_producto(DensidadMatriz a, DensidadMatriz b, int n) {
+    if (a.densidad >= UMBRAL_DENSIDAD) return RUTA_DENSA;
+    double densidad_c = 1.0 - exp(-(double)n * a.densidad * b.densidad);
+    if (a.densidad < UMBRAL_DENSIDAD_SPGEMM && b.densidad < UMBRAL_DENSIDAD_SPGEMM &&
+        densidad_c < UMBRAL_DENSIDAD_SPGEMM) {
+        return RUTA_SPGEMM;
+    }
+    return a.llenado_bloques >= UMBRAL_LLENADO_BCSR ? RUTA_SPMM_BCSR : RUTA_SPMM_CSR;
+}
+
+// ---------------------------------------------------------------------------
+// Conversión y liberación
+// ---------------------------------------------------------------------------
+
+static inline MatrizCSR csr_desde_densa(int **M, int n) {
+    MatrizCSR A;
+    A.filas = n;
+    A.columnas = n;
+    A.inicio_fila = (int *)dispersa_reservar((n + 1) * sizeof(int));
+
+    // Contar por fila en paralelo, acumular, y llenar cada fila en su sitio
+    A.inicio_fila[0] = 0;
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        int cuenta = 0;
+        for (int j = 0; j < n; j++) cuenta += M[i][j] != 0;
+        A.inicio_fila[i + 1] = cuenta;
+    }
+    for (int i = 0; i < n; i++) A.inicio_fila[i + 1] += A.inicio_fila[i];
+    A.nnz = A.inicio_fila[n];
+    A.columna = (int *)dispersa_reservar((size_t)A.nnz * sizeof(int));
+    A.valor = (int *)dispersa_reservar((size_t)A.nnz * sizeof(int));
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        int p = A.inicio_fila[i];
+        for (int j = 0; j < n; j++) {
+            if (M[i][j] != 0) {
+                A.columna[p] = j;
+                A.valor[p] = M[i][j];
+                p++;
+            }
+        }
+    }
+    return A;
+}
+
+// Los bloques del borde se rellenan con ceros
+static inline MatrizBCSR bcsr_desde_densa(int **M, int n) {
+    const int R = BCSR_BLOQUE;
+    MatrizBCSR A;
+    A.filas = n;
+    A.columnas = n;
+    A.filas_bloque = (n + R - 1) / R;
+    int columnas_bloque = A.filas_bloque;
+    A.inicio_fila = (int *)dispersa_reservar((A.filas_bloque + 1) * sizeof(int));
+
+    A.inicio_fila[0] = 0;
+    #pragma omp parallel for schedule(static)
+    for (int bi = 0; bi < A.filas_bloque; bi++) {
+        int i_end = (bi * R + R < n) ? bi * R + R : n;
+        int cuenta = 0;
+        for (int bj = 0; bj < columnas_bloque; bj++) {
+            int j_end = (bj * R + R < n) ? bj * R + R : n;
+            int no_vacio = 0;
+            for (int i = bi * R; i < i_end && !no_vacio; i++) {
+                for (int j = bj * R; j < j_end; j++) no_vacio |= M[i][j] != 0;
+            }
+            cuenta += no_vacio;
+        }
+        A.inicio_fila[bi + 1] = cuenta;
+    }
+    for (int bi = 0; bi < A.filas_bloque; bi++) A.inicio_fila[bi + 1] += A.inicio_fila[bi];
+    A.num_bloques = A.inicio_fila[A.filas_bloque];
+    A.columna_bloque = (int *)dispersa_reservar((size_t)A.num_bloques * sizeof(int));
+    A.valores = (int *)dispersa_reservar((size_t)A.num_bloques * R * R * sizeof(int));
+
+    #pragma omp parallel for schedule(static)
+    for (int bi = 0; bi < A.filas_bloque; bi++) {
+        int i_end = (bi * R + R < n) ? bi * R + R : n;
+        int p = A.inicio_fila[bi];
+        for (int bj = 0; bj < columnas_bloque; bj++) {
+            int j_end = (bj * R + R < n) ? bj * R + R : n;
+            int bloque[BCSR_BLOQUE * BCSR_BLOQUE];
+            int no_vacio = 0;
+            for (int r = 0; r < R; r++) {
+                for (int c = 0; c < R; c++) {
+                    int i = bi * R + r, j = bj * R + c;
+                    bloque[r * R + c] = (i < i_end && j < j_end) ? M[i][j] : 0;
+                    no_vacio |= bloque[r * R + c] != 0;
+                }
+            }
+            if (no_vacio) {
+                memcpy(&A.valores[(size_t)p * R * R], bloque, sizeof(bloque));
+                A.columna_bloque[p] = bj;
+                p++;
+            }
+        }
+    }
+    return A;
+}
+
+static inline void csr_a_densa(const MatrizCSR *A, int **M) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < A->filas; i++) {
+        memset(M[i], 0, A->columnas * sizeof(int));
+        for (int p = A->inicio_fila[i]; p < A->inicio_fila[i + 1]; p++) {
+            M[i][A->columna[p]] = A->valor[p];
+        }
+    }
+}
+
+static inline void liberar_csr(MatrizCSR *A) {
+    free(A->inicio_fila);
+    free(A->columna);
+    free(A->valor);
+}
+
+static inline void liberar_bcsr(MatrizBCSR *A) {
+    free(A->inicio_fila);
+    free(A->columna_bloque);
+    free(A->valores);
+}
+
+// ---------------------------------------------------------------------------
+// Productos
+// ---------------------------------------------------------------------------
+
+// C = A * B con A en CSR y B, C densas: cada no nulo A[i][k] suma
+// A[i][k] * B[k][:] a la fila i de C (bucle interno contiguo y vectorizable)
+static inline void multiplicar_spmm_csr(const MatrizCSR *A, int **B, int **C) {
+    int p_columnas = A->columnas;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < A->filas; i++) {
+        int *c = C[i];
+        memset(c, 0, p_columnas * sizeof(int));
+        for (int p = A->inicio_fila[i]; p < A->inicio_fila[i + 1]; p++) {
+            int v = A->valor[p];
+            const int *b = B[A->columna[p]];
+            for (int j = 0; j < p_columnas; j++) {
+                c[j] += v * b[j];
+            }
+        }
+    }
+}
+
+// Igual que multiplicar_spmm_csr, pero un índice de columna por bloque
+static inline void multiplicar_spmm_bcsr(const MatrizBCSR *A, int **B, int **C) {
+    const int R = BCSR_BLOQUE;
+    int n = A->columnas;
+
+    #pragma omp parallel for schedule(static)
+    for (int bi = 0; bi < A->filas_bloque; bi++) {
+        int filas_validas = (bi * R + R < A->filas) ? R : A->filas - bi * R;
+        for (int r = 0; r < filas_validas; r++) {
+            memset(C[bi * R + r], 0, n * sizeof(int));
+        }
+        for (int p = A->inicio_fila[bi]; p < A->inicio_fila[bi + 1]; p++) {
+            const int *bloque = &A->valores[(size_t)p * R * R];
+            int k0 = A->columna_bloque[p] * R;
+            int columnas_validas = (k0 + R < A->columnas) ? R : A->columnas - k0;
+            for (int r = 0; r < filas_validas; r++) {
+                int *c = C[bi * R + r];
+                for (int k = 0; k < columnas_validas; k++) {
+                    int v = bloque[r * R + k];
+                    if (v == 0) continue;
+                    const int *b = B[k0 + k];
+                    for (int j = 0; j < n; j++) {
+                        c[j] += v * b[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C = A * B con las tres en CSR (algoritmo de Gustavson). Una pasada
+// simbólica cuenta los no nulos de cada fila de C y una numérica los calcula
+// con un acumulador denso por hilo; las columnas de cada fila de C quedan en
+// el orden en que aparecen, no ordenadas
+static inline MatrizCSR multiplicar_spgemm(const MatrizCSR *A, const MatrizCSR *B) {
+    MatrizCSR C;
+    C.filas = A->filas;
+    C.columnas = B->columnas;
+    C.inicio_fila = (int *)dispersa_reservar((C.filas + 1) * sizeof(int));
+    C.inicio_fila[0] = 0;
+
+    #pragma omp parallel
+    {
+        int *marca = (int *)dispersa_reservar(C.columnas * sizeof(int));
+        for (int j = 0; j < C.columnas; j++) marca[j] = -1;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < A->filas; i++) {
+            int cuenta = 0;
+            for (int p = A->inicio_fila[i]; p < A->inicio_fila[i + 1]; p++) {
+                int k = A->columna[p];
+                for (int q = B->inicio_fila[k]; q < B->inicio_fila[k + 1]; q++) {
+                    int j = B->columna[q];
+                    if (marca[j] != i) {
+                        marca[j] = i;
+                        cuenta++;
+                    }
+                }
+            }
+            C.inicio_fila[i + 1] = cuenta;
+        }
+        free(marca);
+    }
+
+    for (int i = 0; i < C.filas; i++) C.inicio_fila[i + 1] += C.inicio_fila[i];
+    C.nnz = C.inicio_fila[C.filas];
+    C.columna = (int *)dispersa_reservar((size_t)C.nnz * sizeof(int));
+    C.valor = (int *)dispersa_reservar((size_t)C.nnz * sizeof(int));
+
+    #pragma omp parallel
+    {
+        int *acumulador = (int *)dispersa_reservar(C.columnas * sizeof(int));
+        int *posicion = (int *)dispersa_reservar(C.columnas * sizeof(int));
+        for (int j = 0; j < C.columnas; j++) posicion[j] = -1;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < A->filas; i++) {
+            int inicio = C.inicio_fila[i];
+            int siguiente = inicio;
+            for (int p = A->inicio_fila[i]; p < A->inicio_fila[i + 1]; p++) {
+                int k = A->columna[p];
+                int v = A->valor[p];
+                for (int q = B->inicio_fila[k]; q < B->inicio_fila[k + 1]; q++) {
+                    int j = B->columna[q];
+                    if (posicion[j] < inicio) {
+                        posicion[j] = siguiente;
+                        C.columna[siguiente++] = j;
+                        acumulador[j] = 0;
+                    }
+                    acumulador[j] += v * B->valor[q];
+                }
+            }
+            for (int p = inicio; p < siguiente; p++) {
+                C.valor[p] = acumulador[C.columna[p]];
+            }
+        }
+        free(acumulador);
+        free(posicion);
+    }
+    return C;
+}
+
+#endif
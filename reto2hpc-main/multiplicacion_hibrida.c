@@ -0,0 +1,549 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <omp.h>
+#include "topologia.h"
+
+//multiplicacion_hibrida.c
+// Backend jerárquico: un proceso por nodo NUMA o socket (topologia.h) y, en
+// cada uno, un equipo OpenMP fijado a las CPUs de ese dominio.
+//   - A y C (contiguas) y las copias de B viven en memoria compartida creada
+//     antes del fork, pero sin tocar: cada proceso inicializa con sus hilos
+//     ya fijados sus paneles de filas de A y de C y su propia copia de B, así
+//     que con primer toque esas páginas quedan en su nodo (como
+//     gemv_matrices.c). Los generadores usan la semilla por fila de los demás
+//     programas, por eso cada dominio puede crear sus filas sin leer las de
+//     otro
+//   - planificador de dos niveles: C se divide en teselas de PANEL_FILAS x
+//     TESELA_COLUMNAS; cada dominio recibe un rango contiguo de paneles,
+//     proporcional a sus hilos, y sus hilos reclaman teselas de ese rango
+//     con un contador atómico en memoria compartida. Un hilo sin teselas
+//     propias roba de la cola de otro dominio (lee A y escribe C remotas,
+//     pero B siempre de la copia local)
+// Lo que cruza de un socket a otro es solo lo robado. Se compara con el
+// mismo kernel y planificador en un solo proceso con una sola copia de B
+// ("plano") y con el kernel por bloques de multiplicacion_openmp.c, que
+// además sirve de referencia para verificar.
+//
+// Las rondas se coordinan con dos futex compartidos y no con una barrera de
+// procesos: el padre espera con timeout y revisa con waitpid si algún
+// dominio murió (OOM, afinidad inválida, una señal), como pool_esperar de
+// pool_procesos.h; en ese caso mata a los demás y termina con error.
+
+#define PANEL_FILAS 64      // filas de C por tesela: el panel de A queda en L2
+#define TESELA_COLUMNAS 256 // columnas de C por tesela
+#define BLOQUE_K 64
+
+// Cola de teselas de un dominio, en su propia línea de cache
+typedef struct {
+    uint32_t siguiente __attribute__((aligned(64))); // próxima tesela sin reclamar
+    uint32_t inicio;
+    uint32_t fin;
+    uint32_t propias;  // teselas calculadas por el dominio dueño
+    uint32_t robadas;  // teselas de este dominio calculadas por otro
+} __attribute__((aligned(64))) ColaDominio;
+
+typedef struct {
+    uint32_t ronda __attribute__((aligned(64)));      // futex de los hijos: última ronda habilitada
+    uint32_t terminados __attribute__((aligned(64))); // futex del padre: avisos de fin de los dominios
+    ColaDominio cola[TOPO_MAX_DOMINIOS];
+} ControlHibrido;
+
+static inline long futex_hibrido(uint32_t *direccion, int operacion, uint32_t valor, const struct timespec *timeout) {
+    // Sin FUTEX_PRIVATE_FLAG: la palabra vive en memoria compartida entre procesos
+    return syscall(SYS_futex, direccion, operacion, valor, timeout, NULL, 0);
+}
+
+// Hijo: espera a que el padre habilite la ronda
+void esperar_ronda(ControlHibrido *control, uint32_t ronda) {
+    uint32_t actual;
+    while ((actual = __atomic_load_n(&control->ronda, __ATOMIC_ACQUIRE)) < ronda) {
+        futex_hibrido(&control->ronda, FUTEX_WAIT, actual, NULL);
+    }
+}
+
+// Hijo: avisa al padre que terminó la ronda (o la inicialización)
+void avisar_fin(ControlHibrido *control) {
+    __atomic_fetch_add(&control->terminados, 1, __ATOMIC_RELEASE);
+    futex_hibrido(&control->terminados, FUTEX_WAKE, 1, NULL);
+}
+
+// Padre: habilita la ronda en todos los dominios
+void habilitar_ronda(ControlHibrido *control, uint32_t ronda) {
+    __atomic_store_n(&control->ronda, ronda, __ATOMIC_RELEASE);
+    futex_hibrido(&control->ronda, FUTEX_WAKE, INT32_MAX, NULL);
+}
+
+// Padre: espera a que lleguen objetivo avisos, revisando cada 10 ms si algún
+// dominio murió; los hijos no salen hasta que el padre lo permite, así que
+// cualquier hijo terminado antes es un fallo. Devuelve ese dominio o -1
+int esperar_dominios(ControlHibrido *control, uint32_t objetivo, const pid_t *pids, int num_dominios, int *estado) {
+    struct timespec timeout = {0, 10 * 1000 * 1000};
+    for (;;) {
+        uint32_t terminados = __atomic_load_n(&control->terminados, __ATOMIC_ACQUIRE);
+        if (terminados >= objetivo) return -1;
+        futex_hibrido(&control->terminados, FUTEX_WAIT, terminados, &timeout);
+        for (int d = 0; d < num_dominios; d++) {
+            if (waitpid(pids[d], estado, WNOHANG) == pids[d]) return d;
+        }
+    }
+}
+
+// Padre: un dominio murió; se matan los demás y el programa termina
+void abortar_dominios(const pid_t *pids, int num_dominios, int muerto, int estado) {
+    if (WIFSIGNALED(estado)) {
+        printf("Error: El proceso del dominio %d murió por la señal %d\n", muerto, WTERMSIG(estado));
+    } else {
+        printf("Error: El proceso del dominio %d terminó antes de tiempo (código %d)\n", muerto, WEXITSTATUS(estado));
+    }
+    for (int d = 0; d < num_dominios; d++) {
+        if (d == muerto) continue;
+        kill(pids[d], SIGKILL);
+        waitpid(pids[d], NULL, 0);
+    }
+    exit(1);
+}
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Función para crear una matriz cuadrada dinámicamente
+int **crear_matriz(int n) {
+    int **matriz = (int **)malloc(n * sizeof(int *));
+    if (matriz == NULL) {
+        printf("Error: No se pudo asignar memoria para la matriz\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) {
+        matriz[i] = (int *)malloc(n * sizeof(int));
+        if (matriz[i] == NULL) {
+            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(1);
+        }
+    }
+
+    return matriz;
+}
+
+// Función para liberar memoria de una matriz
+void liberar_matriz(int **matriz, int n) {
+    for (int i = 0; i < n; i++) {
+        free(matriz[i]);
+    }
+    free(matriz);
+}
+
+// Generación paralela con semilla por fila
+void generar_matriz_aleatoria_paralela(int **matriz, int n, unsigned int base) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int seed = base + i * 7919;
+        for (int j = 0; j < n; j++) {
+            matriz[i][j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// Las mismas filas que generar_matriz_aleatoria_paralela, en una matriz contigua
+void generar_filas(int *M, int n, int fila_inicio, int fila_fin, unsigned int base) {
+    #pragma omp for schedule(static)
+    for (int i = fila_inicio; i < fila_fin; i++) {
+        unsigned int seed = base + i * 7919;
+        for (int j = 0; j < n; j++) {
+            M[(size_t)i * n + j] = rand_r(&seed) % 100;
+        }
+    }
+}
+
+// El kernel por bloques de multiplicacion_openmp.c: referencia y verificación
+void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[i][j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[i][k] * B[k][j];
+                        }
+                        C[i][j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Una tesela de C = A * B con A, B y C contiguas, orden i-k-j por bloques de k
+void calcular_tesela(const int *A, const int *B, int *C, int n, int tesela, int bloques_columna) {
+    int i0 = (tesela / bloques_columna) * PANEL_FILAS;
+    int j0 = (tesela % bloques_columna) * TESELA_COLUMNAS;
+    int i_end = (i0 + PANEL_FILAS < n) ? i0 + PANEL_FILAS : n;
+    int j_end = (j0 + TESELA_COLUMNAS < n) ? j0 + TESELA_COLUMNAS : n;
+
+    for (int i = i0; i < i_end; i++) {
+        memset(C + (size_t)i * n + j0, 0, (j_end - j0) * sizeof(int));
+    }
+    for (int kk = 0; kk < n; kk += BLOQUE_K) {
+        int k_end = (kk + BLOQUE_K < n) ? kk + BLOQUE_K : n;
+        for (int i = i0; i < i_end; i++) {
+            int *c = C + (size_t)i * n;
+            const int *a = A + (size_t)i * n;
+            for (int k = kk; k < k_end; k++) {
+                const int aik = a[k];
+                const int *b = B + (size_t)k * n;
+                for (int j = j0; j < j_end; j++) {
+                    c[j] += aik * b[j];
+                }
+            }
+        }
+    }
+}
+
+// Reclama una tesela: primero de la cola propia, después de las demás en
+// orden. Devuelve -1 cuando no queda ninguna
+int reclamar_tesela(ControlHibrido *control, int dominio, int num_dominios, int *duena) {
+    for (int v = 0; v < num_dominios; v++) {
+        int d = (dominio + v) % num_dominios;
+        ColaDominio *cola = &control->cola[d];
+        if (__atomic_load_n(&cola->siguiente, __ATOMIC_RELAXED) >= cola->fin) continue;
+        uint32_t tesela = __atomic_fetch_add(&cola->siguiente, 1, __ATOMIC_RELAXED);
+        if (tesela < cola->fin) {
+            *duena = d;
+            return (int)tesela;
+        }
+    }
+    return -1;
+}
+
+// Los hilos del dominio calculan teselas hasta vaciar todas las colas
+void calcular_dominio(ControlHibrido *control, int dominio, int num_dominios, const int *A, const int *B, int *C,
+                      int n, int bloques_columna) {
+    #pragma omp parallel
+    {
+        uint32_t propias = 0;
+        uint32_t robadas[TOPO_MAX_DOMINIOS] = {0};
+        int duena;
+        int tesela;
+        while ((tesela = reclamar_tesela(control, dominio, num_dominios, &duena)) >= 0) {
+            calcular_tesela(A, B, C, n, tesela, bloques_columna);
+            if (duena == dominio) propias++; else robadas[duena]++;
+        }
+        __atomic_fetch_add(&control->cola[dominio].propias, propias, __ATOMIC_RELAXED);
+        for (int d = 0; d < num_dominios; d++) {
+            if (robadas[d] > 0) __atomic_fetch_add(&control->cola[d].robadas, robadas[d], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Reparte paneles y teselas entre dominios en proporción a sus hilos
+void repartir_paneles(ControlHibrido *control, const int *hilos, int num_dominios, int n, int bloques_columna,
+                      int *panel_inicio, int *panel_fin) {
+    int paneles = (n + PANEL_FILAS - 1) / PANEL_FILAS;
+    int total = 0, acumulado = 0;
+    for (int d = 0; d < num_dominios; d++) total += hilos[d];
+    for (int d = 0; d < num_dominios; d++) {
+        panel_inicio[d] = (int)((long)paneles * acumulado / total);
+        acumulado += hilos[d];
+        panel_fin[d] = (int)((long)paneles * acumulado / total);
+        control->cola[d].inicio = panel_inicio[d] * bloques_columna;
+        control->cola[d].fin = panel_fin[d] * bloques_columna;
+    }
+}
+
+void reiniciar_colas(ControlHibrido *control, int num_dominios) {
+    for (int d = 0; d < num_dominios; d++) {
+        control->cola[d].siguiente = control->cola[d].inicio;
+    }
+}
+
+// Proceso de un dominio: fija sus hilos, toca sus datos y atiende las
+// rondas 1..repeticiones; sale cuando el padre habilita la ronda siguiente
+void proceso_dominio(const Topologia *topo, int dominio, int hilos, ControlHibrido *control, int *A, int *B_local,
+                     int *C, int n, int fila_inicio, int fila_fin, int bloques_columna, int repeticiones,
+                     unsigned int semilla_A, unsigned int semilla_B) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL); // sin padre nadie habilita las rondas
+    // Sin fijar el dominio sigue siendo correcto, pero sus hilos pueden
+    // migrar a CPUs lejos de sus datos: se avisa y se continúa
+    int error = topologia_fijar_proceso(topo, dominio);
+    if (error != 0) {
+        printf("Aviso: No se pudo fijar el proceso del dominio %d a sus CPUs (%s)\n", dominio, strerror(error));
+    }
+    omp_set_num_threads(hilos);
+
+    int hilos_sin_fijar = 0, error_hilo = 0;
+    #pragma omp parallel
+    {
+        // Los hilos de libgomp se reutilizan entre regiones: quedan fijados
+        int e = topologia_fijar_hilo(topologia_cpu(topo, dominio, omp_get_thread_num()));
+        if (e != 0) {
+            #pragma omp critical
+            {
+                hilos_sin_fijar++;
+                error_hilo = e;
+            }
+        }
+        generar_filas(A, n, fila_inicio, fila_fin, semilla_A);
+        generar_filas(B_local, n, 0, n, semilla_B);
+        #pragma omp for schedule(static)
+        for (int i = fila_inicio; i < fila_fin; i++) {
+            memset(C + (size_t)i * n, 0, n * sizeof(int));
+        }
+    }
+    if (hilos_sin_fijar > 0) {
+        printf("Aviso: %d hilos del dominio %d no se pudieron fijar a su CPU (%s)\n",
+               hilos_sin_fijar, dominio, strerror(error_hilo));
+    }
+    fflush(stdout); // el proceso termina con _exit
+
+    avisar_fin(control);
+
+    for (int r = 1; r <= repeticiones; r++) {
+        esperar_ronda(control, r);
+        calcular_dominio(control, dominio, topo->num_dominios, A, B_local, C, n, bloques_columna);
+        avisar_fin(control);
+    }
+    esperar_ronda(control, repeticiones + 1);
+}
+
+int matrices_iguales(int **X, const int *Y, int n) {
+    for (int i = 0; i < n; i++) {
+        if (memcmp(X[i], Y + (size_t)i * n, n * sizeof(int)) != 0) return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    // Verificar argumentos de línea de comandos
+    int repeticiones = 3;
+    int dominios_forzados = 0;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (strncmp(argv[a], "--dominios=", 11) == 0 && atoi(argv[a] + 11) > 0) {
+            dominios_forzados = atoi(argv[a] + 11);
+        } else if (a == 3 && argv[a][0] != '-') {
+            repeticiones = atoi(argv[a]);
+        } else {
+            opciones_validas = 0;
+        }
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [repeticiones] [--dominios=N]\n", argv[0]);
+        printf("  --dominios: N procesos con las CPUs repartidas entre ellos, en vez de uno por nodo NUMA o socket\n");
+        printf("Ejemplo: %s 2048 32\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[1]);
+    int num_hilos = atoi(argv[2]);
+    if (n <= 0 || num_hilos <= 0 || repeticiones <= 0) {
+        printf("Error: El tamaño de matriz, número de hilos y repeticiones deben ser positivos\n");
+        return 1;
+    }
+
+    Topologia topo;
+    topologia_detectar(&topo);
+    if (dominios_forzados > 0) topologia_dividir(&topo, dominios_forzados);
+    int num_dominios = topo.num_dominios;
+    int paneles = (n + PANEL_FILAS - 1) / PANEL_FILAS;
+    if (num_dominios > paneles) {
+        topologia_dividir(&topo, paneles);
+        num_dominios = paneles;
+        printf("Ajustando número de dominios a %d (uno por panel de %d filas)\n", num_dominios, PANEL_FILAS);
+    }
+
+    // Hilos por dominio en proporción a sus CPUs, al menos uno
+    int hilos[TOPO_MAX_DOMINIOS], cpus_totales = 0, hilos_totales = 0;
+    for (int d = 0; d < num_dominios; d++) cpus_totales += topo.num_cpus[d];
+    for (int d = 0, acumulado = 0; d < num_dominios; d++) {
+        int antes = num_hilos * acumulado / cpus_totales;
+        acumulado += topo.num_cpus[d];
+        hilos[d] = num_hilos * acumulado / cpus_totales - antes;
+        if (hilos[d] < 1) hilos[d] = 1;
+        hilos_totales += hilos[d];
+    }
+
+    printf("=== MULTIPLICACIÓN DE MATRICES HÍBRIDA: PROCESO POR DOMINIO, HILOS POR NÚCLEO ===\n");
+    printf("Tamaño de matriz: %dx%d\n", n, n);
+    printf("Dominios (%s): %d\n", topo.tipo, num_dominios);
+    printf("Hilos totales: %d\n", hilos_totales);
+    printf("Repeticiones: %d\n", repeticiones);
+    printf("Teselas de C: %dx%d\n\n", PANEL_FILAS, TESELA_COLUMNAS);
+
+    // Memoria compartida sin tocar: cada proceso toca sus partes
+    size_t elementos = (size_t)n * n;
+    size_t paso_B = (elementos * sizeof(int) + 4095) / 4096 * 4096 / sizeof(int); // copias alineadas a página
+    int *A = (int *)mmap(NULL, elementos * sizeof(int), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    int *C = (int *)mmap(NULL, elementos * sizeof(int), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    int *copias_B = (int *)mmap(NULL, paso_B * num_dominios * sizeof(int), PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ControlHibrido *control = (ControlHibrido *)mmap(NULL, sizeof(ControlHibrido), PROT_READ | PROT_WRITE,
+                                                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (A == MAP_FAILED || C == MAP_FAILED || copias_B == MAP_FAILED || control == MAP_FAILED) {
+        printf("Error: No se pudo asignar memoria compartida para las matrices\n");
+        exit(1);
+    }
+
+    int bloques_columna = (n + TESELA_COLUMNAS - 1) / TESELA_COLUMNAS;
+    int panel_inicio[TOPO_MAX_DOMINIOS], panel_fin[TOPO_MAX_DOMINIOS];
+    repartir_paneles(control, hilos, num_dominios, n, bloques_columna, panel_inicio, panel_fin);
+    for (int d = 0; d < num_dominios; d++) {
+        char cpus[256];
+        topologia_formatear(&topo.cpus[d], cpus, sizeof(cpus));
+        printf("Dominio %d (%s %d): CPUs %s, %d hilos, filas %d a %d\n", d, topo.tipo, topo.id[d], cpus, hilos[d],
+               panel_inicio[d] * PANEL_FILAS, (panel_fin[d] * PANEL_FILAS < n ? panel_fin[d] * PANEL_FILAS : n) - 1);
+    }
+    printf("\n");
+
+    // Los procesos se crean antes de que el padre use OpenMP: libgomp no
+    // sobrevive a un fork con su equipo de hilos ya creado
+    unsigned int semilla_A = (unsigned int)time(NULL);
+    unsigned int semilla_B = semilla_A + 1;
+    pid_t pids[TOPO_MAX_DOMINIOS];
+    fflush(stdout); // que los hijos, que pueden avisar, no hereden texto pendiente
+    double inicio_procesos = get_time_microseconds();
+    for (int d = 0; d < num_dominios; d++) {
+        pids[d] = fork();
+        if (pids[d] < 0) {
+            printf("Error: No se pudo crear el proceso del dominio %d\n", d);
+            exit(1);
+        }
+        if (pids[d] == 0) {
+            int fila_fin = panel_fin[d] * PANEL_FILAS < n ? panel_fin[d] * PANEL_FILAS : n;
+            proceso_dominio(&topo, d, hilos[d], control, A, copias_B + paso_B * d, C, n, panel_inicio[d] * PANEL_FILAS,
+                            fila_fin, bloques_columna, repeticiones, semilla_A, semilla_B);
+            _exit(0);
+        }
+    }
+
+    // Híbrido: el padre solo reinicia las colas, habilita cada ronda y mide
+    // hasta que los num_dominios procesos avisan que terminaron
+    printf("--- HÍBRIDO: PROCESO POR DOMINIO ---\n");
+    double suma_hibrida = 0.0;
+    uint32_t propias[TOPO_MAX_DOMINIOS] = {0}, robadas[TOPO_MAX_DOMINIOS] = {0};
+    int estado_muerto, muerto;
+    if ((muerto = esperar_dominios(control, num_dominios, pids, num_dominios, &estado_muerto)) >= 0) {
+        abortar_dominios(pids, num_dominios, muerto, estado_muerto);
+    }
+    printf("Creación de procesos y primer toque de A, B y C: %.2f microsegundos\n",
+           get_time_microseconds() - inicio_procesos);
+    for (int r = 1; r <= repeticiones; r++) {
+        reiniciar_colas(control, num_dominios);
+        double inicio = get_time_microseconds();
+        habilitar_ronda(control, r);
+        if ((muerto = esperar_dominios(control, num_dominios * (r + 1), pids, num_dominios, &estado_muerto)) >= 0) {
+            abortar_dominios(pids, num_dominios, muerto, estado_muerto);
+        }
+        suma_hibrida += get_time_microseconds() - inicio;
+    }
+    habilitar_ronda(control, repeticiones + 1); // los procesos pueden salir
+    for (int d = 0; d < num_dominios; d++) {
+        propias[d] = control->cola[d].propias;
+        robadas[d] = control->cola[d].robadas;
+    }
+    int fallidos = 0;
+    for (int d = 0; d < num_dominios; d++) {
+        int estado;
+        waitpid(pids[d], &estado, 0);
+        fallidos += !WIFEXITED(estado) || WEXITSTATUS(estado) != 0;
+    }
+    if (fallidos > 0) {
+        printf("Error: %d procesos de dominio terminaron con error\n", fallidos);
+        return 1;
+    }
+    double tiempo_hibrido = suma_hibrida / repeticiones / 1e6;
+    printf("Tiempo de multiplicación híbrida: %f segundos\n", tiempo_hibrido);
+    for (int d = 0; d < num_dominios; d++) {
+        uint32_t suyas = control->cola[d].fin - control->cola[d].inicio;
+        printf("Dominio %d: %u teselas propias, %.1f calculadas por él y %.1f robadas por otros (por repetición)\n", d,
+               suyas, (double)propias[d] / repeticiones, (double)robadas[d] / repeticiones);
+    }
+    printf("\n");
+
+    // Plano: mismo kernel y planificador, un proceso, una copia de B
+    printf("--- PLANO: UN PROCESO, UNA COPIA DE B ---\n");
+    int *C_plano = (int *)aligned_alloc(4096, (elementos * sizeof(int) + 4095) / 4096 * 4096); // alineada como el mmap
+    ControlHibrido *plano = (ControlHibrido *)aligned_alloc(64, sizeof(ControlHibrido));
+    if (C_plano == NULL || plano == NULL) {
+        printf("Error: No se pudo asignar memoria para la versión plana\n");
+        exit(1);
+    }
+    omp_set_num_threads(hilos_totales);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C_plano + (size_t)i * n, 0, n * sizeof(int)); // fuera del tiempo medido, como C del híbrido
+    }
+    plano->cola[0].inicio = 0;
+    plano->cola[0].fin = paneles * bloques_columna;
+    double suma_plana = 0.0;
+    for (int r = 0; r < repeticiones; r++) {
+        reiniciar_colas(plano, 1);
+        double inicio = get_time_microseconds();
+        calcular_dominio(plano, 0, 1, A, copias_B, C_plano, n, bloques_columna);
+        suma_plana += get_time_microseconds() - inicio;
+    }
+    double tiempo_plano = suma_plana / repeticiones / 1e6;
+    printf("Tiempo de multiplicación plana: %f segundos\n\n", tiempo_plano);
+
+    // Referencia: kernel por bloques de multiplicacion_openmp.c con int**
+    printf("--- REFERENCIA: OPENMP POR BLOQUES ---\n");
+    int **matriz_A = crear_matriz(n);
+    int **matriz_B = crear_matriz(n);
+    int **matriz_C = crear_matriz(n);
+    generar_matriz_aleatoria_paralela(matriz_A, n, semilla_A);
+    generar_matriz_aleatoria_paralela(matriz_B, n, semilla_B);
+    double inicio = get_time_microseconds();
+    multiplicar_matrices_openmp_optimizada(matriz_A, matriz_B, matriz_C, n);
+    double tiempo_bloques = (get_time_microseconds() - inicio) / 1e6;
+    printf("Tiempo de multiplicación OpenMP por bloques: %f segundos\n\n", tiempo_bloques);
+
+    int hibrida_correcta = matrices_iguales(matriz_C, C, n);
+    int plana_correcta = matrices_iguales(matriz_C, C_plano, n);
+
+    printf("=== RESULTADOS DE BENCHMARK ===\n");
+    printf("Speedup híbrido vs plano: %.2fx\n", tiempo_plano / tiempo_hibrido);
+    printf("Speedup híbrido vs OpenMP por bloques: %.2fx\n", tiempo_bloques / tiempo_hibrido);
+    printf("GFLOP/s híbrido: %.2f\n", 2.0 * n * n * n / tiempo_hibrido / 1e9);
+    printf("Verificación híbrida: %s\n", hibrida_correcta ? "correcta" : "INCORRECTA");
+    printf("Verificación plana: %s\n", plana_correcta ? "correcta" : "INCORRECTA");
+
+    liberar_matriz(matriz_A, n);
+    liberar_matriz(matriz_B, n);
+    liberar_matriz(matriz_C, n);
+    free(C_plano);
+    free(plano);
+    munmap(A, elementos * sizeof(int));
+    munmap(C, elementos * sizeof(int));
+    munmap(copias_B, paso_B * num_dominios * sizeof(int));
+    munmap(control, sizeof(ControlHibrido));
+    if (!hibrida_correcta || !plana_correcta) return 1;
+    printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+    return 0;
+}
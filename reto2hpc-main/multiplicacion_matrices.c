@@ -4,6 +4,10 @@
 #include <chrono>
 #include <string.h>
 #include <sys/time.h>
+#include "arena_matrices.h"
+#include "acumuladores.h"
+#include "kernels_fijos.h"
+#include "energia.h"
 
 //multiplicacion_matrices_optimizada.c
 // Versión optimizada con mejoras de CPU y memoria
@@ -22,6 +26,13 @@ void generar_matriz_aleatoria(int **matriz, int n) {
 void multiplicar_matrices_optimizada(int **A, int **B, int **C, int n) {
     const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
     
+    // Matrices pequeñas de tamaño fijo: kernel especializado, sin bloques
+    kernel_fijo_t kernel_fijo = buscar_kernel_fijo(n);
+    if (kernel_fijo != NULL) {
+        kernel_fijo(A, B, C);
+        return;
+    }
+    
     // Inicializar matriz C a cero
     for (int i = 0; i < n; i++) {
         memset(C[i], 0, n * sizeof(int));
@@ -115,10 +126,27 @@ size_t get_memory_usage() {
     return memory;
 }
 
+void ejecutar_acumulador_secuencial(int **A, int **B, int64_t *C, int n, modo_acumulador_t modo, int tramo, void *contexto) {
+    (void)contexto;
+    multiplicar_filas_acumulador(A, B, C, n, 0, n, modo, tramo);
+}
+
 int main(int argc, char *argv[]) {
     // Verificar argumentos de línea de comandos
-    if (argc != 2) {
-        printf("Uso: %s <tamaño_matriz>\n", argv[0]);
+    tipo_paginas_arena_t paginas_arena = ARENA_PAGINAS_THP;
+    int usar_arena = 0;
+    int modo_acumulador = ACUM_NUM_MODOS; // sin --acumulador
+    int opciones_validas = argc >= 2;
+    for (int a = 2; a < argc; a++) {
+        if (parse_opcion_arena(argv[a], &paginas_arena) == 0) {
+            usar_arena = 1;
+        } else if (parse_opcion_acumulador(argv[a], &modo_acumulador) != 0) {
+            opciones_validas = 0;
+        }
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> [--arena[=thp|hugetlb|normal]] [--acumulador=int32|saturado|int64|periodico|todos]\n", argv[0]);
+        printf("  --acumulador=modo: los kernels original y optimizado acumulan en ese modo; todos: costo de cada modo\n");
         printf("Ejemplo: %s 1000\n", argv[0]);
         return 1;
     }
@@ -134,17 +162,26 @@ int main(int argc, char *argv[]) {
     
     printf("=== MULTIPLICACIÓN DE MATRICES OPTIMIZADA ===\n");
     printf("Tamaño de matriz: %dx%d\n", n, n);
+    if (usar_arena) {
+        printf("Arena de matrices: %s\n", nombre_paginas_arena(paginas_arena));
+    }
     printf("Memoria inicial: %zu kB\n\n", get_memory_usage());
     
     // Inicializar generador de números aleatorios
     srand(time(NULL));
     
     // Crear las tres matrices: A, B y C (resultado)
-    int **matriz_A = crear_matriz(n);
-    int **matriz_B = crear_matriz(n);
-    int **matriz_C = crear_matriz(n);
+    // Con --arena las tres matrices salen de una sola reserva prefaultada
+    ArenaMatrices arena;
+    if (usar_arena) {
+        arena_crear(&arena, 3 * arena_tam_matriz(n), paginas_arena, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    int **matriz_A = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_B = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_C = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
     
     printf("Memoria después de crear matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras crear matrices: %ld\n", arena_fallos_de_pagina());
     
     // Generar matrices A y B con valores aleatorios
     double start_gen = get_time_microseconds();
@@ -153,15 +190,35 @@ int main(int argc, char *argv[]) {
     double end_gen = get_time_microseconds();
     
     printf("Tiempo de generación de matrices: %.2f microsegundos\n", end_gen - start_gen);
-    printf("Memoria después de generar matrices: %zu kB\n\n", get_memory_usage());
+    printf("Memoria después de generar matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras generar matrices: %ld\n\n", arena_fallos_de_pagina());
+
+    // Con --acumulador=modo los dos kernels medidos escriben C en 64 bits
+    int64_t *C64_orig = NULL, *C64_opt = NULL;
+    int tramo = 0;
+    if (acumulador_en_kernels(modo_acumulador)) {
+        C64_orig = crear_resultado_acumulador(n);
+        C64_opt = crear_resultado_acumulador(n);
+        tramo = tramo_periodico(matriz_A, matriz_B, n);
+        printf("Acumulador de los kernels: %s\n\n", nombre_modo_acumulador(modo_acumulador));
+    }
 
     // Prueba con algoritmo original
     printf("--- ALGORITMO ORIGINAL ---\n");
+    double operaciones = 2.0 * n * n * n;
+    LecturaEnergia energia_antes = energia_leer();
     auto start_orig = std::chrono::high_resolution_clock::now();
-    multiplicar_matrices_original(matriz_A, matriz_B, matriz_C, n);
+    if (C64_orig != NULL) {
+        multiplicar_filas_acumulador_original(matriz_A, matriz_B, C64_orig, n, 0, n, (modo_acumulador_t)modo_acumulador, tramo);
+    } else {
+        multiplicar_matrices_original(matriz_A, matriz_B, matriz_C, n);
+    }
     auto end_orig = std::chrono::high_resolution_clock::now();
+    LecturaEnergia energia_despues = energia_leer();
     std::chrono::duration<double> duration_orig = end_orig - start_orig;
     printf("Tiempo de multiplicación original: %f segundos\n", duration_orig.count());
+    MedidaEnergia energia_orig = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("original", &energia_orig, operaciones);
     printf("Memoria durante multiplicación original: %zu kB\n\n", get_memory_usage());
 
     // Limpiar matriz C para la siguiente prueba
@@ -171,13 +228,40 @@ int main(int argc, char *argv[]) {
 
     // Prueba con algoritmo optimizado
     printf("--- ALGORITMO OPTIMIZADO ---\n");
+    energia_antes = energia_leer();
     auto start_opt = std::chrono::high_resolution_clock::now();
-    multiplicar_matrices_optimizada(matriz_A, matriz_B, matriz_C, n);
+    if (C64_opt != NULL) {
+        ejecutar_acumulador_secuencial(matriz_A, matriz_B, C64_opt, n, (modo_acumulador_t)modo_acumulador, tramo, NULL);
+    } else {
+        multiplicar_matrices_optimizada(matriz_A, matriz_B, matriz_C, n);
+    }
     auto end_opt = std::chrono::high_resolution_clock::now();
+    energia_despues = energia_leer();
     std::chrono::duration<double> duration_opt = end_opt - start_opt;
     printf("Tiempo de multiplicación optimizada: %f segundos\n", duration_opt.count());
+    MedidaEnergia energia_opt = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("optimizada", &energia_opt, operaciones);
     printf("Memoria durante multiplicación optimizada: %zu kB\n\n", get_memory_usage());
 
+    if (C64_opt != NULL) {
+        verificar_acumulador(C64_orig, C64_opt, n, modo_acumulador);
+        free(C64_orig);
+        free(C64_opt);
+    }
+
+    // Costo de cada modo de acumulación con el kernel i-k-j en un solo hilo
+    if (modo_acumulador == ACUM_TODOS) {
+        int64_t *C64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        int64_t *R64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        if (C64 == NULL || R64 == NULL) {
+            printf("Error: No se pudo asignar memoria para los resultados de 64 bits\n");
+            exit(1);
+        }
+        comparar_modos_acumulador(matriz_A, matriz_B, C64, R64, n, modo_acumulador, ejecutar_acumulador_secuencial, NULL);
+        free(C64);
+        free(R64);
+    }
+
     // Calcular speedup
     double speedup = duration_orig.count() / duration_opt.count();
     printf("=== RESULTADOS DE BENCHMARK ===\n");
@@ -186,9 +270,18 @@ int main(int argc, char *argv[]) {
     printf("Memoria final: %zu kB\n", get_memory_usage());
 
     // Liberar memoria
-    liberar_matriz(matriz_A, n);
-    liberar_matriz(matriz_B, n);
-    liberar_matriz(matriz_C, n);
+    if (usar_arena) {
+        // Devolver los bloques y medir cuánto cuesta repetir la asignación
+        arena_liberar_matriz(&arena, matriz_A);
+        arena_liberar_matriz(&arena, matriz_B);
+        arena_liberar_matriz(&arena, matriz_C);
+        arena_comparar_con_malloc(&arena, n, 5);
+        arena_destruir(&arena);
+    } else {
+        liberar_matriz(matriz_A, n);
+        liberar_matriz(matriz_B, n);
+        liberar_matriz(matriz_C, n);
+    }
     
     printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
     return 0;
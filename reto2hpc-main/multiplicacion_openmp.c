@@ -5,6 +5,12 @@
 #include <sys/time.h>
 #include <omp.h>
 #include <chrono>
+#include "arena_matrices.h"
+#include "matrices_dispersas.h"
+#include "acumuladores.h"
+#include "traza.h"
+#include "kernels_fijos.h"
+#include "energia.h"
 
 //multiplicacion_openmp_optimizada.c
 // Versión optimizada con OpenMP y mejoras de CPU y memoria
@@ -21,20 +27,45 @@ void generar_matriz_aleatoria_paralela(int **matriz, int n) {
     }
 }
 
+// Igual que generar_matriz_aleatoria_paralela, pero cada elemento es no nulo
+// con probabilidad densidad
+void generar_matriz_dispersa_paralela(int **matriz, int n, double densidad) {
+    unsigned int umbral = (unsigned int)(densidad * RAND_MAX);
+    unsigned int base = time(NULL);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        unsigned int seed = base + i * 2654435761u;
+        for (int j = 0; j < n; j++) {
+            matriz[i][j] = (unsigned int)rand_r(&seed) <= umbral ? 1 + rand_r(&seed) % 99 : 0;
+        }
+    }
+}
+
 // Función para multiplicar matrices con OpenMP y optimización de cache
 void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
     const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
     
+    // Matrices pequeñas de tamaño fijo: kernel especializado en el hilo que
+    // llama, sin bloques ni región paralela
+    kernel_fijo_t kernel_fijo = buscar_kernel_fijo(n);
+    if (kernel_fijo != NULL) {
+        kernel_fijo(A, B, C);
+        return;
+    }
+    
     // Inicializar matriz C a cero (paralelizado)
     #pragma omp parallel for schedule(static)
     for (int i = 0; i < n; i++) {
+        TRAZA_TRAMO_INICIO(t_ceros);
         memset(C[i], 0, n * sizeof(int));
+        TRAZA_TRAMO_FIN(t_ceros, "inicializar fila C", i);
     }
     
     // Multiplicación por bloques con OpenMP
     #pragma omp parallel for collapse(2) schedule(dynamic, 1)
     for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
         for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            TRAZA_TRAMO_INICIO(t_tesela);
             for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
                 // Calcular límites del bloque
                 int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
@@ -52,6 +83,7 @@ void multiplicar_matrices_openmp_optimizada(int **A, int **B, int **C, int n) {
                     }
                 }
             }
+            TRAZA_TRAMO_FIN(t_tesela, "tesela C", (ii / BLOCK_SIZE) * ((n + BLOCK_SIZE - 1) / BLOCK_SIZE) + jj / BLOCK_SIZE);
         }
     }
 }
@@ -61,20 +93,241 @@ void multiplicar_matrices_openmp_simple(int **A, int **B, int **C, int n) {
     // Inicializar matriz C a cero (paralelizado)
     #pragma omp parallel for schedule(static)
     for (int i = 0; i < n; i++) {
+        TRAZA_TRAMO_INICIO(t_ceros);
         memset(C[i], 0, n * sizeof(int));
+        TRAZA_TRAMO_FIN(t_ceros, "inicializar fila C", i);
     }
     
     // Multiplicación paralela por filas
     #pragma omp parallel for schedule(static)
     for (int i = 0; i < n; i++) {
+        TRAZA_TRAMO_INICIO(t_fila);
         for (int j = 0; j < n; j++) {
             for (int k = 0; k < n; k++) {
                 C[i][j] += A[i][k] * B[k][j];
             }
         }
+        TRAZA_TRAMO_FIN(t_fila, "fila C", i);
     }
 }
 
+// Mide la densidad de A y B y usa la ruta densa por bloques o la dispersa
+// (SpMM o SpGEMM) según elegir_ruta_producto; la conversión a CSR/BCSR entra
+// en el tiempo medido
+ruta_producto_t multiplicar_matrices_automatica(int **A, int **B, int **C, int n) {
+    DensidadMatriz densidad_A = medir_densidad(A, n);
+    DensidadMatriz densidad_B = medir_densidad(B, n);
+    ruta_producto_t ruta = elegir_ruta_producto(densidad_A, densidad_B, n);
+
+    switch (ruta) {
+        case RUTA_SPMM_CSR: {
+            MatrizCSR A_csr = csr_desde_densa(A, n);
+            multiplicar_spmm_csr(&A_csr, B, C);
+            liberar_csr(&A_csr);
+            break;
+        }
+        case RUTA_SPMM_BCSR: {
+            MatrizBCSR A_bcsr = bcsr_desde_densa(A, n);
+            multiplicar_spmm_bcsr(&A_bcsr, B, C);
+            liberar_bcsr(&A_bcsr);
+            break;
+        }
+        case RUTA_SPGEMM: {
+            MatrizCSR A_csr = csr_desde_densa(A, n);
+            MatrizCSR B_csr = csr_desde_densa(B, n);
+            MatrizCSR C_csr = multiplicar_spgemm(&A_csr, &B_csr);
+            csr_a_densa(&C_csr, C);
+            liberar_csr(&A_csr);
+            liberar_csr(&B_csr);
+            liberar_csr(&C_csr);
+            break;
+        }
+        default:
+            multiplicar_matrices_openmp_optimizada(A, B, C, n);
+            break;
+    }
+
+    printf("Densidad de A: %.2f%% (llenado de bloques %dx%d: %.1f%%)\n",
+           densidad_A.densidad * 100, BCSR_BLOQUE, BCSR_BLOQUE, densidad_A.llenado_bloques * 100);
+    printf("Densidad de B: %.2f%%\n", densidad_B.densidad * 100);
+    printf("Ruta elegida: %s\n", nombre_ruta_producto(ruta));
+    return ruta;
+}
+
+// Kernel simple en el modo de --acumulador: filas repartidas como en
+// multiplicar_matrices_openmp_simple
+void multiplicar_acumulador_openmp_simple(int **A, int **B, int64_t *C, int n, modo_acumulador_t modo, int tramo) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        TRAZA_TRAMO_INICIO(t_fila);
+        multiplicar_filas_acumulador_original(A, B, C, n, i, i + 1, modo, tramo);
+        TRAZA_TRAMO_FIN(t_fila, "fila C", i);
+    }
+}
+
+// Modos de acumulación: bloques de filas repartidos como en el kernel
+// optimizado
+void ejecutar_acumulador_openmp(int **A, int **B, int64_t *C, int n, modo_acumulador_t modo, int tramo, void *contexto) {
+    (void)contexto;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += ACUM_FILAS_BLOQUE) {
+        int i_end = (ii + ACUM_FILAS_BLOQUE < n) ? ii + ACUM_FILAS_BLOQUE : n;
+        multiplicar_filas_acumulador(A, B, C, n, ii, i_end, modo, tramo);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Exploración de planificación (--explorar): los kernels con
+// schedule(runtime) bajo cada combinación de tipo, chunk y collapse, midiendo
+// el tiempo ocupado de cada hilo (sin la espera en la barrera final). El
+// desbalance es el tiempo ocupado máximo sobre el medio.
+// OMP_PROC_BIND y OMP_PLACES sólo se leen al arrancar: explorar_openmp.sh
+// relanza el programa con cada combinación.
+// ---------------------------------------------------------------------------
+
+#define EXPLORAR_MAX_HILOS 256
+
+typedef struct {
+    const char *kernel;
+    int collapse;
+} KernelExploracion;
+
+// Bloque (ii, jj) de C como en multiplicar_matrices_openmp_optimizada; C debe
+// estar en cero
+static inline void multiplicar_bloque(int **A, int **B, int **C, int n, int ii, int jj) {
+    const int BLOCK_SIZE = 64;
+    int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+    int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+    for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+        int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+        for (int i = ii; i < i_end; i++) {
+            for (int j = jj; j < j_end; j++) {
+                int sum = C[i][j];
+                for (int k = kk; k < k_end; k++) {
+                    sum += A[i][k] * B[k][j];
+                }
+                C[i][j] = sum;
+            }
+        }
+    }
+}
+
+// Devuelve el tiempo total, deja en ocupado[] el tiempo de cada hilo y en
+// *equipo el número de hilos que de verdad formó el equipo (puede ser menor
+// que num_hilos, p. ej. con OMP_THREAD_LIMIT). num_hilos <= EXPLORAR_MAX_HILOS
+double ejecutar_kernel_explorado(int k, int **A, int **B, int **C, int n, int num_hilos, double *ocupado,
+                                 int *equipo) {
+    const int BLOCK_SIZE = 64;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C[i], 0, n * sizeof(int));
+    }
+
+    double inicio = omp_get_wtime();
+    #pragma omp parallel num_threads(num_hilos)
+    {
+        double t0 = omp_get_wtime();
+        #pragma omp master
+        *equipo = omp_get_num_threads();
+        switch (k) {
+            case 0: // simple, collapse(1)
+                #pragma omp for schedule(runtime) nowait
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < n; j++) {
+                        int sum = 0;
+                        for (int kk = 0; kk < n; kk++) sum += A[i][kk] * B[kk][j];
+                        C[i][j] = sum;
+                    }
+                }
+                break;
+            case 1: // simple, collapse(2)
+                #pragma omp for collapse(2) schedule(runtime) nowait
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < n; j++) {
+                        int sum = 0;
+                        for (int kk = 0; kk < n; kk++) sum += A[i][kk] * B[kk][j];
+                        C[i][j] = sum;
+                    }
+                }
+                break;
+            case 2: // bloques, collapse(1)
+                #pragma omp for schedule(runtime) nowait
+                for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+                    for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+                        multiplicar_bloque(A, B, C, n, ii, jj);
+                    }
+                }
+                break;
+            default: // bloques, collapse(2)
+                #pragma omp for collapse(2) schedule(runtime) nowait
+                for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+                    for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+                        multiplicar_bloque(A, B, C, n, ii, jj);
+                    }
+                }
+                break;
+        }
+        ocupado[omp_get_thread_num()] = omp_get_wtime() - t0;
+    }
+    return omp_get_wtime() - inicio;
+}
+
+const char *nombre_proc_bind() {
+    switch (omp_get_proc_bind()) {
+        case omp_proc_bind_true:   return "true";
+        case omp_proc_bind_master: return "master";
+        case omp_proc_bind_close:  return "close";
+        case omp_proc_bind_spread: return "spread";
+        default:                   return "false";
+    }
+}
+
+void explorar_configuraciones(int **A, int **B, int **C, int n, int num_hilos) {
+    KernelExploracion kernels[] = {{"simple", 1}, {"simple", 2}, {"bloques", 1}, {"bloques", 2}};
+    struct { omp_sched_t tipo; const char *nombre; } tipos[] = {
+        {omp_sched_static, "static"}, {omp_sched_dynamic, "dynamic"},
+        {omp_sched_guided, "guided"}, {omp_sched_auto, "auto"}};
+    int chunks[] = {0, 1, 4, 16, 64}; // 0: el chunk por defecto del tipo
+    const char *lugares = getenv("OMP_PLACES") != NULL ? getenv("OMP_PLACES") : "sin definir";
+    double ocupado[EXPLORAR_MAX_HILOS];
+    if (num_hilos > EXPLORAR_MAX_HILOS) num_hilos = EXPLORAR_MAX_HILOS;
+
+    printf("--- EXPLORACIÓN DE PLANIFICACIÓN ---\n");
+    printf("OMP_PROC_BIND: %s, OMP_PLACES: %s (%d lugares)\n\n", nombre_proc_bind(), lugares, omp_get_num_places());
+    printf("kernel,collapse,schedule,chunk,proc_bind,places,hilos,tiempo_s,ocupado_min_s,ocupado_max_s,desbalance\n");
+
+    double mejor_tiempo = 0.0;
+    char mejor[128] = "";
+    for (int k = 0; k < 4; k++) {
+        for (int t = 0; t < 4; t++) {
+            for (int c = 0; c < 5; c++) {
+                // auto no acepta chunk
+                if (tipos[t].tipo == omp_sched_auto && chunks[c] != 0) continue;
+                omp_set_schedule(tipos[t].tipo, chunks[c]);
+
+                int equipo = num_hilos;
+                double tiempo = ejecutar_kernel_explorado(k, A, B, C, n, num_hilos, ocupado, &equipo);
+                double minimo = ocupado[0], maximo = ocupado[0], suma = 0.0;
+                for (int h = 0; h < equipo; h++) {
+                    if (ocupado[h] < minimo) minimo = ocupado[h];
+                    if (ocupado[h] > maximo) maximo = ocupado[h];
+                    suma += ocupado[h];
+                }
+                printf("%s,%d,%s,%d,%s,%s,%d,%.6f,%.6f,%.6f,%.2f\n", kernels[k].kernel, kernels[k].collapse,
+                       tipos[t].nombre, chunks[c], nombre_proc_bind(), lugares, equipo,
+                       tiempo, minimo, maximo, suma > 0.0 ? maximo / (suma / equipo) : 1.0);
+                if (mejor_tiempo == 0.0 || tiempo < mejor_tiempo) {
+                    mejor_tiempo = tiempo;
+                    snprintf(mejor, sizeof(mejor), "%s collapse(%d) schedule(%s, %d)", kernels[k].kernel,
+                             kernels[k].collapse, tipos[t].nombre, chunks[c]);
+                }
+            }
+        }
+    }
+    printf("\nMejor configuración: %s, %f segundos\n\n", mejor, mejor_tiempo);
+}
+
 // Función para crear una matriz cuadrada dinámicamente
 int **crear_matriz(int n) {
     int **matriz = (int **)malloc(n * sizeof(int *));
@@ -129,8 +382,29 @@ size_t get_memory_usage() {
 
 int main(int argc, char *argv[]) {
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        printf("Uso: %s <tamaño_matriz> <num_hilos>\n", argv[0]);
+    tipo_paginas_arena_t paginas_arena = ARENA_PAGINAS_THP;
+    int usar_arena = 0;
+    double densidad = 1.0; // < 1 con --dispersa
+    int modo_acumulador = ACUM_NUM_MODOS; // sin --acumulador
+    int explorar = 0;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (parse_opcion_arena(argv[a], &paginas_arena) == 0) {
+            usar_arena = 1;
+        } else if (strncmp(argv[a], "--dispersa=", 11) == 0 && atof(argv[a] + 11) > 0 && atof(argv[a] + 11) <= 1) {
+            densidad = atof(argv[a] + 11);
+        } else if (strcmp(argv[a], "--explorar") == 0) {
+            explorar = 1;
+        } else if (parse_opcion_acumulador(argv[a], &modo_acumulador) != 0) {
+            opciones_validas = 0;
+        }
+    }
+    // La ruta dispersa acumula en int: no se combina con un modo en los kernels
+    if (densidad < 1.0 && acumulador_en_kernels(modo_acumulador)) opciones_validas = 0;
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos> [--arena[=thp|hugetlb|normal]] [--dispersa=densidad] [--acumulador=int32|saturado|int64|periodico|todos] [--explorar]\n", argv[0]);
+        printf("  --acumulador=modo: los kernels simple y optimizado acumulan en ese modo; todos: costo de cada modo\n");
+        printf("  --dispersa sólo se combina con --acumulador=todos\n");
         printf("Ejemplo: %s 1000 4\n", argv[0]);
         return 1;
     }
@@ -152,34 +426,92 @@ int main(int argc, char *argv[]) {
     printf("Tamaño de matriz: %dx%d\n", n, n);
     printf("Número de hilos: %d\n", num_hilos);
     printf("Hilos disponibles: %d\n", omp_get_max_threads());
+    if (usar_arena) {
+        printf("Arena de matrices: %s\n", nombre_paginas_arena(paginas_arena));
+    }
+    if (densidad < 1.0) {
+        printf("Densidad de entrada: %.2f%%\n", densidad * 100);
+    }
     printf("Memoria inicial: %zu kB\n\n", get_memory_usage());
     
     // Inicializar generador de números aleatorios
     srand(time(NULL));
     
     // Crear las tres matrices: A, B y C (resultado)
-    int **matriz_A = crear_matriz(n);
-    int **matriz_B = crear_matriz(n);
-    int **matriz_C = crear_matriz(n);
+    // Con --arena las tres matrices salen de una sola reserva prefaultada
+    // (cuatro con --dispersa, que guarda también el resultado automático)
+    ArenaMatrices arena;
+    int num_matrices = densidad < 1.0 ? 4 : 3;
+    if (usar_arena) {
+        arena_crear(&arena, num_matrices * arena_tam_matriz(n), paginas_arena, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    int **matriz_A = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_B = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_C = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_D = NULL;
+    if (num_matrices == 4) {
+        matriz_D = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    }
     
     printf("Memoria después de crear matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras crear matrices: %ld\n", arena_fallos_de_pagina());
     
     // Generar matrices A y B con valores aleatorios (paralelizado)
     double start_gen = get_time_microseconds();
-    generar_matriz_aleatoria_paralela(matriz_A, n);
-    generar_matriz_aleatoria_paralela(matriz_B, n);
+    if (densidad < 1.0) {
+        generar_matriz_dispersa_paralela(matriz_A, n, densidad);
+        generar_matriz_dispersa_paralela(matriz_B, n, densidad);
+    } else {
+        generar_matriz_aleatoria_paralela(matriz_A, n);
+        generar_matriz_aleatoria_paralela(matriz_B, n);
+    }
     double end_gen = get_time_microseconds();
     
     printf("Tiempo de generación de matrices: %.2f microsegundos\n", end_gen - start_gen);
-    printf("Memoria después de generar matrices: %zu kB\n\n", get_memory_usage());
+    printf("Memoria después de generar matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras generar matrices: %ld\n\n", arena_fallos_de_pagina());
+
+    // Con --explorar sólo se recorren las configuraciones de planificación
+    if (explorar) {
+        explorar_configuraciones(matriz_A, matriz_B, matriz_C, n, num_hilos);
+        if (usar_arena) {
+            arena_destruir(&arena);
+        } else {
+            liberar_matriz(matriz_A, n);
+            liberar_matriz(matriz_B, n);
+            liberar_matriz(matriz_C, n);
+            if (matriz_D != NULL) liberar_matriz(matriz_D, n);
+        }
+        printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+        return 0;
+    }
+
+    // Con --acumulador=modo los dos kernels medidos escriben C en 64 bits
+    int64_t *C64_simple = NULL, *C64_opt = NULL;
+    int tramo = 0;
+    if (acumulador_en_kernels(modo_acumulador)) {
+        C64_simple = crear_resultado_acumulador(n);
+        C64_opt = crear_resultado_acumulador(n);
+        tramo = tramo_periodico(matriz_A, matriz_B, n);
+        printf("Acumulador de los kernels: %s\n\n", nombre_modo_acumulador(modo_acumulador));
+    }
 
     // Prueba con algoritmo OpenMP simple
     printf("--- ALGORITMO OPENMP SIMPLE ---\n");
+    double operaciones = 2.0 * n * n * n;
+    LecturaEnergia energia_antes = energia_leer();
     auto start_simple = std::chrono::high_resolution_clock::now();
-    multiplicar_matrices_openmp_simple(matriz_A, matriz_B, matriz_C, n);
+    if (C64_simple != NULL) {
+        multiplicar_acumulador_openmp_simple(matriz_A, matriz_B, C64_simple, n, (modo_acumulador_t)modo_acumulador, tramo);
+    } else {
+        multiplicar_matrices_openmp_simple(matriz_A, matriz_B, matriz_C, n);
+    }
     auto end_simple = std::chrono::high_resolution_clock::now();
+    LecturaEnergia energia_despues = energia_leer();
     std::chrono::duration<double> duration_simple = end_simple - start_simple;
     printf("Tiempo de multiplicación OpenMP simple: %f segundos\n", duration_simple.count());
+    MedidaEnergia energia_simple = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("OpenMP simple", &energia_simple, operaciones);
     printf("Memoria durante multiplicación simple: %zu kB\n\n", get_memory_usage());
 
     // Limpiar matriz C para la siguiente prueba
@@ -190,13 +522,57 @@ int main(int argc, char *argv[]) {
 
     // Prueba con algoritmo OpenMP optimizado
     printf("--- ALGORITMO OPENMP OPTIMIZADO ---\n");
+    energia_antes = energia_leer();
     auto start_opt = std::chrono::high_resolution_clock::now();
-    multiplicar_matrices_openmp_optimizada(matriz_A, matriz_B, matriz_C, n);
+    if (C64_opt != NULL) {
+        ejecutar_acumulador_openmp(matriz_A, matriz_B, C64_opt, n, (modo_acumulador_t)modo_acumulador, tramo, NULL);
+    } else {
+        multiplicar_matrices_openmp_optimizada(matriz_A, matriz_B, matriz_C, n);
+    }
     auto end_opt = std::chrono::high_resolution_clock::now();
+    energia_despues = energia_leer();
     std::chrono::duration<double> duration_opt = end_opt - start_opt;
     printf("Tiempo de multiplicación OpenMP optimizada: %f segundos\n", duration_opt.count());
+    MedidaEnergia energia_opt = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("OpenMP optimizada", &energia_opt, operaciones);
     printf("Memoria durante multiplicación optimizada: %zu kB\n\n", get_memory_usage());
 
+    // Ruta elegida según la densidad, comparada con la densa por bloques
+    double tiempo_automatica = 0.0;
+    if (matriz_D != NULL) {
+        printf("--- RUTA AUTOMÁTICA SEGÚN DENSIDAD ---\n");
+        auto start_auto = std::chrono::high_resolution_clock::now();
+        multiplicar_matrices_automatica(matriz_A, matriz_B, matriz_D, n);
+        auto end_auto = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration_auto = end_auto - start_auto;
+        tiempo_automatica = duration_auto.count();
+
+        int iguales = 1;
+        for (int i = 0; i < n && iguales; i++) {
+            iguales = memcmp(matriz_C[i], matriz_D[i], n * sizeof(int)) == 0;
+        }
+        printf("Tiempo de multiplicación automática (incluye conversión): %f segundos\n", tiempo_automatica);
+        printf("Verificación (automática vs optimizada): %s\n\n", iguales ? "correcta" : "INCORRECTA");
+    }
+
+    if (C64_opt != NULL) {
+        verificar_acumulador(C64_simple, C64_opt, n, modo_acumulador);
+        free(C64_simple);
+        free(C64_opt);
+    }
+
+    if (modo_acumulador == ACUM_TODOS) {
+        int64_t *C64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        int64_t *R64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        if (C64 == NULL || R64 == NULL) {
+            printf("Error: No se pudo asignar memoria para los resultados de 64 bits\n");
+            exit(1);
+        }
+        comparar_modos_acumulador(matriz_A, matriz_B, C64, R64, n, modo_acumulador, ejecutar_acumulador_openmp, NULL);
+        free(C64);
+        free(R64);
+    }
+
     // Calcular speedup y eficiencia
     double speedup = duration_simple.count() / duration_opt.count();
     double eficiencia = speedup / num_hilos;
@@ -205,12 +581,27 @@ int main(int argc, char *argv[]) {
     printf("Speedup: %.2fx\n", speedup);
     printf("Eficiencia: %.2f%%\n", eficiencia * 100);
     printf("Mejora de rendimiento: %.1f%%\n", ((duration_simple.count() - duration_opt.count()) / duration_simple.count()) * 100);
+    if (matriz_D != NULL) {
+        printf("Speedup de la ruta automática sobre la optimizada: %.2fx\n", duration_opt.count() / tiempo_automatica);
+    }
     printf("Memoria final: %zu kB\n", get_memory_usage());
+    TRAZA_VOLCAR("traza_openmp.json");
 
     // Liberar memoria
-    liberar_matriz(matriz_A, n);
-    liberar_matriz(matriz_B, n);
-    liberar_matriz(matriz_C, n);
+    if (usar_arena) {
+        // Devolver los bloques y medir cuánto cuesta repetir la asignación
+        arena_liberar_matriz(&arena, matriz_A);
+        arena_liberar_matriz(&arena, matriz_B);
+        arena_liberar_matriz(&arena, matriz_C);
+        if (matriz_D != NULL) arena_liberar_matriz(&arena, matriz_D);
+        arena_comparar_con_malloc(&arena, n, 5);
+        arena_destruir(&arena);
+    } else {
+        liberar_matriz(matriz_A, n);
+        liberar_matriz(matriz_B, n);
+        liberar_matriz(matriz_C, n);
+        if (matriz_D != NULL) liberar_matriz(matriz_D, n);
+    }
     
     printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
     return 0;
@@ -1,12 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <unistd.h> // Para fork()
+#include <unistd.h>
 #include <sys/mman.h> // Para mmap
-#include <sys/wait.h> // Para wait
 #include <chrono>
 #include <string.h>
 #include <sys/time.h>
+#include "pool_procesos.h" // Pool de procesos pre-creados
+#include "acumuladores.h"
+#include "registro.h"
+#include "energia.h"
 
 //multiplicacion_procesos_optimizada.c
 // Versión optimizada con mejoras de CPU, memoria y cache
@@ -19,12 +22,31 @@ typedef struct {
     char nombre;
 } DatosMatriz;
 
+// Mensajes de los procesos del pool: los buffers están en memoria compartida
+// y se crean antes del pool; el padre los vuelca fuera de las regiones medidas
+Registro registro;
+
+// Trabajo que se envía al pool: un bloque de filas de C = A * B
+typedef struct {
+    int **A;
+    int **B;
+    int *C;
+    int n;
+    int fila_inicio;
+    int fila_fin;
+    int proc_id;
+    int optimizada;
+    int64_t *C64;           // con --acumulador=modo, resultado de 64 bits en lugar de C
+    modo_acumulador_t modo;
+    int tramo;
+} TrabajoMultiplicacion;
+
 // Multiplicación de matrices por bloques de filas (optimizada para procesos)
 // C es un arreglo 1D en memoria compartida
 void multiplicar_matrices_proceso_optimizada(int **A, int **B, int *C, int n, int fila_inicio, int fila_fin, int proc_id) {
     const int BLOCK_SIZE = 32; // Tamaño de bloque para optimización de cache
     
-    printf("Proceso %d: Procesando filas %d a %d (optimizado)\n", proc_id, fila_inicio, fila_fin - 1);
+    registro_escribir(&registro, proc_id, REGISTRO_INFO, "Procesando filas %d a %d (optimizado)", fila_inicio, fila_fin - 1);
     
     // Inicializar bloque de filas a cero
     for (int i = fila_inicio; i < fila_fin; i++) {
@@ -52,12 +74,12 @@ void multiplicar_matrices_proceso_optimizada(int **A, int **B, int *C, int n, in
         }
     }
     
-    printf("Proceso %d: Filas %d a %d completadas (optimizado).\n", proc_id, fila_inicio, fila_fin - 1);
+    registro_escribir(&registro, proc_id, REGISTRO_INFO, "Filas %d a %d completadas (optimizado).", fila_inicio, fila_fin - 1);
 }
 
 // Multiplicación de matrices por bloques de filas (versión original)
 void multiplicar_matrices_proceso_original(int **A, int **B, int *C, int n, int fila_inicio, int fila_fin, int proc_id) {
-    printf("Proceso %d: Procesando filas %d a %d (original)\n", proc_id, fila_inicio, fila_fin - 1);
+    registro_escribir(&registro, proc_id, REGISTRO_INFO, "Procesando filas %d a %d (original)", fila_inicio, fila_fin - 1);
     for (int i = fila_inicio; i < fila_fin; i++) {
         for (int j = 0; j < n; j++) {
             C[i * n + j] = 0;
@@ -66,34 +88,125 @@ void multiplicar_matrices_proceso_original(int **A, int **B, int *C, int n, int
             }
         }
     }
-    printf("Proceso %d: Filas %d a %d completadas (original).\n", proc_id, fila_inicio, fila_fin - 1);
+    registro_escribir(&registro, proc_id, REGISTRO_INFO, "Filas %d a %d completadas (original).", fila_inicio, fila_fin - 1);
 }
 
-// Función para crear una matriz cuadrada dinámicamente
-int **crear_matriz(int n) {
-    int **matriz = (int **)malloc(n * sizeof(int *));
-    if (matriz == NULL) {
-        printf("Error: No se pudo asignar memoria para la matriz\n");
+// Crea una matriz en memoria compartida (MAP_SHARED): punteros de fila y
+// datos en una sola región, visible para los procesos del pool aunque se
+// escriba después de crearlos
+int **crear_matriz_compartida(int n) {
+    size_t bytes = n * sizeof(int *) + (size_t)n * n * sizeof(int);
+    void *region = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        printf("Error: No se pudo asignar memoria compartida para la matriz\n");
         exit(1);
     }
-    
+
+    int **matriz = (int **)region;
+    int *datos = (int *)(matriz + n);
     for (int i = 0; i < n; i++) {
-        matriz[i] = (int *)malloc(n * sizeof(int));
-        if (matriz[i] == NULL) {
-            printf("Error: No se pudo asignar memoria para la fila %d\n", i);
-            exit(1);
-        }
+        matriz[i] = datos + (size_t)i * n;
     }
-    
     return matriz;
 }
 
-// Función para liberar memoria de una matriz
-void liberar_matriz(int **matriz, int n) {
-    for (int i = 0; i < n; i++) {
-        free(matriz[i]);
+void liberar_matriz_compartida(int **matriz, int n) {
+    munmap(matriz, n * sizeof(int *) + (size_t)n * n * sizeof(int));
+}
+
+// Se ejecuta en un proceso del pool; deja en su ranura el tiempo que tardó
+void ejecutar_trabajo(const void *datos, void *ranura, int trabajador) {
+    const TrabajoMultiplicacion *t = (const TrabajoMultiplicacion *)datos;
+    (void)trabajador;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    if (t->C64 != NULL && t->optimizada) {
+        multiplicar_filas_acumulador(t->A, t->B, t->C64, t->n, t->fila_inicio, t->fila_fin, t->modo, t->tramo);
+    } else if (t->C64 != NULL) {
+        multiplicar_filas_acumulador_original(t->A, t->B, t->C64, t->n, t->fila_inicio, t->fila_fin, t->modo, t->tramo);
+    } else if (t->optimizada) {
+        multiplicar_matrices_proceso_optimizada(t->A, t->B, t->C, t->n, t->fila_inicio, t->fila_fin, t->proc_id);
+    } else {
+        multiplicar_matrices_proceso_original(t->A, t->B, t->C, t->n, t->fila_inicio, t->fila_fin, t->proc_id);
+    }
+    std::chrono::duration<double> duracion = std::chrono::high_resolution_clock::now() - inicio;
+    *(double *)ranura = duracion.count();
+    registro_metrica(&registro, t->proc_id, "tiempo_s", duracion.count());
+}
+
+// Reparte las filas de C entre los procesos del pool y espera el resultado.
+// Con C64 != NULL los procesos escriben ahí, acumulando en el modo dado.
+// Devuelve el tiempo total en segundos y el desbalance de carga (tiempo
+// máximo / tiempo medio por proceso)
+double multiplicar_con_pool(pool_procesos_t *pool, int **A, int **B, int *C, int64_t *C64,
+                            modo_acumulador_t modo, int tramo, int n,
+                            int num_procesos, int optimizada, double *desbalance) {
+    int filas_por_proceso = n / num_procesos;
+    int filas_restantes = n % num_procesos;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    int fila_inicio = 0;
+    for (int i = 0; i < num_procesos; i++) {
+        int fila_fin = fila_inicio + filas_por_proceso;
+        if (i < filas_restantes) fila_fin++;
+        TrabajoMultiplicacion trabajo = {A, B, C, n, fila_inicio, fila_fin, i, optimizada, C64, modo, tramo};
+        pool_enviar(pool, ejecutar_trabajo, &trabajo, sizeof(trabajo), i);
+        fila_inicio = fila_fin;
+    }
+    if (pool_esperar(pool) > 0) {
+        printf("Error: uno o más procesos fallaron durante la multiplicación\n");
+        exit(1);
+    }
+    std::chrono::duration<double> duracion = std::chrono::high_resolution_clock::now() - inicio;
+
+    double maximo = 0.0, suma = 0.0;
+    for (int i = 0; i < num_procesos; i++) {
+        double t = *(double *)pool_ranura(pool, i);
+        suma += t;
+        if (t > maximo) maximo = t;
+    }
+    *desbalance = suma > 0.0 ? maximo / (suma / num_procesos) : 1.0;
+    return duracion.count();
+}
+
+// Modos de acumulación: mismo reparto de filas que multiplicar_con_pool; C
+// es de 64 bits y también vive en memoria compartida
+typedef struct {
+    int **A;
+    int **B;
+    int64_t *C;
+    int n;
+    int fila_inicio;
+    int fila_fin;
+    modo_acumulador_t modo;
+    int tramo;
+} TrabajoAcumulador;
+
+void ejecutar_trabajo_acumulador(const void *datos, void *ranura, int trabajador) {
+    const TrabajoAcumulador *t = (const TrabajoAcumulador *)datos;
+    (void)ranura;
+    (void)trabajador;
+    multiplicar_filas_acumulador(t->A, t->B, t->C, t->n, t->fila_inicio, t->fila_fin, t->modo, t->tramo);
+}
+
+void ejecutar_acumulador_pool(int **A, int **B, int64_t *C, int n, modo_acumulador_t modo, int tramo, void *contexto) {
+    pool_procesos_t *pool = (pool_procesos_t *)contexto;
+    int num_procesos = pool_num_trabajadores(pool);
+    int filas_por_proceso = n / num_procesos;
+    int filas_restantes = n % num_procesos;
+
+    int fila_inicio = 0;
+    for (int i = 0; i < num_procesos; i++) {
+        int fila_fin = fila_inicio + filas_por_proceso;
+        if (i < filas_restantes) fila_fin++;
+        TrabajoAcumulador trabajo = {A, B, C, n, fila_inicio, fila_fin, modo, tramo};
+        pool_enviar(pool, ejecutar_trabajo_acumulador, &trabajo, sizeof(trabajo), i);
+        fila_inicio = fila_fin;
+    }
+    if (pool_esperar(pool) > 0) {
+        printf("Error: uno o más procesos fallaron durante la multiplicación\n");
+        exit(1);
     }
-    free(matriz);
 }
 
 // Función para obtener tiempo en microsegundos
@@ -123,38 +236,84 @@ size_t get_memory_usage() {
 
 int main(int argc, char *argv[]) {
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        printf("Uso: %s <tamaño_matriz> <num_procesos>\n", argv[0]);
+    int repeticiones = 1;
+    int modo_acumulador = ACUM_NUM_MODOS; // sin --acumulador
+    int verbosidad = REGISTRO_INFO;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (parse_opcion_acumulador(argv[a], &modo_acumulador) != 0 &&
+            parse_opcion_verbosidad(argv[a], &verbosidad) != 0) {
+            if (a == 3 && argv[a][0] != '-') {
+                repeticiones = atoi(argv[a]);
+            } else {
+                opciones_validas = 0;
+            }
+        }
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_procesos> [repeticiones] [--acumulador=int32|saturado|int64|periodico|todos] [--verbosidad=0|1|2]\n", argv[0]);
+        printf("  --acumulador=modo: los kernels original y optimizado acumulan en ese modo; todos: costo de cada modo\n");
         printf("Ejemplo: %s 1000 4\n", argv[0]);
         return 1;
     }
     int n = atoi(argv[1]);
     int num_procesos = atoi(argv[2]);
-    if (n <= 0 || num_procesos <= 0) {
-        printf("Error: El tamaño de matriz y número de procesos deben ser positivos\n");
+    if (n <= 0 || num_procesos <= 0 || repeticiones <= 0) {
+        printf("Error: El tamaño de matriz, número de procesos y repeticiones deben ser positivos\n");
         return 1;
     }
     if (num_procesos > n) {
         num_procesos = n;
         printf("Ajustando número de procesos a %d (máximo: tamaño de matriz)\n", n);
     }
+    if (num_procesos > POOL_MAX_TRABAJADORES) {
+        num_procesos = POOL_MAX_TRABAJADORES;
+        printf("Ajustando número de procesos a %d (máximo del pool)\n", num_procesos);
+    }
     printf("=== MULTIPLICACIÓN DE MATRICES CON PROCESOS OPTIMIZADA ===\n");
     printf("Tamaño de matriz: %dx%d\n", n, n);
     printf("Procesos para multiplicación: %d\n", num_procesos);
+    if (repeticiones > 1) {
+        printf("Repeticiones: %d\n", repeticiones);
+    }
     printf("Memoria inicial: %zu kB\n\n", get_memory_usage());
 
-    // Crear matrices A y B en memoria normal
-    int **matriz_A = crear_matriz(n);
-    int **matriz_B = crear_matriz(n);
-    // Crear matriz C en memoria compartida (1D)
+    // Las tres matrices viven en memoria compartida: los procesos del pool
+    // leen A y B y escriben su bloque de filas de C
+    int **matriz_A = crear_matriz_compartida(n);
+    int **matriz_B = crear_matriz_compartida(n);
     int *matriz_C = (int *)mmap(NULL, n * n * sizeof(int), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
     if (matriz_C == MAP_FAILED) {
         printf("Error: No se pudo asignar memoria compartida para la matriz C\n");
         exit(1);
     }
     
+    // Resultados de 64 bits para --acumulador, compartidos antes de crear el
+    // pool como las demás matrices. Con un modo, R64 recibe el kernel
+    // original y C64 el optimizado; con todos, ambos van al informe de costos
+    int64_t *C64 = NULL, *R64 = NULL;
+    size_t bytes_64 = (size_t)n * n * sizeof(int64_t);
+    if (modo_acumulador != ACUM_NUM_MODOS) {
+        C64 = (int64_t *)mmap(NULL, bytes_64, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        R64 = (int64_t *)mmap(NULL, bytes_64, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (C64 == MAP_FAILED || R64 == MAP_FAILED) {
+            printf("Error: No se pudo asignar memoria compartida para los resultados de 64 bits\n");
+            exit(1);
+        }
+    }
+    
     printf("Memoria después de crear matrices: %zu kB\n", get_memory_usage());
 
+    // Un buffer de registro por bloque de filas, compartido antes del fork
+    registro_crear(&registro, num_procesos, verbosidad, "Proceso");
+
+    // Crear el pool una sola vez: el costo de fork se paga aquí y no en cada
+    // multiplicación
+    double start_pool = get_time_microseconds();
+    pool_procesos_t *pool = pool_crear(num_procesos);
+    double end_pool = get_time_microseconds();
+    printf("Tiempo de creación del pool: %.2f microsegundos\n", end_pool - start_pool);
+
     // Generar matrices A y B con valores aleatorios (secuencial)
     double start_gen = get_time_microseconds();
     srand(time(NULL));
@@ -169,37 +328,33 @@ int main(int argc, char *argv[]) {
     printf("Tiempo de generación de matrices: %.2f microsegundos\n", end_gen - start_gen);
     printf("Memoria después de generar matrices: %zu kB\n\n", get_memory_usage());
 
-    // Calcular filas por proceso
-    int filas_por_proceso = n / num_procesos;
-    int filas_restantes = n % num_procesos;
+    int en_kernels = acumulador_en_kernels(modo_acumulador);
+    modo_acumulador_t modo = en_kernels ? (modo_acumulador_t)modo_acumulador : ACUM_INT32;
+    int tramo = 0;
+    if (en_kernels) {
+        tramo = tramo_periodico(matriz_A, matriz_B, n);
+        printf("Acumulador de los kernels: %s\n\n", nombre_modo_acumulador(modo_acumulador));
+    }
 
-    // Prueba con algoritmo original
+    // Prueba con algoritmo original; las repeticiones reutilizan el pool
     printf("--- ALGORITMO PROCESOS ORIGINAL ---\n");
-    auto start_orig = std::chrono::high_resolution_clock::now();
-    int fila_inicio = 0;
-    for (int i = 0; i < num_procesos; i++) {
-        int fila_fin = fila_inicio + filas_por_proceso;
-        if (i < filas_restantes) fila_fin++;
-        pid_t pid = fork();
-        if (pid == 0) {
-            // Proceso hijo: multiplica su bloque de filas
-            multiplicar_matrices_proceso_original(matriz_A, matriz_B, matriz_C, n, fila_inicio, fila_fin, i);
-            // Liberar memoria en hijo
-            liberar_matriz(matriz_A, n);
-            liberar_matriz(matriz_B, n);
-            munmap(matriz_C, n * n * sizeof(int));
-            exit(0);
-        }
-        // Proceso padre: avanza al siguiente bloque
-        fila_inicio = fila_fin;
+    // La energía se mide por repetición, como el tiempo, sin el volcado del registro
+    double operaciones = 2.0 * n * n * n * repeticiones;
+    double desbalance_orig = 1.0, suma_orig = 0.0;
+    MedidaEnergia energia_orig = ENERGIA_MEDIDA_VACIA;
+    for (int r = 0; r < repeticiones; r++) {
+        LecturaEnergia energia_antes = energia_leer();
+        suma_orig += multiplicar_con_pool(pool, matriz_A, matriz_B, matriz_C, en_kernels ? R64 : NULL, modo, tramo,
+                                          n, num_procesos, 0, &desbalance_orig);
+        LecturaEnergia energia_despues = energia_leer();
+        MedidaEnergia m = energia_diferencia(&energia_antes, &energia_despues);
+        energia_sumar(&energia_orig, &m);
+        registro_volcar(&registro); // fuera del tiempo medido
     }
-    // Esperar a que todos los hijos terminen
-    for (int i = 0; i < num_procesos; i++) {
-        wait(NULL);
-    }
-    auto end_orig = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration_orig = end_orig - start_orig;
-    printf("Tiempo de multiplicación original: %f segundos\n", duration_orig.count());
+    double duration_orig = suma_orig / repeticiones;
+    printf("Tiempo de multiplicación original: %f segundos\n", duration_orig);
+    energia_reportar(repeticiones > 1 ? "original (todas las repeticiones)" : "original", &energia_orig, operaciones);
+    printf("Desbalance de carga (máx/medio): %.2f\n", desbalance_orig);
     printf("Memoria durante multiplicación original: %zu kB\n\n", get_memory_usage());
 
     // Limpiar matriz C para la siguiente prueba
@@ -207,48 +362,51 @@ int main(int argc, char *argv[]) {
 
     // Prueba con algoritmo optimizado
     printf("--- ALGORITMO PROCESOS OPTIMIZADO ---\n");
-    auto start_opt = std::chrono::high_resolution_clock::now();
-    fila_inicio = 0;
-    for (int i = 0; i < num_procesos; i++) {
-        int fila_fin = fila_inicio + filas_por_proceso;
-        if (i < filas_restantes) fila_fin++;
-        pid_t pid = fork();
-        if (pid == 0) {
-            // Proceso hijo: multiplica su bloque de filas
-            multiplicar_matrices_proceso_optimizada(matriz_A, matriz_B, matriz_C, n, fila_inicio, fila_fin, i);
-            // Liberar memoria en hijo
-            liberar_matriz(matriz_A, n);
-            liberar_matriz(matriz_B, n);
-            munmap(matriz_C, n * n * sizeof(int));
-            exit(0);
-        }
-        // Proceso padre: avanza al siguiente bloque
-        fila_inicio = fila_fin;
-    }
-    // Esperar a que todos los hijos terminen
-    for (int i = 0; i < num_procesos; i++) {
-        wait(NULL);
+    double desbalance_opt = 1.0, suma_opt = 0.0;
+    MedidaEnergia energia_opt = ENERGIA_MEDIDA_VACIA;
+    for (int r = 0; r < repeticiones; r++) {
+        LecturaEnergia energia_antes = energia_leer();
+        suma_opt += multiplicar_con_pool(pool, matriz_A, matriz_B, matriz_C, en_kernels ? C64 : NULL, modo, tramo,
+                                         n, num_procesos, 1, &desbalance_opt);
+        LecturaEnergia energia_despues = energia_leer();
+        MedidaEnergia m = energia_diferencia(&energia_antes, &energia_despues);
+        energia_sumar(&energia_opt, &m);
+        registro_volcar(&registro); // fuera del tiempo medido
     }
-    auto end_opt = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration_opt = end_opt - start_opt;
-    printf("Tiempo de multiplicación optimizada: %f segundos\n", duration_opt.count());
+    double duration_opt = suma_opt / repeticiones;
+    printf("Tiempo de multiplicación optimizada: %f segundos\n", duration_opt);
+    energia_reportar(repeticiones > 1 ? "optimizada (todas las repeticiones)" : "optimizada", &energia_opt, operaciones);
+    printf("Desbalance de carga (máx/medio): %.2f\n", desbalance_opt);
     printf("Memoria durante multiplicación optimizada: %zu kB\n\n", get_memory_usage());
 
+    if (en_kernels) {
+        verificar_acumulador(R64, C64, n, modo_acumulador);
+    }
+    if (modo_acumulador == ACUM_TODOS) {
+        comparar_modos_acumulador(matriz_A, matriz_B, C64, R64, n, modo_acumulador, ejecutar_acumulador_pool, pool);
+    }
+
     // Calcular speedup y eficiencia
-    double speedup = duration_orig.count() / duration_opt.count();
+    double speedup = duration_orig / duration_opt;
     double eficiencia = speedup / num_procesos;
     
     printf("=== RESULTADOS DE BENCHMARK ===\n");
     printf("Speedup: %.2fx\n", speedup);
     printf("Eficiencia: %.2f%%\n", eficiencia * 100);
-    printf("Mejora de rendimiento: %.1f%%\n", ((duration_orig.count() - duration_opt.count()) / duration_orig.count()) * 100);
+    printf("Mejora de rendimiento: %.1f%%\n", ((duration_orig - duration_opt) / duration_orig) * 100);
     printf("Memoria final: %zu kB\n", get_memory_usage());
 
-    // Liberar memoria en padre
-    liberar_matriz(matriz_A, n);
-    liberar_matriz(matriz_B, n);
+    // Cerrar el pool y liberar memoria
+    pool_destruir(pool);
+    registro_destruir(&registro);
+    liberar_matriz_compartida(matriz_A, n);
+    liberar_matriz_compartida(matriz_B, n);
     munmap(matriz_C, n * n * sizeof(int));
+    if (C64 != NULL) {
+        munmap(C64, bytes_64);
+        munmap(R64, bytes_64);
+    }
     printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
     return 0;
 }
-// Nota: Se eliminó todo lo relacionado con pthread y mutex, y la generación de matrices es secuencial.
\ No newline at end of file
+// Nota: Los procesos se crean una sola vez en un pool (pool_procesos.h) y reciben los bloques de filas por una cola en memoria compartida.
\ No newline at end of file
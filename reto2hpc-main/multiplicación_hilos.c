@@ -5,6 +5,12 @@
 #include <chrono>
 #include <string.h>
 #include <sys/time.h>
+#include "arena_matrices.h"
+#include "planificador_teselas.h"
+#include "acumuladores.h"
+#include "traza.h"
+#include "registro.h"
+#include "energia.h"
 
 //multiplicacion_hilos_optimizada.c
 // Versión optimizada con mejoras de CPU, memoria y cache
@@ -26,10 +32,13 @@ typedef struct {
     int fila_inicio;
     int fila_fin;
     int hilo_id;
+    int64_t *C64;           // con --acumulador=modo: resultado en 64 bits, en vez de C
+    modo_acumulador_t modo;
+    int tramo;
 } DatosMultiplicacion;
 
 // Variables globales para sincronización
-pthread_mutex_t mutex_print = PTHREAD_MUTEX_INITIALIZER;
+Registro registro; // mensajes de los hilos, volcados fuera de las regiones medidas
 pthread_barrier_t barrier_generacion;
 pthread_barrier_t barrier_multiplicacion;
 
@@ -40,38 +49,33 @@ void* generar_matriz_aleatoria_hilo(void* arg) {
     // Usar semilla diferente para cada hilo basada en tiempo + hilo_id
     unsigned int semilla = time(NULL) + datos->hilo_id * 1000;
     
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Generando matriz %c (%dx%d)...\n", 
-           datos->hilo_id, datos->nombre, datos->n, datos->n);
-    pthread_mutex_unlock(&mutex_print);
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Generando matriz %c (%dx%d)...",
+                      datos->nombre, datos->n, datos->n);
     
+    TRAZA_NOMBRAR_HILO(datos->nombre == 'A' ? "generador A" : "generador B", datos->hilo_id);
+    TRAZA_TRAMO_INICIO(t_generar);
     for (int i = 0; i < datos->n; i++) {
         for (int j = 0; j < datos->n; j++) {
             datos->matriz[i][j] = rand_r(&semilla) % 100;
         }
     }
+    TRAZA_TRAMO_FIN(t_generar, datos->nombre == 'A' ? "generar A" : "generar B", datos->hilo_id);
     
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Matriz %c completada.\n", datos->hilo_id, datos->nombre);
-    pthread_mutex_unlock(&mutex_print);
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Matriz %c completada.", datos->nombre);
     
     pthread_exit(NULL);
 }
 
-// Función para multiplicar matrices por bloques de filas (optimizada)
-void* multiplicar_matrices_hilo_optimizada(void* arg) {
-    DatosMultiplicacion* datos = (DatosMultiplicacion*)arg;
+// Filas del hilo por bloques de kk x jj, acumulando en int
+void multiplicar_filas_por_bloques(DatosMultiplicacion* datos) {
     const int BLOCK_SIZE = 32; // Tamaño de bloque para optimización de cache
-    
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Procesando filas %d a %d (optimizado)\n", 
-           datos->hilo_id, datos->fila_inicio, datos->fila_fin - 1);
-    pthread_mutex_unlock(&mutex_print);
-    
+
     // Inicializar bloque de filas a cero
+    TRAZA_TRAMO_INICIO(t_ceros);
     for (int i = datos->fila_inicio; i < datos->fila_fin; i++) {
         memset(datos->C[i], 0, datos->n * sizeof(int));
     }
+    TRAZA_TRAMO_FIN(t_ceros, "inicializar C", datos->hilo_id);
     
     // Multiplicación por bloques para mejor uso de cache
     for (int kk = 0; kk < datos->n; kk += BLOCK_SIZE) {
@@ -79,6 +83,7 @@ void* multiplicar_matrices_hilo_optimizada(void* arg) {
         
         for (int jj = 0; jj < datos->n; jj += BLOCK_SIZE) {
             int j_end = (jj + BLOCK_SIZE < datos->n) ? jj + BLOCK_SIZE : datos->n;
+            TRAZA_TRAMO_INICIO(t_tesela);
             
             for (int i = datos->fila_inicio; i < datos->fila_fin; i++) {
                 for (int j = jj; j < j_end; j++) {
@@ -89,39 +94,68 @@ void* multiplicar_matrices_hilo_optimizada(void* arg) {
                     datos->C[i][j] = sum;
                 }
             }
+            // id de la tesela: bloque kk * número de bloques + bloque jj
+            TRAZA_TRAMO_FIN(t_tesela, "tesela kk-jj",
+                            (kk / BLOCK_SIZE) * ((datos->n + BLOCK_SIZE - 1) / BLOCK_SIZE) + jj / BLOCK_SIZE);
         }
     }
+}
+
+// Función para multiplicar matrices por bloques de filas (optimizada); con
+// --acumulador=modo usa el kernel i-k-j de acumuladores.h sobre C64
+void* multiplicar_matrices_hilo_optimizada(void* arg) {
+    DatosMultiplicacion* datos = (DatosMultiplicacion*)arg;
+    
+    uint64_t inicio_ns = registro_ahora_ns();
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Procesando filas %d a %d (optimizado)",
+                      datos->fila_inicio, datos->fila_fin - 1);
+    
+    TRAZA_NOMBRAR_HILO("optimizado", datos->hilo_id);
+    if (datos->C64 != NULL) {
+        TRAZA_TRAMO_INICIO(t_acumulador);
+        multiplicar_filas_acumulador(datos->A, datos->B, datos->C64, datos->n,
+                                     datos->fila_inicio, datos->fila_fin, datos->modo, datos->tramo);
+        TRAZA_TRAMO_FIN(t_acumulador, "filas con acumulador", datos->hilo_id);
+    } else {
+        multiplicar_filas_por_bloques(datos);
+    }
     
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Filas %d a %d completadas (optimizado).\n", 
-           datos->hilo_id, datos->fila_inicio, datos->fila_fin - 1);
-    pthread_mutex_unlock(&mutex_print);
+    registro_metrica(&registro, datos->hilo_id, "tiempo_s", (registro_ahora_ns() - inicio_ns) / 1e9);
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Filas %d a %d completadas (optimizado).",
+                      datos->fila_inicio, datos->fila_fin - 1);
     
     pthread_exit(NULL);
 }
 
-// Función para multiplicar matrices por bloques de filas (versión original)
+// Función para multiplicar matrices por bloques de filas (versión original);
+// con --acumulador=modo, un producto punto por elemento en ese modo sobre C64
 void* multiplicar_matrices_hilo_original(void* arg) {
     DatosMultiplicacion* datos = (DatosMultiplicacion*)arg;
     
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Procesando filas %d a %d (original)\n", 
-           datos->hilo_id, datos->fila_inicio, datos->fila_fin - 1);
-    pthread_mutex_unlock(&mutex_print);
+    uint64_t inicio_ns = registro_ahora_ns();
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Procesando filas %d a %d (original)",
+                      datos->fila_inicio, datos->fila_fin - 1);
     
+    TRAZA_NOMBRAR_HILO("original", datos->hilo_id);
     for (int i = datos->fila_inicio; i < datos->fila_fin; i++) {
-        for (int j = 0; j < datos->n; j++) {
-            datos->C[i][j] = 0;
-            for (int k = 0; k < datos->n; k++) {
-                datos->C[i][j] += datos->A[i][k] * datos->B[k][j];
+        TRAZA_TRAMO_INICIO(t_fila);
+        if (datos->C64 != NULL) {
+            multiplicar_filas_acumulador_original(datos->A, datos->B, datos->C64, datos->n, i, i + 1,
+                                                  datos->modo, datos->tramo);
+        } else {
+            for (int j = 0; j < datos->n; j++) {
+                datos->C[i][j] = 0;
+                for (int k = 0; k < datos->n; k++) {
+                    datos->C[i][j] += datos->A[i][k] * datos->B[k][j];
+                }
             }
         }
+        TRAZA_TRAMO_FIN(t_fila, "fila", i);
     }
     
-    pthread_mutex_lock(&mutex_print);
-    printf("Hilo %d: Filas %d a %d completadas (original).\n", 
-           datos->hilo_id, datos->fila_inicio, datos->fila_fin - 1);
-    pthread_mutex_unlock(&mutex_print);
+    registro_metrica(&registro, datos->hilo_id, "tiempo_s", (registro_ahora_ns() - inicio_ns) / 1e9);
+    registro_escribir(&registro, datos->hilo_id, REGISTRO_INFO, "Filas %d a %d completadas (original).",
+                      datos->fila_inicio, datos->fila_fin - 1);
     
     pthread_exit(NULL);
 }
@@ -180,10 +214,242 @@ size_t get_memory_usage() {
     return memory;
 }
 
+// ---------------------------------------------------------------------------
+// Modo pipeline: generación y multiplicación solapadas por teselas
+// ---------------------------------------------------------------------------
+
+#define TESELA_PIPELINE 64
+
+typedef struct {
+    int **A;
+    int **B;
+    int **C;
+    int n;
+    int teselas;          // teselas por lado
+    unsigned int semilla;
+    int generar;          // 0: las tareas de generación no hacen nada
+} ContextoPipeline;
+
+// Numeración de tareas: la generación va por columnas de teselas de A y filas
+// de teselas de B (kk = 0, 1, ...), que es el orden en que las piden las
+// multiplicaciones; después van las multiplicaciones C(ii,jj) += A(ii,kk) B(kk,jj)
+static inline int tarea_generar_A(int nb, int ii, int kk) { return kk * 2 * nb + ii; }
+static inline int tarea_generar_B(int nb, int kk, int jj) { return kk * 2 * nb + nb + jj; }
+static inline int tarea_multiplicar(int nb, int ii, int jj, int kk) {
+    return 2 * nb * nb + (ii * nb + jj) * nb + kk;
+}
+
+void ejecutar_tarea_pipeline(int tarea, void *arg, int hilo) {
+    ContextoPipeline *ctx = (ContextoPipeline *)arg;
+    int nb = ctx->teselas;
+    int n = ctx->n;
+    (void)hilo;
+
+    if (tarea < 2 * nb * nb) {
+        if (!ctx->generar) return;
+        TRAZA_TRAMO_INICIO(t_generar);
+        int kk = tarea / (2 * nb);
+        int r = tarea % (2 * nb);
+        int **matriz = r < nb ? ctx->A : ctx->B;
+        int ti = r < nb ? r : kk;         // fila de teselas
+        int tj = r < nb ? kk : r - nb;    // columna de teselas
+
+        // Semilla por tesela: el contenido no depende del orden de ejecución
+        unsigned int semilla = ctx->semilla + tarea;
+        int i_end = (ti + 1) * TESELA_PIPELINE < n ? (ti + 1) * TESELA_PIPELINE : n;
+        int j_end = (tj + 1) * TESELA_PIPELINE < n ? (tj + 1) * TESELA_PIPELINE : n;
+        for (int i = ti * TESELA_PIPELINE; i < i_end; i++) {
+            for (int j = tj * TESELA_PIPELINE; j < j_end; j++) {
+                matriz[i][j] = rand_r(&semilla) % 100;
+            }
+        }
+        TRAZA_TRAMO_FIN(t_generar, r < nb ? "generar tesela A" : "generar tesela B", tarea);
+        return;
+    }
+
+    int m = tarea - 2 * nb * nb;
+    int kk = (m % nb) * TESELA_PIPELINE;
+    int ii = (m / nb / nb) * TESELA_PIPELINE;
+    int jj = (m / nb % nb) * TESELA_PIPELINE;
+    int i_end = (ii + TESELA_PIPELINE < n) ? ii + TESELA_PIPELINE : n;
+    int j_end = (jj + TESELA_PIPELINE < n) ? jj + TESELA_PIPELINE : n;
+    int k_end = (kk + TESELA_PIPELINE < n) ? kk + TESELA_PIPELINE : n;
+
+    // La primera tesela de la cadena kk inicializa C
+    if (kk == 0) {
+        TRAZA_TRAMO_INICIO(t_ceros);
+        for (int i = ii; i < i_end; i++) {
+            memset(&ctx->C[i][jj], 0, (j_end - jj) * sizeof(int));
+        }
+        TRAZA_TRAMO_FIN(t_ceros, "inicializar tesela C", tarea);
+    }
+    TRAZA_TRAMO_INICIO(t_multiplicar);
+    for (int i = ii; i < i_end; i++) {
+        for (int j = jj; j < j_end; j++) {
+            int sum = ctx->C[i][j];
+            for (int k = kk; k < k_end; k++) {
+                sum += ctx->A[i][k] * ctx->B[k][j];
+            }
+            ctx->C[i][j] = sum;
+        }
+    }
+    TRAZA_TRAMO_FIN(t_multiplicar, "multiplicar tesela", tarea);
+}
+
+// Grafo de teselas: cada multiplicación depende de la tesela de A y de B que
+// lee y de la multiplicación anterior sobre la misma tesela de C
+void construir_grafo_pipeline(PlanificadorTeselas *p, int nb, int con_multiplicacion) {
+    planificador_crear(p, 2 * nb * nb + (con_multiplicacion ? nb * nb * nb : 0));
+    for (int t = 0; t < 2 * nb * nb; t++) {
+        planificador_clase(p, t, PLANIFICADOR_PRODUCCION);
+    }
+    if (!con_multiplicacion) return;
+
+    for (int ii = 0; ii < nb; ii++) {
+        for (int jj = 0; jj < nb; jj++) {
+            for (int kk = 0; kk < nb; kk++) {
+                int tarea = tarea_multiplicar(nb, ii, jj, kk);
+                planificador_arista(p, tarea_generar_A(nb, ii, kk), tarea);
+                planificador_arista(p, tarea_generar_B(nb, kk, jj), tarea);
+                if (kk > 0) planificador_arista(p, tarea_multiplicar(nb, ii, jj, kk - 1), tarea);
+            }
+        }
+    }
+}
+
+static double ejecutar_grafo_pipeline(ContextoPipeline *ctx, int con_multiplicacion,
+                                      int num_productores, int num_consumidores) {
+    PlanificadorTeselas planificador;
+    construir_grafo_pipeline(&planificador, ctx->teselas, con_multiplicacion);
+    planificador_preparar(&planificador);
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    planificador_ejecutar(&planificador, num_productores, num_consumidores, ejecutar_tarea_pipeline, ctx);
+    std::chrono::duration<double> duracion = std::chrono::high_resolution_clock::now() - inicio;
+
+    planificador_destruir(&planificador);
+    return duracion.count();
+}
+
+static unsigned long long suma_verificacion(int **C, int n) {
+    unsigned long long suma = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            suma = suma * 31 + (unsigned int)C[i][j];
+        }
+    }
+    return suma;
+}
+
+// Compara la ejecución por fases (generar todo con los productores y luego
+// multiplicar) con el pipeline, en el que cada multiplicación arranca en
+// cuanto están generadas sus teselas de A y B
+void ejecutar_pipeline(int **A, int **B, int **C, int n, int num_productores, int num_consumidores) {
+    ContextoPipeline ctx = {A, B, C, n, (n + TESELA_PIPELINE - 1) / TESELA_PIPELINE,
+                            (unsigned int)time(NULL), 1};
+
+    printf("--- PIPELINE GENERACIÓN→MULTIPLICACIÓN (teselas %dx%d) ---\n", TESELA_PIPELINE, TESELA_PIPELINE);
+    printf("Hilos productores: %d, hilos de multiplicación: %d\n", num_productores, num_consumidores);
+
+    // Por fases: primero sólo generación, luego sólo multiplicación
+    double tiempo_gen = ejecutar_grafo_pipeline(&ctx, 0, num_productores, num_consumidores);
+    ctx.generar = 0;
+    double tiempo_mult = ejecutar_grafo_pipeline(&ctx, 1, num_productores, num_consumidores);
+    unsigned long long suma_fases = suma_verificacion(C, n);
+
+    // Pipeline: las mismas teselas (mismas semillas) con todo solapado
+    ctx.generar = 1;
+    double tiempo_pipeline = ejecutar_grafo_pipeline(&ctx, 1, num_productores, num_consumidores);
+    int correcto = suma_verificacion(C, n) == suma_fases;
+
+    double suma = tiempo_gen + tiempo_mult;
+    double cota = tiempo_gen > tiempo_mult ? tiempo_gen : tiempo_mult;
+    printf("Tiempo de generación de matrices: %.2f microsegundos\n", tiempo_gen * 1e6);
+    printf("Multiplicación por fases: %f segundos\n", tiempo_mult);
+    printf("Generación + multiplicación por fases: %f segundos\n", suma);
+    printf("Cota max(generación, multiplicación): %f segundos\n", cota);
+    printf("Tiempo de multiplicación pipeline: %f segundos\n", tiempo_pipeline);
+    printf("Pipeline / (generación + multiplicación): %.1f%%\n", tiempo_pipeline / suma * 100);
+    printf("Pipeline / max(generación, multiplicación): %.1f%%\n", tiempo_pipeline / cota * 100);
+    printf("Verificación pipeline vs fases: %s\n", correcto ? "correcta" : "INCORRECTA");
+    printf("Memoria final: %zu kB\n", get_memory_usage());
+}
+
+// Modos de acumulación (--acumulador=todos): un hilo por bloque de filas, con
+// el mismo reparto que los hilos de multiplicación y sin registro por hilo
+typedef struct {
+    DatosMultiplicacion *hilos;
+    int num_hilos;
+} ContextoAcumulador;
+
+void *acumular_filas_hilo(void *arg) {
+    DatosMultiplicacion *datos = (DatosMultiplicacion *)arg;
+    multiplicar_filas_acumulador(datos->A, datos->B, datos->C64, datos->n,
+                                 datos->fila_inicio, datos->fila_fin, datos->modo, datos->tramo);
+    return NULL;
+}
+
+void ejecutar_acumulador_hilos(int **A, int **B, int64_t *C, int n, modo_acumulador_t modo, int tramo, void *contexto) {
+    (void)A; (void)B; (void)n; // ya están en los datos de cada hilo
+    ContextoAcumulador *ctx = (ContextoAcumulador *)contexto;
+    pthread_t hilos[ctx->num_hilos];
+    DatosMultiplicacion datos[ctx->num_hilos];
+    for (int i = 0; i < ctx->num_hilos; i++) {
+        datos[i] = ctx->hilos[i];
+        datos[i].C64 = C;
+        datos[i].modo = modo;
+        datos[i].tramo = tramo;
+        pthread_create(&hilos[i], NULL, acumular_filas_hilo, &datos[i]);
+    }
+    for (int i = 0; i < ctx->num_hilos; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+}
+
+// Libera A, B y C, devolviéndolas a la arena si salieron de ella
+void liberar_matrices(int **A, int **B, int **C, int n, ArenaMatrices *arena) {
+    if (arena != NULL) {
+        // Devolver los bloques y medir cuánto cuesta repetir la asignación
+        arena_liberar_matriz(arena, A);
+        arena_liberar_matriz(arena, B);
+        arena_liberar_matriz(arena, C);
+        arena_comparar_con_malloc(arena, n, 5);
+        arena_destruir(arena);
+    } else {
+        liberar_matriz(A, n);
+        liberar_matriz(B, n);
+        liberar_matriz(C, n);
+    }
+}
+
 int main(int argc, char *argv[]) {
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        printf("Uso: %s <tamaño_matriz> <num_hilos_multiplicacion>\n", argv[0]);
+    tipo_paginas_arena_t paginas_arena = ARENA_PAGINAS_THP;
+    int usar_arena = 0;
+    int num_productores = 0; // > 0 en modo pipeline
+    int modo_acumulador = ACUM_NUM_MODOS; // sin --acumulador
+    int verbosidad = REGISTRO_INFO;
+    int opciones_validas = argc >= 3;
+    for (int a = 3; a < argc; a++) {
+        if (parse_opcion_arena(argv[a], &paginas_arena) == 0) {
+            usar_arena = 1;
+        } else if (strcmp(argv[a], "--pipeline") == 0) {
+            num_productores = 2;
+        } else if (strncmp(argv[a], "--pipeline=", 11) == 0 && atoi(argv[a] + 11) > 0) {
+            num_productores = atoi(argv[a] + 11);
+        } else if (parse_opcion_acumulador(argv[a], &modo_acumulador) != 0 &&
+                   parse_opcion_verbosidad(argv[a], &verbosidad) != 0) {
+            opciones_validas = 0;
+        }
+    }
+    // El modo pipeline no pasa por la comparación de acumuladores
+    if (num_productores > 0 && modo_acumulador != ACUM_NUM_MODOS) {
+        opciones_validas = 0;
+    }
+    if (!opciones_validas) {
+        printf("Uso: %s <tamaño_matriz> <num_hilos_multiplicacion> [--arena[=thp|hugetlb|normal]] [--pipeline[=productores]] [--acumulador=int32|saturado|int64|periodico|todos] [--verbosidad=0|1|2]\n", argv[0]);
+        printf("  --acumulador=modo: los kernels original y optimizado acumulan en ese modo; todos: costo de cada modo\n");
+        printf("  --pipeline y --acumulador no se pueden combinar\n");
         printf("Ejemplo: %s 1000 4\n", argv[0]);
         return 1;
     }
@@ -206,17 +472,42 @@ int main(int argc, char *argv[]) {
     printf("=== MULTIPLICACIÓN DE MATRICES CON HILOS OPTIMIZADA ===\n");
     printf("Tamaño de matriz: %dx%d\n", n, n);
     printf("Hilos para multiplicación: %d\n", num_hilos_mult);
+    if (num_productores > 0) {
+        printf("Modo pipeline: %d hilos productores\n", num_productores);
+    }
+    if (usar_arena) {
+        printf("Arena de matrices: %s\n", nombre_paginas_arena(paginas_arena));
+    }
     printf("Memoria inicial: %zu kB\n\n", get_memory_usage());
 
+    // Un buffer de registro por hilo (los generadores usan los ids 1 y 2)
+    registro_crear(&registro, num_hilos_mult > 2 ? num_hilos_mult : 3, verbosidad, "Hilo");
+
     // Inicializar barreras
     pthread_barrier_init(&barrier_generacion, NULL, 2);
     pthread_barrier_init(&barrier_multiplicacion, NULL, num_hilos_mult);
 
-    int **matriz_A = crear_matriz(n);
-    int **matriz_B = crear_matriz(n);
-    int **matriz_C = crear_matriz(n);
+    // Con --arena las tres matrices salen de una sola reserva prefaultada
+    ArenaMatrices arena;
+    if (usar_arena) {
+        arena_crear(&arena, 3 * arena_tam_matriz(n), paginas_arena, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    int **matriz_A = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_B = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
+    int **matriz_C = usar_arena ? arena_crear_matriz(&arena, n) : crear_matriz(n);
     
     printf("Memoria después de crear matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras crear matrices: %ld\n", arena_fallos_de_pagina());
+
+    if (num_productores > 0) {
+        printf("\n");
+        ejecutar_pipeline(matriz_A, matriz_B, matriz_C, n, num_productores, num_hilos_mult);
+        TRAZA_VOLCAR("traza_pthread.json");
+        registro_destruir(&registro);
+        liberar_matrices(matriz_A, matriz_B, matriz_C, n, usar_arena ? &arena : NULL);
+        printf("=== PROGRAMA COMPLETADO EXITOSAMENTE ===\n");
+        return 0;
+    }
     
     pthread_t hilo_A, hilo_B;
     DatosMatriz datos_A = {matriz_A, n, 1, 'A'};
@@ -229,9 +520,21 @@ int main(int argc, char *argv[]) {
     pthread_join(hilo_A, NULL);
     pthread_join(hilo_B, NULL);
     double end_gen = get_time_microseconds();
+    registro_volcar(&registro);
     
     printf("Tiempo de generación de matrices: %.2f microsegundos\n", end_gen - start_gen);
-    printf("Memoria después de generar matrices: %zu kB\n\n", get_memory_usage());
+    printf("Memoria después de generar matrices: %zu kB\n", get_memory_usage());
+    printf("Fallos de página tras generar matrices: %ld\n\n", arena_fallos_de_pagina());
+
+    // Con --acumulador=modo los dos kernels medidos escriben C en 64 bits
+    int64_t *C64_orig = NULL, *C64_opt = NULL;
+    int tramo = 0;
+    if (acumulador_en_kernels(modo_acumulador)) {
+        C64_orig = crear_resultado_acumulador(n);
+        C64_opt = crear_resultado_acumulador(n);
+        tramo = tramo_periodico(matriz_A, matriz_B, n);
+        printf("Acumulador de los kernels: %s\n\n", nombre_modo_acumulador(modo_acumulador));
+    }
 
     pthread_t hilos_mult[num_hilos_mult];
     DatosMultiplicacion datos_mult[num_hilos_mult];
@@ -250,10 +553,15 @@ int main(int argc, char *argv[]) {
         datos_mult[i].fila_fin = fila_inicio + filas_por_hilo;
         if (i < filas_restantes) datos_mult[i].fila_fin++;
         fila_inicio = datos_mult[i].fila_fin;
+        datos_mult[i].C64 = C64_orig;
+        datos_mult[i].modo = (modo_acumulador_t)modo_acumulador;
+        datos_mult[i].tramo = tramo;
     }
 
     // Prueba con algoritmo original
     printf("--- ALGORITMO PTHREAD ORIGINAL ---\n");
+    double operaciones = 2.0 * n * n * n;
+    LecturaEnergia energia_antes = energia_leer();
     auto start_orig = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < num_hilos_mult; i++) {
         pthread_create(&hilos_mult[i], NULL, multiplicar_matrices_hilo_original, &datos_mult[i]);
@@ -262,8 +570,12 @@ int main(int argc, char *argv[]) {
         pthread_join(hilos_mult[i], NULL);
     }
     auto end_orig = std::chrono::high_resolution_clock::now();
+    LecturaEnergia energia_despues = energia_leer();
     std::chrono::duration<double> duration_orig = end_orig - start_orig;
+    registro_volcar(&registro);
     printf("Tiempo de multiplicación original: %f segundos\n", duration_orig.count());
+    MedidaEnergia energia_orig = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("original", &energia_orig, operaciones);
     printf("Memoria durante multiplicación original: %zu kB\n\n", get_memory_usage());
 
     // Limpiar matriz C para la siguiente prueba
@@ -273,6 +585,10 @@ int main(int argc, char *argv[]) {
 
     // Prueba con algoritmo optimizado
     printf("--- ALGORITMO PTHREAD OPTIMIZADO ---\n");
+    for (int i = 0; i < num_hilos_mult; i++) {
+        datos_mult[i].C64 = C64_opt;
+    }
+    energia_antes = energia_leer();
     auto start_opt = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < num_hilos_mult; i++) {
         pthread_create(&hilos_mult[i], NULL, multiplicar_matrices_hilo_optimizada, &datos_mult[i]);
@@ -281,10 +597,34 @@ int main(int argc, char *argv[]) {
         pthread_join(hilos_mult[i], NULL);
     }
     auto end_opt = std::chrono::high_resolution_clock::now();
+    energia_despues = energia_leer();
     std::chrono::duration<double> duration_opt = end_opt - start_opt;
+    registro_volcar(&registro);
     printf("Tiempo de multiplicación optimizada: %f segundos\n", duration_opt.count());
+    MedidaEnergia energia_opt = energia_diferencia(&energia_antes, &energia_despues);
+    energia_reportar("optimizada", &energia_opt, operaciones);
     printf("Memoria durante multiplicación optimizada: %zu kB\n\n", get_memory_usage());
 
+    if (C64_opt != NULL) {
+        verificar_acumulador(C64_orig, C64_opt, n, modo_acumulador);
+        free(C64_orig);
+        free(C64_opt);
+    }
+
+    if (modo_acumulador == ACUM_TODOS) {
+        int64_t *C64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        int64_t *R64 = (int64_t *)malloc((size_t)n * n * sizeof(int64_t));
+        if (C64 == NULL || R64 == NULL) {
+            printf("Error: No se pudo asignar memoria para los resultados de 64 bits\n");
+            exit(1);
+        }
+        ContextoAcumulador contexto_acumulador = {datos_mult, num_hilos_mult};
+        comparar_modos_acumulador(matriz_A, matriz_B, C64, R64, n, modo_acumulador,
+                                  ejecutar_acumulador_hilos, &contexto_acumulador);
+        free(C64);
+        free(R64);
+    }
+
     // Calcular speedup y eficiencia
     double speedup = duration_orig.count() / duration_opt.count();
     double eficiencia = speedup / num_hilos_mult;
@@ -294,12 +634,11 @@ int main(int argc, char *argv[]) {
     printf("Eficiencia: %.2f%%\n", eficiencia * 100);
     printf("Mejora de rendimiento: %.1f%%\n", ((duration_orig.count() - duration_opt.count()) / duration_orig.count()) * 100);
     printf("Memoria final: %zu kB\n", get_memory_usage());
+    TRAZA_VOLCAR("traza_pthread.json");
 
     // Liberar recursos
-    liberar_matriz(matriz_A, n);
-    liberar_matriz(matriz_B, n);
-    liberar_matriz(matriz_C, n);
-    pthread_mutex_destroy(&mutex_print);
+    liberar_matrices(matriz_A, matriz_B, matriz_C, n, usar_arena ? &arena : NULL);
+    registro_destruir(&registro);
     pthread_barrier_destroy(&barrier_generacion);
     pthread_barrier_destroy(&barrier_multiplicacion);
     
@@ -0,0 +1,215 @@
+#ifndef PLANIFICADOR_TESELAS_H
+#define PLANIFICADOR_TESELAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "traza.h"
+
+// Planificador de tareas con dependencias para trabajo por teselas. El grafo
+// se declara con planificador_arista(origen, destino) y cada tarea lleva un
+// contador de dependencias pendientes: cuando llega a cero la tarea pasa a la
+// cola de listas y la toma el primer hilo libre que pueda ejecutarla.
+//
+// Las tareas son de producción (generan o cargan teselas) o de consumo (las
+// usan). Los hilos productores toman primero tareas de producción y, cuando
+// no quedan, ayudan con las de consumo; los consumidores sólo consumen. Las
+// listas se encolan en orden de número de tarea, así que numerar las tareas
+// de producción en el orden en que conviene producir las teselas basta para
+// que el consumo empiece cuanto antes.
+//
+// Los contadores de dependencias se consumen al ejecutar: cada grafo se
+// ejecuta una sola vez.
+
+#define PLANIFICADOR_PRODUCCION 0
+#define PLANIFICADOR_CONSUMO 1
+
+typedef void (*planificador_funcion_t)(int tarea, void *contexto, int hilo);
+
+typedef struct {
+    int num_tareas;
+    int *pendientes;       // dependencias sin resolver de cada tarea
+    unsigned char *clase;  // PLANIFICADOR_PRODUCCION o PLANIFICADOR_CONSUMO
+
+    // Aristas: primero como lista (origen, destino), luego en formato CSR
+    int num_aristas;
+    int capacidad_aristas;
+    int *origen;
+    int *destino;
+    int *inicio_sucesores;
+    int *sucesores;
+
+    // Colas de tareas listas, una por clase; cada tarea entra una vez
+    int *listas[2];
+    int cabeza[2];
+    int fin[2];
+    int completadas;
+    pthread_mutex_t mutex;
+    pthread_cond_t hay_trabajo;
+
+    planificador_funcion_t funcion;
+    void *contexto;
+} PlanificadorTeselas;
+
+static inline void planificador_crear(PlanificadorTeselas *p, int num_tareas) {
+    memset(p, 0, sizeof(*p));
+    p->num_tareas = num_tareas;
+    p->pendientes = (int *)calloc(num_tareas, sizeof(int));
+    p->clase = (unsigned char *)calloc(num_tareas, 1);
+    p->capacidad_aristas = num_tareas;
+    p->origen = (int *)malloc(p->capacidad_aristas * sizeof(int));
+    p->destino = (int *)malloc(p->capacidad_aristas * sizeof(int));
+    p->inicio_sucesores = (int *)calloc(num_tareas + 1, sizeof(int));
+    p->listas[0] = (int *)malloc(num_tareas * sizeof(int));
+    p->listas[1] = (int *)malloc(num_tareas * sizeof(int));
+    if (p->pendientes == NULL || p->clase == NULL || p->origen == NULL || p->destino == NULL ||
+        p->inicio_sucesores == NULL || p->listas[0] == NULL || p->listas[1] == NULL) {
+        printf("Error: No se pudo asignar memoria para el planificador\n");
+        exit(1);
+    }
+    for (int t = 0; t < num_tareas; t++) {
+        p->clase[t] = PLANIFICADOR_CONSUMO;
+    }
+}
+
+static inline void planificador_clase(PlanificadorTeselas *p, int tarea, int clase) {
+    p->clase[tarea] = (unsigned char)clase;
+}
+
+// destino no puede empezar hasta que termine origen
+static inline void planificador_arista(PlanificadorTeselas *p, int origen, int destino) {
+    if (p->num_aristas == p->capacidad_aristas) {
+        p->capacidad_aristas *= 2;
+        p->origen = (int *)realloc(p->origen, p->capacidad_aristas * sizeof(int));
+        p->destino = (int *)realloc(p->destino, p->capacidad_aristas * sizeof(int));
+        if (p->origen == NULL || p->destino == NULL) {
+            printf("Error: No se pudo asignar memoria para el planificador\n");
+            exit(1);
+        }
+    }
+    p->origen[p->num_aristas] = origen;
+    p->destino[p->num_aristas] = destino;
+    p->num_aristas++;
+    p->pendientes[destino]++;
+}
+
+// Pasa las aristas a formato CSR (sucesores de cada tarea contiguos)
+static inline void planificador_preparar(PlanificadorTeselas *p) {
+    for (int e = 0; e < p->num_aristas; e++) {
+        p->inicio_sucesores[p->origen[e] + 1]++;
+    }
+    for (int t = 0; t < p->num_tareas; t++) {
+        p->inicio_sucesores[t + 1] += p->inicio_sucesores[t];
+    }
+    p->sucesores = (int *)malloc((p->num_aristas > 0 ? p->num_aristas : 1) * sizeof(int));
+    int *siguiente = (int *)malloc(p->num_tareas * sizeof(int));
+    memcpy(siguiente, p->inicio_sucesores, p->num_tareas * sizeof(int));
+    for (int e = 0; e < p->num_aristas; e++) {
+        p->sucesores[siguiente[p->origen[e]]++] = p->destino[e];
+    }
+    free(siguiente);
+}
+
+// Con el mutex tomado
+static inline void planificador_encolar(PlanificadorTeselas *p, int tarea) {
+    int clase = p->clase[tarea];
+    p->listas[clase][p->fin[clase]++] = tarea;
+}
+
+typedef struct {
+    PlanificadorTeselas *planificador;
+    int hilo;
+    int productor;
+} ArgumentoPlanificador;
+
+static inline void *planificador_trabajador(void *arg) {
+    ArgumentoPlanificador *a = (ArgumentoPlanificador *)arg;
+    PlanificadorTeselas *p = a->planificador;
+    TRAZA_NOMBRAR_HILO(a->productor ? "productor" : "consumidor", a->hilo);
+
+    pthread_mutex_lock(&p->mutex);
+    for (;;) {
+        int hay_produccion = a->productor && p->cabeza[PLANIFICADOR_PRODUCCION] < p->fin[PLANIFICADOR_PRODUCCION];
+        int hay_consumo = p->cabeza[PLANIFICADOR_CONSUMO] < p->fin[PLANIFICADOR_CONSUMO];
+        if (p->completadas == p->num_tareas) break;
+        if (!hay_produccion && !hay_consumo) {
+            TRAZA_TRAMO_INICIO(t_espera);
+            pthread_cond_wait(&p->hay_trabajo, &p->mutex);
+            TRAZA_TRAMO_FIN(t_espera, "espera dependencias", -1);
+            continue;
+        }
+
+        int clase = hay_produccion ? PLANIFICADOR_PRODUCCION : PLANIFICADOR_CONSUMO;
+        int tarea = p->listas[clase][p->cabeza[clase]++];
+        pthread_mutex_unlock(&p->mutex);
+
+        p->funcion(tarea, p->contexto, a->hilo);
+
+        // Liberar sucesores: quien resuelve la última dependencia la encola
+        int listas_nuevas = 0;
+        pthread_mutex_lock(&p->mutex);
+        for (int s = p->inicio_sucesores[tarea]; s < p->inicio_sucesores[tarea + 1]; s++) {
+            int sucesor = p->sucesores[s];
+            if (--p->pendientes[sucesor] == 0) {
+                planificador_encolar(p, sucesor);
+                listas_nuevas++;
+            }
+        }
+        p->completadas++;
+        // Broadcast: no todos los hilos pueden tomar cualquier clase de tarea
+        if (listas_nuevas > 0 || p->completadas == p->num_tareas) {
+            pthread_cond_broadcast(&p->hay_trabajo);
+        }
+    }
+    pthread_mutex_unlock(&p->mutex);
+    return NULL;
+}
+
+// Ejecuta todas las tareas respetando las dependencias con num_productores
+// hilos productores seguidos de num_consumidores consumidores; la función
+// recibe el número de hilo (los productores son los primeros)
+static inline void planificador_ejecutar(PlanificadorTeselas *p, int num_productores, int num_consumidores,
+                                         planificador_funcion_t funcion, void *contexto) {
+    int num_hilos = num_productores + num_consumidores;
+    if (p->sucesores == NULL) planificador_preparar(p);
+    p->funcion = funcion;
+    p->contexto = contexto;
+    p->completadas = 0;
+    p->cabeza[0] = p->fin[0] = p->cabeza[1] = p->fin[1] = 0;
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->hay_trabajo, NULL);
+
+    for (int t = 0; t < p->num_tareas; t++) {
+        if (p->pendientes[t] == 0) planificador_encolar(p, t);
+    }
+
+    pthread_t *hilos = (pthread_t *)malloc(num_hilos * sizeof(pthread_t));
+    ArgumentoPlanificador *args = (ArgumentoPlanificador *)malloc(num_hilos * sizeof(ArgumentoPlanificador));
+    for (int h = 0; h < num_hilos; h++) {
+        args[h].planificador = p;
+        args[h].hilo = h;
+        args[h].productor = h < num_productores;
+        pthread_create(&hilos[h], NULL, planificador_trabajador, &args[h]);
+    }
+    for (int h = 0; h < num_hilos; h++) {
+        pthread_join(hilos[h], NULL);
+    }
+    free(hilos);
+    free(args);
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->hay_trabajo);
+}
+
+static inline void planificador_destruir(PlanificadorTeselas *p) {
+    free(p->pendientes);
+    free(p->clase);
+    free(p->origen);
+    free(p->destino);
+    free(p->inicio_sucesores);
+    free(p->sucesores);
+    free(p->listas[0]);
+    free(p->listas[1]);
+}
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef POOL_PROCESOS_H
+#define POOL_PROCESOS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Pool de procesos pre-creados: los hijos se crean una sola vez con fork()
+// y atienden trabajos de una cola en memoria compartida, de modo que el
+// costo de fork y de copiar tablas de páginas se paga una vez y no en cada
+// ejecución. Las esperas usan futex compartidos entre procesos.
+//
+// Los datos de cada trabajo se copian en la cola, así que no pueden apuntar
+// a memoria privada del padre reservada después de pool_crear(): todo lo que
+// los hijos deban leer (matrices, parámetros) tiene que existir antes del
+// fork o vivir en memoria compartida (MAP_SHARED).
+//
+// Si un hijo muere mientras ejecuta un trabajo, pool_esperar() lo detecta,
+// marca el trabajo como fallido y crea un hijo de reemplazo. Para que ningún
+// trabajo se pierda entre reclamarlo y anotarlo, reclamar es un solo CAS que
+// escribe en la entrada de la cola quién la tomó, y terminar es una sola
+// escritura en el contador del trabajador (trabajos hechos y último ticket):
+// de un hijo muerto se sabe siempre si su último trabajo terminó o no.
+
+#define POOL_MAX_TRABAJADORES 256
+#define POOL_COLA 1024
+#define POOL_TAM_DATOS 512
+
+typedef void (*pool_funcion_t)(const void* datos, void* ranura, int trabajador);
+
+// Dueño de una entrada de la cola: ticket en los 32 bits altos (evita que un
+// hijo con un ticket viejo reclame la entrada ya reutilizada) y trabajador + 1
+// en los bajos (0: publicada sin reclamar, POOL_DUENO_FALLIDO: sin usar o su
+// trabajador murió)
+#define POOL_DUENO_FALLIDO 0xffffffffu
+#define POOL_PAR(alto, bajo) (((uint64_t)(alto) << 32) | (uint32_t)(bajo))
+
+typedef struct {
+    uint64_t reclamo;
+    pool_funcion_t funcion;
+    int ranura;
+    unsigned char datos[POOL_TAM_DATOS];
+} pool_trabajo_t;
+
+// Ranura de resultado alineada a línea de cache: cada trabajo escribe en la
+// suya sin falso compartido con las demás
+typedef struct {
+    unsigned char datos[64];
+} __attribute__((aligned(64))) pool_ranura_t;
+
+// Progreso por trabajador, en su propia línea de cache: trabajos hechos en
+// los 32 bits altos y último ticket terminado en los bajos, escritos
+// juntos al terminar cada trabajo. Sobrevive al reemplazo del hijo
+typedef struct {
+    uint64_t progreso;
+} __attribute__((aligned(64))) pool_estado_trabajador_t;
+
+typedef struct {
+    // Contadores de la cola (cada uno en su línea de cache)
+    uint32_t publicados __attribute__((aligned(64)));  // futex de los hijos
+    uint32_t siguiente __attribute__((aligned(64)));   // próximo ticket a reclamar
+    uint32_t avisos __attribute__((aligned(64)));      // futex del padre: algún trabajo terminó
+    uint32_t cerrar __attribute__((aligned(64)));
+    pool_estado_trabajador_t estado[POOL_MAX_TRABAJADORES];
+    pool_ranura_t ranuras[POOL_MAX_TRABAJADORES];
+    pool_trabajo_t cola[POOL_COLA];
+} pool_compartido_t;
+
+typedef struct {
+    pool_compartido_t* compartido;
+    pid_t pids[POOL_MAX_TRABAJADORES];
+    int num_trabajadores;
+    uint32_t enviados;
+    uint32_t fallidos_total; // trabajos de hijos muertos, cuentan como terminados
+    int fallidos;            // desde la última llamada a pool_esperar
+} pool_procesos_t;
+
+static inline long pool_futex(uint32_t* direccion, int operacion, uint32_t valor,
+                              const struct timespec* timeout) {
+    // Sin FUTEX_PRIVATE_FLAG: la palabra vive en memoria compartida entre procesos
+    return syscall(SYS_futex, direccion, operacion, valor, timeout, NULL, 0);
+}
+
+static inline void pool_bucle_trabajador(pool_compartido_t* c, int trabajador) {
+    for (;;) {
+        uint32_t publicados = __atomic_load_n(&c->publicados, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&c->cerrar, __ATOMIC_ACQUIRE)) {
+            _exit(0);
+        }
+
+        // publicados se leyó antes que siguiente: si no hay tickets por debajo
+        // de ese valor, dormir hasta que cambie (si ya cambió, no se duerme)
+        uint32_t ticket = __atomic_load_n(&c->siguiente, __ATOMIC_RELAXED);
+        if ((int32_t)(publicados - ticket) <= 0) {
+            pool_futex(&c->publicados, FUTEX_WAIT, publicados, NULL);
+            continue;
+        }
+        // Reclamar es el CAS sobre el dueño de la entrada; avanzar siguiente
+        // después lo puede hacer cualquiera (quien pierde el CAS ayuda)
+        pool_trabajo_t* trabajo = &c->cola[ticket % POOL_COLA];
+        uint64_t libre = POOL_PAR(ticket, 0);
+        int reclamado = __atomic_compare_exchange_n(&trabajo->reclamo, &libre, POOL_PAR(ticket, trabajador + 1),
+                                                    0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+        uint32_t esperado = ticket;
+        __atomic_compare_exchange_n(&c->siguiente, &esperado, ticket + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+        if (!reclamado) {
+            continue;
+        }
+
+        trabajo->funcion(trabajo->datos, &c->ranuras[trabajo->ranura], trabajador);
+
+        uint64_t progreso = __atomic_load_n(&c->estado[trabajador].progreso, __ATOMIC_RELAXED);
+        __atomic_store_n(&c->estado[trabajador].progreso, POOL_PAR((progreso >> 32) + 1, ticket), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&c->avisos, 1, __ATOMIC_ACQ_REL);
+        pool_futex(&c->avisos, FUTEX_WAKE, 1, NULL);
+    }
+}
+
+static inline pid_t pool_lanzar_trabajador(pool_procesos_t* pool, int trabajador) {
+    pid_t pid = fork();
+    if (pid == 0) { // Proceso hijo
+        pool_bucle_trabajador(pool->compartido, trabajador);
+    } else if (pid < 0) {
+        perror("fork failed");
+        exit(1);
+    }
+    pool->pids[trabajador] = pid;
+    return pid;
+}
+
+static inline pool_procesos_t* pool_crear(int num_trabajadores) {
+    if (num_trabajadores < 1) num_trabajadores = 1;
+    if (num_trabajadores > POOL_MAX_TRABAJADORES) num_trabajadores = POOL_MAX_TRABAJADORES;
+
+    pool_procesos_t* pool = (pool_procesos_t*)calloc(1, sizeof(pool_procesos_t));
+    pool->compartido = (pool_compartido_t*)mmap(NULL, sizeof(pool_compartido_t),
+                                                PROT_READ | PROT_WRITE,
+                                                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (pool->compartido == MAP_FAILED) {
+        perror("mmap failed");
+        exit(1);
+    }
+    pool->num_trabajadores = num_trabajadores;
+    for (int e = 0; e < POOL_COLA; e++) {
+        pool->compartido->cola[e].reclamo = POOL_PAR(0, POOL_DUENO_FALLIDO);
+    }
+
+    // Vaciar buffers antes del fork para que los hijos no repitan salida
+    fflush(NULL);
+    for (int t = 0; t < num_trabajadores; t++) {
+        pool_lanzar_trabajador(pool, t);
+    }
+    return pool;
+}
+
+static inline int pool_num_trabajadores(const pool_procesos_t* pool) {
+    return pool->num_trabajadores;
+}
+
+static inline void* pool_ranura(pool_procesos_t* pool, int ranura) {
+    return pool->compartido->ranuras[ranura].datos;
+}
+
+// Trabajos terminados: los hechos por todos los trabajadores más los que
+// fallaron porque su proceso murió
+static inline uint32_t pool_terminados(const pool_procesos_t* pool) {
+    uint32_t terminados = pool->fallidos_total;
+    for (int t = 0; t < pool->num_trabajadores; t++) {
+        terminados += (uint32_t)(__atomic_load_n(&pool->compartido->estado[t].progreso, __ATOMIC_ACQUIRE) >> 32);
+    }
+    return terminados;
+}
+
+// Un trabajador reclama de a un trabajo y en orden de ticket, así que de los
+// que tomó solo el de ticket mayor puede no haber terminado: si es posterior
+// al último que registra su progreso, el proceso murió en él y cuenta como
+// fallido
+static inline void pool_recuperar_trabajo(pool_procesos_t* pool, int trabajador) {
+    pool_compartido_t* c = pool->compartido;
+    uint64_t progreso = __atomic_load_n(&c->estado[trabajador].progreso, __ATOMIC_ACQUIRE);
+    pool_trabajo_t* ultimo = NULL;
+    for (int e = 0; e < POOL_COLA; e++) {
+        uint64_t reclamo = __atomic_load_n(&c->cola[e].reclamo, __ATOMIC_ACQUIRE);
+        uint32_t ticket = (uint32_t)(reclamo >> 32);
+        if ((uint32_t)reclamo != (uint32_t)(trabajador + 1) || (int32_t)(pool->enviados - ticket) <= 0) {
+            continue;
+        }
+        if (ultimo == NULL || (int32_t)(ticket - (uint32_t)(ultimo->reclamo >> 32)) > 0) {
+            ultimo = &c->cola[e];
+        }
+    }
+    if (ultimo == NULL) return;
+    uint32_t ticket = (uint32_t)(ultimo->reclamo >> 32);
+    if ((progreso >> 32) != 0 && (int32_t)(ticket - (uint32_t)progreso) <= 0) return;
+    __atomic_store_n(&ultimo->reclamo, POOL_PAR(ticket, POOL_DUENO_FALLIDO), __ATOMIC_RELEASE);
+    pool->fallidos++;
+    pool->fallidos_total++;
+}
+
+// Una entrada de la cola se puede reutilizar cuando su trabajo terminó o
+// falló; con trabajos que terminan en desorden, que haya menos de POOL_COLA
+// pendientes no basta
+static inline int pool_entrada_libre(const pool_procesos_t* pool, const pool_trabajo_t* trabajo) {
+    uint64_t reclamo = __atomic_load_n(&trabajo->reclamo, __ATOMIC_ACQUIRE);
+    uint32_t dueno = (uint32_t)reclamo;
+    if (dueno == POOL_DUENO_FALLIDO) return 1;
+    if (dueno == 0) return 0;
+    uint64_t progreso = __atomic_load_n(&pool->compartido->estado[dueno - 1].progreso, __ATOMIC_ACQUIRE);
+    return (progreso >> 32) != 0 && (int32_t)((uint32_t)(reclamo >> 32) - (uint32_t)progreso) <= 0;
+}
+
+// Revisa si algún hijo murió: su trabajo en curso cuenta como fallido y se
+// crea un hijo nuevo en su lugar
+static inline void pool_revisar_trabajadores(pool_procesos_t* pool) {
+    for (int t = 0; t < pool->num_trabajadores; t++) {
+        int status;
+        if (waitpid(pool->pids[t], &status, WNOHANG) != pool->pids[t]) {
+            continue;
+        }
+        fprintf(stderr, "Error: el trabajador %d (pid %d) terminó de forma anormal\n",
+                t, (int)pool->pids[t]);
+        pool_recuperar_trabajo(pool, t);
+        fflush(NULL);
+        pool_lanzar_trabajador(pool, t);
+    }
+}
+
+// Espera hasta que queden a lo sumo max_pendientes trabajos sin terminar
+static inline void pool_esperar_hasta(pool_procesos_t* pool, uint32_t max_pendientes) {
+    pool_compartido_t* c = pool->compartido;
+    // Timeout corto para poder revisar periódicamente si algún hijo murió
+    struct timespec timeout = {0, 10 * 1000 * 1000};
+
+    for (;;) {
+        uint32_t avisos = __atomic_load_n(&c->avisos, __ATOMIC_ACQUIRE);
+        if (pool->enviados - pool_terminados(pool) <= max_pendientes) {
+            return;
+        }
+        pool_futex(&c->avisos, FUTEX_WAIT, avisos, &timeout);
+        pool_revisar_trabajadores(pool);
+    }
+}
+
+// Encola un trabajo: datos (tam <= POOL_TAM_DATOS bytes) se copia a la cola y
+// funcion lo recibe en el hijo junto con la ranura de resultado indicada
+static inline void pool_enviar(pool_procesos_t* pool, pool_funcion_t funcion,
+                               const void* datos, size_t tam, int ranura) {
+    if (tam > POOL_TAM_DATOS || ranura < 0 || ranura >= POOL_MAX_TRABAJADORES) {
+        fprintf(stderr, "Error: trabajo inválido para el pool (%zu bytes, ranura %d)\n", tam, ranura);
+        exit(1);
+    }
+    // No sobrescribir entradas de la cola que aún no se han terminado
+    pool_esperar_hasta(pool, POOL_COLA - 1);
+
+    pool_compartido_t* c = pool->compartido;
+    pool_trabajo_t* trabajo = &c->cola[pool->enviados % POOL_COLA];
+    struct timespec timeout = {0, 10 * 1000 * 1000};
+    for (;;) {
+        uint32_t avisos = __atomic_load_n(&c->avisos, __ATOMIC_ACQUIRE);
+        if (pool_entrada_libre(pool, trabajo)) {
+            break;
+        }
+        pool_futex(&c->avisos, FUTEX_WAIT, avisos, &timeout);
+        pool_revisar_trabajadores(pool);
+    }
+    __atomic_store_n(&trabajo->reclamo, POOL_PAR(pool->enviados, 0), __ATOMIC_RELAXED);
+    trabajo->funcion = funcion;
+    trabajo->ranura = ranura;
+    memcpy(trabajo->datos, datos, tam);
+
+    pool->enviados++;
+    __atomic_store_n(&c->publicados, pool->enviados, __ATOMIC_RELEASE);
+    pool_futex(&c->publicados, FUTEX_WAKE, 1, NULL);
+}
+
+// Espera a que terminen todos los trabajos enviados. Devuelve el número de
+// trabajos que fallaron porque su proceso murió desde la última llamada.
+static inline int pool_esperar(pool_procesos_t* pool) {
+    pool_esperar_hasta(pool, 0);
+    int fallidos = pool->fallidos;
+    pool->fallidos = 0;
+    return fallidos;
+}
+
+static inline void pool_destruir(pool_procesos_t* pool) {
+    pool_compartido_t* c = pool->compartido;
+    __atomic_store_n(&c->cerrar, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&c->publicados, 1, __ATOMIC_ACQ_REL);
+    pool_futex(&c->publicados, FUTEX_WAKE, INT_MAX, NULL);
+
+    for (int t = 0; t < pool->num_trabajadores; t++) {
+        waitpid(pool->pids[t], NULL, 0);
+    }
+    munmap(c, sizeof(pool_compartido_t));
+    free(pool);
+}
+
+#endif
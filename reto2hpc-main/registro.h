@@ -0,0 +1,241 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+// Registro asíncrono para los hilos y procesos trabajadores. Cada escritor
+// (hilo o proceso del pool) tiene su propio buffer circular de un solo
+// productor: escribir es formatear el mensaje y publicar el índice con un
+// store atómico, sin mutex ni E/S. Un hilo volcador en el proceso principal
+// junta los buffers, ordena las entradas por tiempo y las imprime cuando se
+// le pide, después de detener el cronómetro, así que las medidas no incluyen
+// printf ni la contención por stdout.
+//
+// Los buffers están en memoria compartida (MAP_SHARED): si el registro se
+// crea antes del fork, los procesos hijos escriben en los mismos buffers que
+// vuelca el padre. El volcador se lanza en el primer volcado, ya con los
+// hijos creados.
+//
+// Niveles: 0 silencio, 1 info (los mensajes de siempre), 2 detalle (además
+// métricas por trabajador, como su tiempo de cómputo).
+
+#define REGISTRO_MAX_ESCRITORES 256
+#define REGISTRO_CAPACIDAD 64 // entradas por escritor entre volcados
+#define REGISTRO_TEXTO 104
+
+typedef enum {
+    REGISTRO_SILENCIO,
+    REGISTRO_INFO,
+    REGISTRO_DETALLE
+} nivel_registro_t;
+
+typedef struct {
+    uint64_t tiempo_ns;
+    int nivel;
+    int escritor;
+    char texto[REGISTRO_TEXTO];
+} EntradaRegistro;
+
+// Una línea de cache por contador: el escritor y el volcador no se pisan
+typedef struct {
+    uint64_t escritos __attribute__((aligned(64)));
+    uint64_t leidos __attribute__((aligned(64)));
+    uint64_t perdidos;
+    EntradaRegistro entradas[REGISTRO_CAPACIDAD] __attribute__((aligned(64)));
+} BufferRegistro;
+
+typedef struct {
+    BufferRegistro *buffers;
+    size_t bytes;
+    int num_escritores;
+    int nivel;
+    const char *tipo_escritor; // "Hilo", "Proceso"...
+    uint64_t origen_ns;
+
+    pthread_t volcador;
+    int volcador_activo;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int solicitados;
+    int atendidos;
+    int terminar;
+} Registro;
+
+static inline uint64_t registro_ahora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Acepta "--verbosidad=0|1|2"
+static inline int parse_opcion_verbosidad(const char *texto, int *nivel) {
+    if (strncmp(texto, "--verbosidad=", 13) != 0) return -1;
+    if (texto[13] < '0' || texto[13] > '2' || texto[14] != '\0') return -1;
+    *nivel = texto[13] - '0';
+    return 0;
+}
+
+static inline void registro_crear(Registro *r, int num_escritores, int nivel, const char *tipo_escritor) {
+    if (num_escritores > REGISTRO_MAX_ESCRITORES) num_escritores = REGISTRO_MAX_ESCRITORES;
+    r->bytes = (size_t)num_escritores * sizeof(BufferRegistro);
+    r->buffers = (BufferRegistro *)mmap(NULL, r->bytes, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (r->buffers == MAP_FAILED) {
+        printf("Error: No se pudo asignar memoria para el registro\n");
+        exit(1);
+    }
+    r->num_escritores = num_escritores;
+    r->nivel = nivel;
+    r->tipo_escritor = tipo_escritor;
+    r->origen_ns = registro_ahora_ns();
+    r->volcador_activo = 0;
+    r->solicitados = r->atendidos = r->terminar = 0;
+    pthread_mutex_init(&r->mutex, NULL);
+    pthread_cond_init(&r->cond, NULL);
+}
+
+static inline void registro_agregar(Registro *r, int escritor, int nivel, const char *formato, va_list args) {
+    if (nivel > r->nivel || escritor < 0 || escritor >= r->num_escritores) return;
+    BufferRegistro *b = &r->buffers[escritor];
+    uint64_t e = b->escritos;
+    if (e - __atomic_load_n(&b->leidos, __ATOMIC_ACQUIRE) >= REGISTRO_CAPACIDAD) {
+        __atomic_fetch_add(&b->perdidos, 1, __ATOMIC_RELAXED); // lleno: no bloquear al trabajador
+        return;
+    }
+    EntradaRegistro *entrada = &b->entradas[e % REGISTRO_CAPACIDAD];
+    entrada->tiempo_ns = registro_ahora_ns();
+    entrada->nivel = nivel;
+    entrada->escritor = escritor;
+    vsnprintf(entrada->texto, REGISTRO_TEXTO, formato, args);
+    __atomic_store_n(&b->escritos, e + 1, __ATOMIC_RELEASE);
+}
+
+// Sólo el trabajador número escritor puede escribir en su buffer
+__attribute__((format(printf, 4, 5)))
+static inline void registro_escribir(Registro *r, int escritor, int nivel, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    registro_agregar(r, escritor, nivel, formato, args);
+    va_end(args);
+}
+
+// Métrica con nombre y valor, visible con nivel detalle
+static inline void registro_metrica(Registro *r, int escritor, const char *nombre, double valor) {
+    registro_escribir(r, escritor, REGISTRO_DETALLE, "métrica %s=%.6f", nombre, valor);
+}
+
+static inline int registro_comparar_entradas(const void *a, const void *b) {
+    uint64_t ta = ((const EntradaRegistro *)a)->tiempo_ns;
+    uint64_t tb = ((const EntradaRegistro *)b)->tiempo_ns;
+    return (ta > tb) - (ta < tb);
+}
+
+// Copia las entradas publicadas de todos los buffers, las libera para los
+// escritores y las imprime en orden de tiempo
+static inline void registro_drenar(Registro *r) {
+    size_t capacidad = (size_t)r->num_escritores * REGISTRO_CAPACIDAD;
+    EntradaRegistro *pendientes = (EntradaRegistro *)malloc(capacidad * sizeof(EntradaRegistro));
+    if (pendientes == NULL) return;
+
+    size_t total = 0;
+    uint64_t perdidos = 0;
+    for (int w = 0; w < r->num_escritores; w++) {
+        BufferRegistro *b = &r->buffers[w];
+        uint64_t fin = __atomic_load_n(&b->escritos, __ATOMIC_ACQUIRE);
+        for (uint64_t e = b->leidos; e < fin; e++) {
+            pendientes[total++] = b->entradas[e % REGISTRO_CAPACIDAD];
+        }
+        __atomic_store_n(&b->leidos, fin, __ATOMIC_RELEASE);
+        perdidos += __atomic_exchange_n(&b->perdidos, 0, __ATOMIC_RELAXED);
+    }
+
+    qsort(pendientes, total, sizeof(EntradaRegistro), registro_comparar_entradas);
+    for (size_t e = 0; e < total; e++) {
+        const EntradaRegistro *entrada = &pendientes[e];
+        if (r->nivel >= REGISTRO_DETALLE) {
+            printf("[%10.3f ms] ", (double)(entrada->tiempo_ns - r->origen_ns) / 1e6);
+        }
+        printf("%s %d: %s\n", r->tipo_escritor, entrada->escritor, entrada->texto);
+    }
+    if (perdidos > 0) {
+        printf("Registro: %llu mensajes descartados (buffer lleno)\n", (unsigned long long)perdidos);
+    }
+    fflush(stdout);
+    free(pendientes);
+}
+
+static inline void *registro_hilo_volcador(void *arg) {
+    Registro *r = (Registro *)arg;
+    pthread_mutex_lock(&r->mutex);
+    for (;;) {
+        while (r->atendidos == r->solicitados && !r->terminar) {
+            pthread_cond_wait(&r->cond, &r->mutex);
+        }
+        if (r->atendidos == r->solicitados && r->terminar) break;
+        int solicitud = r->solicitados;
+        pthread_mutex_unlock(&r->mutex);
+
+        registro_drenar(r);
+
+        pthread_mutex_lock(&r->mutex);
+        r->atendidos = solicitud;
+        pthread_cond_broadcast(&r->cond);
+    }
+    pthread_mutex_unlock(&r->mutex);
+    return NULL;
+}
+
+// Pide un volcado al hilo volcador sin esperarlo. Llamar fuera de la región
+// medida; lo que el programa imprima mientras tanto puede intercalarse
+static inline void registro_solicitar_volcado(Registro *r) {
+    pthread_mutex_lock(&r->mutex);
+    if (!r->volcador_activo) {
+        pthread_create(&r->volcador, NULL, registro_hilo_volcador, r);
+        r->volcador_activo = 1;
+    }
+    r->solicitados++;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->mutex);
+}
+
+// Espera a que terminen los volcados pedidos hasta ahora
+static inline void registro_esperar_volcado(Registro *r) {
+    pthread_mutex_lock(&r->mutex);
+    while (r->atendidos != r->solicitados) {
+        pthread_cond_wait(&r->cond, &r->mutex);
+    }
+    pthread_mutex_unlock(&r->mutex);
+}
+
+// Volcado completo antes de seguir imprimiendo desde el hilo principal
+static inline void registro_volcar(Registro *r) {
+    if (r->nivel == REGISTRO_SILENCIO) return;
+    registro_solicitar_volcado(r);
+    registro_esperar_volcado(r);
+}
+
+// Vuelca lo pendiente, detiene el volcador y libera los buffers
+static inline void registro_destruir(Registro *r) {
+    if (r->volcador_activo) {
+        pthread_mutex_lock(&r->mutex);
+        r->solicitados++;
+        r->terminar = 1;
+        pthread_cond_broadcast(&r->cond);
+        pthread_mutex_unlock(&r->mutex);
+        pthread_join(r->volcador, NULL);
+    } else {
+        registro_drenar(r);
+    }
+    pthread_mutex_destroy(&r->mutex);
+    pthread_cond_destroy(&r->cond);
+    munmap(r->buffers, r->bytes);
+}
+
+#endif
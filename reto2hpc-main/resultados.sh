@@ -0,0 +1,365 @@
+#!/bin/bash
+
+# Base de resultados de rendimiento entre ejecuciones, compilaciones y máquinas
+# Tres CSV en results/bd/:
+#   maquinas.csv       huella del hardware: host, CPU, sockets, núcleos,
+#                      cachés y memoria
+#   compilaciones.csv  compilador y flags con que el Makefile construye cada
+#                      programa (make -n del objetivo OBJETIVO_MAKE)
+#   medidas.csv        una fila por tiempo de kernel ("Tiempo de
+#                      multiplicación <kernel>: X segundos") y repetición,
+#                      con la máquina, la compilación y la construcción
+#                      (git describe, o CONSTRUCCION)
+#
+# "comparar" aplica la prueba U de Mann-Whitney a las repeticiones de cada
+# (programa, kernel, n, hilos) de dos selecciones y marca REGRESIÓN o MEJORA
+# cuando p < ALFA y la mediana cambia más de UMBRAL_CAMBIO. Con pocas
+# repeticiones la prueba no puede ser significativa: con 3 contra 3 el
+# menor p posible es 0.1, de ahí REPETICIONES=5 por defecto.
+#
+# Uso: ./resultados.sh registrar [n]
+#      ./resultados.sh importar [construcción]
+#      ./resultados.sh comparar <base> <nueva>
+#      ./resultados.sh maquinas
+# Selecciones: construcción (en esta máquina), construcción@huella,
+#              @huella (cualquier construcción) o construcción@* (cualquier
+#              máquina)
+# Variables: PROGRAMAS="seq openmp pthread procesos", HILOS="1 2 4",
+#            REPETICIONES=5, CONSTRUCCION, OBJETIVO_MAKE=all, ALFA=0.05,
+#            UMBRAL_CAMBIO=0.05
+
+# Colores para output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+# Configuración
+BUILD_DIR="build"
+RESULTS_DIR="results"
+BD_DIR="$RESULTS_DIR/bd"
+MAQUINAS="$BD_DIR/maquinas.csv"
+COMPILACIONES="$BD_DIR/compilaciones.csv"
+MEDIDAS="$BD_DIR/medidas.csv"
+
+MODE=${1:-ayuda}
+PROGRAMAS=${PROGRAMAS:-"seq openmp pthread procesos"}
+HILOS=${HILOS:-"1 2 4"}
+REPETICIONES=${REPETICIONES:-5}
+OBJETIVO_MAKE=${OBJETIVO_MAKE:-all}
+ALFA=${ALFA:-0.05}
+UMBRAL_CAMBIO=${UMBRAL_CAMBIO:-0.05}
+CXX=${CXX:-g++}
+
+# Las comas se cambian por ';' para no romper el CSV
+limpiar() {
+    echo "$*" | tr ',' ';' | xargs
+}
+
+campo_lscpu() {
+    limpiar "$(lscpu | grep "^$1:" | cut -d: -f2)"
+}
+
+huella() {
+    printf "%08x" "$(echo "$*" | cksum | cut -d' ' -f1)"
+}
+
+# Fila de maquinas.csv de esta máquina (la huella primero)
+fila_maquina() {
+    local datos="$(limpiar "$(hostname)"),$(campo_lscpu 'Model name'),$(campo_lscpu 'Socket(s)'),$(campo_lscpu 'Core(s) per socket'),$(campo_lscpu 'CPU(s)'),$(campo_lscpu 'L1d cache'),$(campo_lscpu 'L2 cache'),$(campo_lscpu 'L3 cache'),$(awk '/MemTotal/ { print $2 " kB" }' /proc/meminfo)"
+    echo "$(huella "$datos"),$datos"
+}
+
+# Fila de compilaciones.csv del programa: flags de la regla del Makefile
+fila_compilacion() {
+    local programa="$1"
+    local orden=$(make -s -n -B BUILD_DIR="$BUILD_DIR" "$OBJETIVO_MAKE" 2>/dev/null | grep -- "-o $BUILD_DIR/matrices_$programa ")
+    local flags=$(echo "$orden" | tr ' ' '\n' | grep '^-' | grep -v '^-o$' | tr '\n' ' ')
+    local datos="$(limpiar "$($CXX --version | head -1)"),$(limpiar "$flags")"
+    echo "$(huella "$datos"),$datos"
+}
+
+# Agrega la fila si su huella aún no está en la tabla
+registrar_fila() {
+    local tabla="$1"
+    local fila="$2"
+    grep -q "^${fila%%,*}," "$tabla" || echo "$fila" >> "$tabla"
+}
+
+crear_bd() {
+    mkdir -p "$BD_DIR"
+    [ -f "$MAQUINAS" ] || echo "Huella,Host,CPU,Sockets,Núcleos por socket,CPUs,L1d,L2,L3,Memoria" > "$MAQUINAS"
+    [ -f "$COMPILACIONES" ] || echo "Compilación,Compilador,Flags" > "$COMPILACIONES"
+    [ -f "$MEDIDAS" ] || echo "Fecha,Máquina,Compilación,Construcción,Programa,Kernel,n,Hilos,Repetición,Tiempo(s)" > "$MEDIDAS"
+}
+
+# Filas "kernel,segundos" de la salida de un programa
+extraer_tiempos() {
+    sed -n 's/^Tiempo de multiplicación \(.*\): \([0-9.e+-]*\) segundos$/\1,\2/p' | tr -d '()' | sed 's/;/ /g'
+}
+
+argumentos_para() {
+    case "$1" in
+        seq) echo "$2" ;;
+        *) echo "$2 $3" ;;
+    esac
+}
+
+# Ejecuta cada programa REPETICIONES veces por número de hilos
+run_registrar() {
+    local size="$1"
+    local construccion=${CONSTRUCCION:-$(git describe --always --dirty 2>/dev/null || echo "sin-git")}
+    local fecha=$(date +"%Y-%m-%d %H:%M:%S")
+    local maquina=$(fila_maquina)
+
+    registrar_fila "$MAQUINAS" "$maquina"
+    echo -e "${BLUE}=== REGISTRO DE RESULTADOS ===${NC}"
+    echo "Máquina: ${maquina%%,*} ($(echo "$maquina" | cut -d, -f2-3))"
+    echo "Construcción: $construccion"
+    echo "Tamaño de matriz: ${size}x${size}, repeticiones: $REPETICIONES"
+
+    for programa in $PROGRAMAS; do
+        local executable="$BUILD_DIR/matrices_$programa"
+        if [ ! -f "$executable" ]; then
+            echo -e "${RED}Error: $executable no encontrado. Ejecuta 'make all' primero.${NC}"
+            exit 1
+        fi
+        local compilacion=$(fila_compilacion "$programa")
+        registrar_fila "$COMPILACIONES" "$compilacion"
+        echo -e "${YELLOW}$programa: $(echo "$compilacion" | cut -d, -f3)${NC}"
+
+        local lista_hilos="$HILOS"
+        [ "$programa" = "seq" ] && lista_hilos=1
+        for threads in $lista_hilos; do
+            for rep in $(seq 1 "$REPETICIONES"); do
+                local output
+                output=$(timeout 300s "$executable" $(argumentos_para "$programa" "$size" "$threads") 2>&1)
+                if [ $? -ne 0 ]; then
+                    echo -e "${RED}ERROR: $programa con $threads hilos (repetición $rep)${NC}"
+                    continue
+                fi
+                echo "$output" | extraer_tiempos | while IFS=, read -r kernel tiempo; do
+                    echo "$fecha,${maquina%%,*},${compilacion%%,*},$construccion,$programa,$kernel,$size,$threads,$rep,$tiempo"
+                done >> "$MEDIDAS"
+            done
+            echo -e "${GREEN}✓ $programa con $threads hilos${NC}"
+        done
+    done
+    echo "Medidas agregadas a $MEDIDAS"
+}
+
+# Importa los results/matrices_<programa>_<n>[_<hilos>]_run<K>.out de
+# benchmark.sh. No se sabe en qué máquina ni con qué flags se corrieron:
+# quedan con máquina y compilación "importado"
+run_importar() {
+    local construccion="$1"
+    if grep -q ",importado,importado,$construccion," "$MEDIDAS"; then
+        echo -e "${RED}La construcción '$construccion' ya fue importada${NC}"
+        exit 1
+    fi
+    registrar_fila "$MAQUINAS" "importado,desconocido,desconocido,,,,,,,"
+    registrar_fila "$COMPILACIONES" "importado,desconocido,desconocido"
+
+    local archivos=0
+    for archivo in "$RESULTS_DIR"/matrices_*_run*.out; do
+        [ -f "$archivo" ] || continue
+        local nombre=$(basename "$archivo" .out)
+        local programa=$(echo "$nombre" | cut -d_ -f2)
+        local size=$(echo "$nombre" | cut -d_ -f3)
+        local threads=1
+        [ "$programa" != "seq" ] && threads=$(echo "$nombre" | cut -d_ -f4)
+        local rep=${nombre##*_run}
+        local fecha=$(date -r "$archivo" +"%Y-%m-%d %H:%M:%S")
+        extraer_tiempos < "$archivo" | while IFS=, read -r kernel tiempo; do
+            echo "$fecha,importado,importado,$construccion,$programa,$kernel,$size,$threads,$rep,$tiempo"
+        done >> "$MEDIDAS"
+        archivos=$((archivos + 1))
+    done
+    echo "Importados $archivos archivos como construcción '$construccion' en $MEDIDAS"
+}
+
+# Una ficha "columna: valor" por fila de la tabla
+mostrar_tabla() {
+    awk -F, 'NR == 1 { for (i = 1; i <= NF; i++) nombre[i] = $i; next }
+             { for (i = 1; i <= NF; i++) printf "  %-20s %s\n", nombre[i] ":", $i; print "" }' "$1"
+}
+
+run_maquinas() {
+    echo -e "${BLUE}=== MÁQUINAS ===${NC}"
+    mostrar_tabla "$MAQUINAS"
+    echo -e "${BLUE}=== COMPILACIONES ===${NC}"
+    mostrar_tabla "$COMPILACIONES"
+    echo -e "${BLUE}=== MEDIDAS POR MÁQUINA Y CONSTRUCCIÓN ===${NC}"
+    tail -n +2 "$MEDIDAS" | cut -d, -f2,4 | sort | uniq -c
+}
+
+# construcción[@máquina] -> "construcción,máquina" (vacío = cualquiera)
+resolver_seleccion() {
+    local seleccion="$1"
+    local construccion="${seleccion%%@*}"
+    local maquina
+    if [ "$seleccion" = "$construccion" ]; then
+        maquina=$(fila_maquina | cut -d, -f1)
+    else
+        maquina="${seleccion#*@}"
+        [ "$maquina" = "*" ] && maquina=""
+    fi
+    echo "$construccion,$maquina"
+}
+
+run_comparar() {
+    local base=$(resolver_seleccion "$1")
+    local nueva=$(resolver_seleccion "$2")
+
+    echo -e "${BLUE}=== COMPARACIÓN: $1 -> $2 ===${NC}"
+    echo "Mann-Whitney bilateral, ALFA = $ALFA, cambio mínimo de la mediana = $UMBRAL_CAMBIO"
+    echo ""
+    tail -n +2 "$MEDIDAS" | awk -F, -v base="$base" -v nueva="$nueva" -v alfa="$ALFA" -v umbral="$UMBRAL_CAMBIO" '
+    function coincide(seleccion,   s) {
+        split(seleccion, s, ",")
+        return (s[1] == "" || s[1] == $4) && (s[2] == "" || s[2] == $2)
+    }
+    {
+        clave = $5 "," $6 "," $7 "," $8
+        if (coincide(base)) { na[clave]++; xa[clave, na[clave]] = $10; compa[$3] = 1 }
+        if (coincide(nueva)) { nb[clave]++; xb[clave, nb[clave]] = $10; compb[$3] = 1 }
+    }
+    # Mediana de los n valores de v (se ordenan en el lugar)
+    function mediana(v, n,   i, j, t) {
+        for (i = 2; i <= n; i++) {
+            t = v[i]
+            for (j = i - 1; j >= 1 && v[j] > t; j--) v[j + 1] = v[j]
+            v[j + 1] = t
+        }
+        return n % 2 ? v[(n + 1) / 2] : (v[n / 2] + v[n / 2 + 1]) / 2
+    }
+    # Número de ordenaciones de m valores de A y n de B con U = u
+    function frecuencia(m, n, u,   k) {
+        if (u < 0) return 0
+        if (m == 0 || n == 0) return u == 0
+        k = m SUBSEP n SUBSEP u
+        if (!(k in memo)) memo[k] = frecuencia(m - 1, n, u - n) + frecuencia(m, n - 1, u)
+        return memo[k]
+    }
+    # erfc(x) de Abramowitz y Stegun 7.1.26 (error < 1.5e-7)
+    function erfc(x,   t) {
+        t = 1 / (1 + 0.3275911 * x)
+        return t * (0.254829592 + t * (-0.284496736 + t * (1.421413741 + t * (-1.453152027 + t * 1.061405429)))) * exp(-x * x)
+    }
+    # p bilateral de la U de Mann-Whitney: exacto sin empates y con
+    # muestras chicas, aproximación normal con corrección por empates si no
+    function mann_whitney(a, m, b, n,   v, origen, i, j, k, t, r, rango_a, u, empates, total, acumulado, mu, sigma, z) {
+        k = 0
+        for (i = 1; i <= m; i++) { v[++k] = a[i]; origen[k] = 1 }
+        for (i = 1; i <= n; i++) { v[++k] = b[i]; origen[k] = 0 }
+        for (i = 2; i <= k; i++) {
+            t = v[i]; r = origen[i]
+            for (j = i - 1; j >= 1 && v[j] > t; j--) { v[j + 1] = v[j]; origen[j + 1] = origen[j] }
+            v[j + 1] = t; origen[j + 1] = r
+        }
+        rango_a = 0; empates = 0
+        for (i = 1; i <= k; i = j) {
+            for (j = i; j <= k && v[j] == v[i]; j++) ;
+            t = j - i
+            empates += t * t * t - t
+            for (r = i; r < j; r++) if (origen[r]) rango_a += (i + j - 1) / 2
+        }
+        u = rango_a - m * (m + 1) / 2
+        if (u > m * n - u) u = m * n - u
+        if (empates == 0 && m <= 20 && n <= 20) {
+            total = 0; acumulado = 0
+            for (i = 0; i <= m * n; i++) {
+                t = frecuencia(m, n, i)
+                total += t
+                if (i <= u) acumulado += t
+            }
+            return (2 * acumulado / total < 1) ? 2 * acumulado / total : 1
+        }
+        mu = m * n / 2
+        sigma = sqrt(m * n / 12 * ((k + 1) - empates / (k * (k - 1))))
+        if (sigma == 0) return 1
+        z = (mu - u - 0.5) / sigma
+        return z > 0 ? erfc(z / sqrt(2)) : 1
+    }
+    END {
+        printf "Compilaciones base:"; for (id in compa) printf " %s", id; printf "\n"
+        printf "Compilaciones nueva:"; for (id in compb) printf " %s", id; printf "\n\n"
+        printf "%-10s %-24s %6s %6s %5s %12s %12s %9s %9s  %s\n", "Programa", "Kernel", "n", "Hilos", "Reps",
+               "Base (s)", "Nueva (s)", "Cambio", "p", "Veredicto"
+        # Orden por programa, kernel, n e hilos
+        np = 0
+        for (clave in na) {
+            if (!(clave in nb)) continue
+            split(clave, c, ",")
+            orden = sprintf("%s,%s,%09d,%06d", c[1], c[2], c[3], c[4])
+            for (i = ++np; i > 1 && ordenes[i - 1] > orden; i--) { ordenes[i] = ordenes[i - 1]; claves[i] = claves[i - 1] }
+            ordenes[i] = orden; claves[i] = clave
+        }
+        regresiones = 0; mejoras = 0
+        for (q = 1; q <= np; q++) {
+            clave = claves[q]
+            split(clave, c, ",")
+            delete a; delete b
+            for (i = 1; i <= na[clave]; i++) a[i] = xa[clave, i]
+            for (i = 1; i <= nb[clave]; i++) b[i] = xb[clave, i]
+            p = mann_whitney(a, na[clave], b, nb[clave])
+            mb = mediana(a, na[clave]); mn = mediana(b, nb[clave])
+            cambio = mb > 0 ? mn / mb - 1 : 0
+            veredicto = "sin cambio"
+            if (p < alfa && cambio > umbral) { veredicto = "REGRESIÓN"; regresiones++ }
+            else if (p < alfa && cambio < -umbral) { veredicto = "MEJORA"; mejoras++ }
+            else if (cambio > umbral || cambio < -umbral) veredicto = "no significativo"
+            printf "%-10s %-24s %6d %6d %2d/%-2d %12.6f %12.6f %+8.1f%% %9.4f  %s\n", c[1], c[2], c[3], c[4],
+                   na[clave], nb[clave], mb, mn, cambio * 100, p, veredicto
+        }
+        printf "\n%d puntos comparados: %d regresiones, %d mejoras\n", np, regresiones, mejoras
+        if (np == 0) printf "Sin puntos (programa, kernel, n, hilos) en común entre las dos selecciones\n"
+        exit (regresiones > 0)
+    }'
+}
+
+# Función principal
+main() {
+    case "$MODE" in
+        "registrar")
+            crear_bd
+            run_registrar "${2:-1000}"
+            ;;
+        "importar")
+            crear_bd
+            run_importar "${2:-importado}"
+            ;;
+        "comparar")
+            if [ $# -ne 3 ]; then
+                echo -e "${RED}Uso: $0 comparar <base> <nueva>${NC}"
+                exit 1
+            fi
+            crear_bd
+            run_comparar "$2" "$3"
+            ;;
+        "maquinas")
+            crear_bd
+            run_maquinas
+            ;;
+        *)
+            echo "Uso: $0 registrar [n]"
+            echo "     $0 importar [construcción]"
+            echo "     $0 comparar <base> <nueva>"
+            echo "     $0 maquinas"
+            echo "Selecciones: construcción | construcción@huella | @huella | construcción@*"
+            echo "Variables: PROGRAMAS=\"$PROGRAMAS\" HILOS=\"$HILOS\" REPETICIONES=$REPETICIONES"
+            echo "           CONSTRUCCION OBJETIVO_MAKE=$OBJETIVO_MAKE ALFA=$ALFA UMBRAL_CAMBIO=$UMBRAL_CAMBIO"
+            echo ""
+            echo "Ejemplos:"
+            echo "  $0 registrar 1000"
+            echo "  CONSTRUCCION=o2 OBJETIVO_MAKE=optimize-o2 $0 registrar 1000"
+            echo "  $0 comparar o2 \$(git describe --always --dirty)"
+            echo "  $0 comparar v1@1a2b3c4d v1@5e6f7a8b"
+            exit 1
+            ;;
+    esac
+}
+
+# Ejecutar función principal
+main "$@"
@@ -1,7 +1,22 @@
 #!/bin/bash
 
 # Script de Prueba de Escalabilidad para Multiplicación de Matrices
-# Analiza el rendimiento con diferentes números de hilos/procesos
+# Escalabilidad fuerte (n fijo) y débil (n crece como ∛p, trabajo constante
+# por hilo) de OpenMP, Pthread y Procesos, con ajuste de modelos:
+#   - Amdahl:                 T(p)/T(1) = f + (1 - f)/p
+#   - Amdahl con sobrecosto:  T(p)/T(1) = f + (1 - f)/p + k (p - 1)
+#   - Gustafson (débil):      S(p) = p - s (p - 1)
+# y marca el primer número de hilos con eficiencia bajo el umbral.
+#
+# Cada medida es la mediana de REPETICIONES ejecuciones del tiempo de la
+# multiplicación optimizada que imprime cada programa (en segundos), no
+# del tiempo de pared del proceso. El CSV incluye la máquina, así que
+# "ajustar" puede resumir juntos los CSV de varias máquinas.
+#
+# Uso: ./scalability_test.sh [fuerte|debil|todo] [n]
+#      ./scalability_test.sh ajustar results/escalabilidad_*.csv
+# Variables: HILOS="1 2 4 8", REPETICIONES=3, UMBRAL_EFICIENCIA=0.7,
+#            BACKENDS="OpenMP Pthread Procesos"
 
 # Colores para output
 RED='\033[0;31m'
@@ -14,126 +29,229 @@ NC='\033[0m' # No Color
 BUILD_DIR="build"
 RESULTS_DIR="results"
 TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
-RESULTS_FILE="$RESULTS_DIR/scalability_$TIMESTAMP.csv"
+RESULTS_FILE="$RESULTS_DIR/escalabilidad_$TIMESTAMP.csv"
+SUMMARY_FILE="$RESULTS_DIR/escalabilidad_${TIMESTAMP}_resumen.txt"
 
 # Configuración de pruebas
-MATRIX_SIZE=1000
+MODE=${1:-todo}
+MATRIX_SIZE=${2:-1000}
 MAX_THREADS=$(nproc)
-THREAD_SEQUENCE=(1 2 4 8 16 32)
+REPETICIONES=${REPETICIONES:-3}
+UMBRAL_EFICIENCIA=${UMBRAL_EFICIENCIA:-0.7}
+BACKENDS=${BACKENDS:-"OpenMP Pthread Procesos"}
+MACHINE=$(echo "$(hostname) ($(lscpu | grep 'Model name' | cut -d: -f2 | xargs))" | tr ',' ';')
 
-# Función para extraer tiempo de ejecución
-extract_time() {
-    local output="$1"
-    echo "$output" | grep "Tiempo de multiplicación" | tail -1 | awk '{print $4}'
+# Potencias de 2 hasta nproc y nproc mismo, salvo que se den en HILOS
+thread_sequence() {
+    if [ -n "$HILOS" ]; then
+        echo $HILOS
+        return
+    fi
+    local p=1 sequence=""
+    while [ "$p" -lt "$MAX_THREADS" ]; do
+        sequence="$sequence $p"
+        p=$((p * 2))
+    done
+    echo $sequence $MAX_THREADS
 }
 
-# Función para extraer speedup
-extract_speedup() {
-    local output="$1"
-    echo "$output" | grep "Speedup:" | tail -1 | awk '{print $2}' | sed 's/x//'
+executable_for() {
+    case "$1" in
+        OpenMP) echo "$BUILD_DIR/matrices_openmp" ;;
+        Pthread) echo "$BUILD_DIR/matrices_pthread" ;;
+        Procesos) echo "$BUILD_DIR/matrices_procesos" ;;
+    esac
 }
 
-# Función para extraer eficiencia
-extract_efficiency() {
+# Función para extraer el tiempo de la multiplicación optimizada
+extract_time() {
     local output="$1"
-    echo "$output" | grep "Eficiencia:" | tail -1 | awk '{print $2}' | sed 's/%//'
+    echo "$output" | grep "Tiempo de multiplicación.*optimizada:" | tail -1 | awk '{print $(NF-1)}'
 }
 
-# Función para ejecutar prueba de escalabilidad
+# Ejecuta REPETICIONES veces un backend y agrega una fila por ejecución
 run_scalability_test() {
-    local executable="$1"
-    local name="$2"
+    local name="$1"
+    local mode="$2"
     local threads="$3"
-    
-    echo -e "${YELLOW}Probando $name con $threads hilos/procesos...${NC}"
-    
-    # Ejecutar y capturar output
-    local output
-    if [ "$name" = "Secuencial" ]; then
-        output=$(timeout 300s "$executable" "$MATRIX_SIZE" 2>&1)
-    else
-        output=$(timeout 300s "$executable" "$MATRIX_SIZE" "$threads" 2>&1)
-    fi
-    
-    local exit_code=$?
-    
-    if [ $exit_code -eq 124 ]; then
-        echo -e "${RED}TIMEOUT: $name con $threads hilos${NC}"
-        echo "$name,$threads,TIMEOUT,TIMEOUT,TIMEOUT" >> "$RESULTS_FILE"
-    elif [ $exit_code -eq 0 ]; then
+    local size="$4"
+    local executable=$(executable_for "$name")
+
+    echo -e "${YELLOW}Probando $name ($mode) con $threads hilos/procesos, n = $size...${NC}"
+
+    for rep in $(seq 1 "$REPETICIONES"); do
+        local output
+        output=$(timeout 300s "$executable" "$size" "$threads" 2>&1)
+        local exit_code=$?
         local time_result=$(extract_time "$output")
-        local speedup_result=$(extract_speedup "$output")
-        local efficiency_result=$(extract_efficiency "$output")
-        
-        echo -e "${GREEN}✓ $name con $threads hilos: ${time_result}s${NC}"
-        echo "$name,$threads,$time_result,$speedup_result,$efficiency_result" >> "$RESULTS_FILE"
-    else
-        echo -e "${RED}ERROR: $name con $threads hilos (código: $exit_code)${NC}"
-        echo "$name,$threads,ERROR,ERROR,ERROR" >> "$RESULTS_FILE"
-    fi
+
+        if [ $exit_code -eq 124 ]; then
+            echo -e "${RED}TIMEOUT: $name con $threads hilos${NC}"
+            return
+        elif [ $exit_code -ne 0 ] || [ -z "$time_result" ]; then
+            echo -e "${RED}ERROR: $name con $threads hilos (código: $exit_code)${NC}"
+            return
+        fi
+        echo "$MACHINE,$name,$mode,$threads,$size,$rep,$time_result" >> "$RESULTS_FILE"
+    done
+    echo -e "${GREEN}✓ $name con $threads hilos: $(grep ",$name,$mode,$threads,$size," "$RESULTS_FILE" | cut -d, -f7 | sort -g | tr '\n' ' ')s${NC}"
+}
+
+# Escalabilidad fuerte: mismo n para todo p
+run_strong() {
+    echo -e "${BLUE}=== ESCALABILIDAD FUERTE (n = $MATRIX_SIZE) ===${NC}"
+    for threads in $(thread_sequence); do
+        for backend in $BACKENDS; do
+            run_scalability_test "$backend" "fuerte" "$threads" "$MATRIX_SIZE"
+        done
+    done
+}
+
+# Escalabilidad débil: n(p) = n(1) ∛p, así n³/p (trabajo por hilo) es constante
+run_weak() {
+    echo -e "${BLUE}=== ESCALABILIDAD DÉBIL (n = $MATRIX_SIZE ∛p) ===${NC}"
+    for threads in $(thread_sequence); do
+        local size=$(awk -v n="$MATRIX_SIZE" -v p="$threads" 'BEGIN { printf "%d", n * exp(log(p) / 3) + 0.5 }')
+        for backend in $BACKENDS; do
+            run_scalability_test "$backend" "debil" "$threads" "$size"
+        done
+    done
+}
+
+# Mediana por (máquina, backend, modo, hilos, n) y ajuste por (máquina,
+# backend, modo), y además por n en escalabilidad fuerte. Lee uno o varios CSV
+# con el formato de RESULTS_FILE
+fit_models() {
+    tail -q -n +2 "$@" | sort -t, -k1,1 -k2,2 -k3,3 -k4,4n -k5,5n -k7,7g | awk -F, '
+    # Mediana de las repeticiones de cada punto
+    {
+        clave = $1 "," $2 "," $3 "," $4 "," $5
+        if (clave != anterior && c > 0) mediana()
+        anterior = clave; linea = $1 "," $2 "," $3 "," $4 "," $5
+        t[++c] = $7
+    }
+    END { if (c > 0) mediana() }
+    function mediana() {
+        print linea "," (c % 2 ? t[(c + 1) / 2] : (t[c / 2] + t[c / 2 + 1]) / 2)
+        c = 0
+    }' | awk -F, -v umbral="$UMBRAL_EFICIENCIA" '
+    # En fuerte cada n es otro experimento. Las filas llegan ordenadas por
+    # hilos, con los n intercalados: se juntan por grupo y se ajusta al final
+    {
+        grupo = $1 "," $2 "," $3 ($3 == "fuerte" ? "," $5 : "")
+        if (!(grupo in cuenta)) orden[++num_grupos] = grupo
+        filas[grupo, ++cuenta[grupo]] = $0
+    }
+    END {
+        for (g = 1; g <= num_grupos; g++) {
+            np = 0
+            for (i = 1; i <= cuenta[orden[g]]; i++) {
+                split(filas[orden[g], i], campo, ",")
+                maquina = campo[1]; backend = campo[2]; modo = campo[3]
+                np++; p[np] = campo[4]; n[np] = campo[5]; tiempo[np] = campo[6]
+            }
+            ajustar()
+        }
+    }
+    function ajustar(   i, t1, n1, s, e, x, y, sxx, sxy, szz, sxz, szy, f, k, det, gs, gd, primero, popt) {
+        printf "\n=== %s | %s | escalabilidad %s%s ===\n", maquina, backend, modo, modo == "fuerte" ? " (n = " n[1] ")" : ""
+        if (p[1] != 1) {
+            printf "Sin medida con 1 hilo: no hay referencia para speedup ni ajuste\n"
+            np = 0; return
+        }
+        t1 = tiempo[1]; n1 = n[1]
+        printf "%6s %6s %12s %9s %11s\n", "Hilos", "n", "Tiempo (s)", "Speedup", "Eficiencia"
+        primero = ""
+        for (i = 1; i <= np; i++) {
+            # En débil el trabajo crece con n³: speedup escalado por trabajo
+            s = (n[i] / n1) ^ 3 * t1 / tiempo[i]
+            e = s / p[i]
+            printf "%6d %6d %12.6f %8.2fx %10.1f%%%s\n", p[i], n[i], tiempo[i], s, e * 100,
+                   (e < umbral && primero == "") ? "  <-- bajo el umbral" : ""
+            if (e < umbral && primero == "") primero = p[i]
+            if (p[i] > 1) {
+                # y = T/T1 - 1/p = f (1 - 1/p) + k (p - 1)
+                x = 1 - 1 / p[i]; y = tiempo[i] / t1 * (n1 / n[i]) ^ 3 - 1 / p[i]
+                sxx += x * x; sxy += x * y
+                szz += (p[i] - 1) ^ 2; sxz += x * (p[i] - 1); szy += (p[i] - 1) * y
+                gs += (p[i] - 1) * (p[i] - s); gd += (p[i] - 1) ^ 2
+            }
+        }
+        if (sxx == 0) {
+            printf "Ajuste: hace falta al menos una medida con más de 1 hilo\n"
+        } else if (modo == "fuerte") {
+            f = sxy / sxx
+            printf "Amdahl: fracción serial f = %.4f, speedup máximo 1/f = %s\n", f, (f > 0) ? sprintf("%.1fx", 1 / f) : "sin límite"
+            det = sxx * szz - sxz * sxz
+            if (det > 1e-12 * sxx * szz) {
+                f = (sxy * szz - szy * sxz) / det
+                k = (sxx * szy - sxz * sxy) / det
+                popt = (k > 0 && f < 1) ? sprintf("%.1f", sqrt((1 - f) / k)) : "sin máximo"
+                printf "Amdahl con sobrecosto: f = %.4f, k = %.5f T(1) por hilo, p óptimo = %s\n", f, k, popt
+            } else {
+                printf "Amdahl con sobrecosto: hacen falta al menos dos números de hilos > 1\n"
+            }
+        } else {
+            printf "Gustafson: fracción serial s = %.4f (S(p) = p - s (p - 1))\n", gs / gd
+        }
+        printf "Eficiencia < %.0f%%: %s\n", umbral * 100, primero == "" ? "ninguna medida" : "desde " primero " hilos"
+        np = 0
+    }'
 }
 
 # Función principal
 main() {
+    if [ "$MODE" = "ajustar" ]; then
+        shift
+        if [ $# -eq 0 ]; then
+            echo -e "${RED}Uso: $0 ajustar <csv> [csv...]${NC}"
+            exit 1
+        fi
+        fit_models "$@"
+        return
+    fi
+    if [ "$MODE" != "fuerte" ] && [ "$MODE" != "debil" ] && [ "$MODE" != "todo" ]; then
+        echo "Uso: $0 [fuerte|debil|todo] [n]"
+        echo "     $0 ajustar <csv> [csv...]"
+        echo "Variables: HILOS=\"1 2 4 8\" REPETICIONES=3 UMBRAL_EFICIENCIA=0.7 BACKENDS=\"OpenMP Pthread Procesos\""
+        exit 1
+    fi
+
     echo -e "${BLUE}=== PRUEBA DE ESCALABILIDAD ===${NC}"
-    echo "Tamaño de matriz: ${MATRIX_SIZE}x${MATRIX_SIZE}"
-    echo "Máximo de hilos disponibles: $MAX_THREADS"
+    echo "Máquina: $MACHINE"
+    echo "Tamaño de matriz base: ${MATRIX_SIZE}x${MATRIX_SIZE}"
+    echo "Hilos/procesos: $(thread_sequence) (máximo disponible: $MAX_THREADS)"
+    echo "Repeticiones por medida: $REPETICIONES (se usa la mediana)"
     echo "Resultados se guardarán en: $RESULTS_FILE"
     echo ""
-    
+
     # Crear directorio de resultados
     mkdir -p "$RESULTS_DIR"
-    
+
     # Verificar ejecutables
-    if [ ! -f "$BUILD_DIR/matrices_seq" ] || [ ! -f "$BUILD_DIR/matrices_openmp" ] || 
-       [ ! -f "$BUILD_DIR/matrices_pthread" ] || [ ! -f "$BUILD_DIR/matrices_procesos" ]; then
-        echo -e "${RED}Error: Ejecutables no encontrados. Ejecuta 'make all' primero.${NC}"
-        exit 1
-    fi
-    
-    # Crear archivo CSV con headers
-    echo "Implementación,Hilos,Tiempo(s),Speedup,Eficiencia(%)" > "$RESULTS_FILE"
-    
-    # Prueba secuencial (baseline)
-    echo -e "${BLUE}=== LÍNEA BASE (SECUENCIAL) ===${NC}"
-    run_scalability_test "$BUILD_DIR/matrices_seq" "Secuencial" "1"
-    
-    # Pruebas paralelas
-    echo -e "${BLUE}=== PRUEBAS PARALELAS ===${NC}"
-    for threads in "${THREAD_SEQUENCE[@]}"; do
-        if [ "$threads" -le "$MAX_THREADS" ] && [ "$threads" -le "$MATRIX_SIZE" ]; then
-            echo -e "${YELLOW}--- Probando con $threads hilos/procesos ---${NC}"
-            
-            # OpenMP
-            run_scalability_test "$BUILD_DIR/matrices_openmp" "OpenMP" "$threads"
-            
-            # Pthread
-            run_scalability_test "$BUILD_DIR/matrices_pthread" "Pthread" "$threads"
-            
-            # Procesos
-            run_scalability_test "$BUILD_DIR/matrices_procesos" "Procesos" "$threads"
-            
-            echo ""
+    for backend in $BACKENDS; do
+        if [ ! -f "$(executable_for "$backend")" ]; then
+            echo -e "${RED}Error: Ejecutables no encontrados. Ejecuta 'make all' primero.${NC}"
+            exit 1
         fi
     done
-    
+
+    # Crear archivo CSV con headers
+    echo "Máquina,Backend,Modo,Hilos,n,Repetición,Tiempo(s)" > "$RESULTS_FILE"
+
+    if [ "$MODE" = "fuerte" ] || [ "$MODE" = "todo" ]; then
+        run_strong
+    fi
+    if [ "$MODE" = "debil" ] || [ "$MODE" = "todo" ]; then
+        run_weak
+    fi
+
     # Generar resumen
     echo -e "${GREEN}=== RESUMEN DE ESCALABILIDAD ===${NC}"
-    echo "Resultados guardados en: $RESULTS_FILE"
-    echo ""
-    echo "Mejores resultados por implementación:"
-    
-    # Mostrar mejores resultados
-    echo -e "${BLUE}OpenMP:${NC}"
-    grep "OpenMP" "$RESULTS_FILE" | grep -v "ERROR\|TIMEOUT" | sort -t',' -k3 -n | head -3
-    
-    echo -e "${BLUE}Pthread:${NC}"
-    grep "Pthread" "$RESULTS_FILE" | grep -v "ERROR\|TIMEOUT" | sort -t',' -k3 -n | head -3
-    
-    echo -e "${BLUE}Procesos:${NC}"
-    grep "Procesos" "$RESULTS_FILE" | grep -v "ERROR\|TIMEOUT" | sort -t',' -k3 -n | head -3
-    
+    fit_models "$RESULTS_FILE" | tee "$SUMMARY_FILE"
     echo ""
+    echo "Mediciones: $RESULTS_FILE"
+    echo "Resumen: $SUMMARY_FILE"
     echo -e "${GREEN}Prueba de escalabilidad completada${NC}"
 }
 
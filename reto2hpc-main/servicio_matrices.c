@@ -0,0 +1,537 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <omp.h>
+#include "kernels_fijos.h"
+
+//servicio_matrices.c
+// Modo servicio: un proceso de larga duración mantiene caliente el equipo de
+// hilos OpenMP y las matrices ya mapeadas, y atiende multiplicaciones por un
+// socket Unix. Los operandos viajan en un memfd que el cliente pasa con
+// SCM_RIGHTS: el cliente escribe A y B, el servidor escribe C en el mismo
+// segmento compartido, sin copiar datos por el socket. El servidor solo
+// mapea memfd sellados contra cambios de tamaño: si un cliente pudiera
+// achicarlo, el siguiente acceso del servidor moriría con SIGBUS.
+//
+// El servidor atiende todas las conexiones desde un solo hilo con poll():
+// solo lee de una conexión cuando ya tiene una petición esperando, así que un
+// cliente lento o inactivo no bloquea a los demás, y el equipo OpenMP sigue
+// siendo el del hilo principal. Las multiplicaciones se hacen de a una, cada
+// una con todos los hilos.
+//
+// Es un programa aparte y no un modo servicio dentro de cada versión: usa el
+// kernel por bloques de la versión OpenMP sobre matrices contiguas.
+
+#define SOCKET_POR_DEFECTO "/tmp/matrices_servicio.sock"
+#define MAX_BUFFERS 16
+#define MAX_CONEXIONES 64
+
+enum { OP_MULTIPLICAR = 1, OP_CERRAR = 2 };
+
+typedef struct {
+    int operacion;
+    int n;
+} PeticionServicio;
+
+typedef struct {
+    int estado;            // 0 si la multiplicación se hizo
+    double tiempo_calculo; // segundos dentro del servidor
+} RespuestaServicio;
+
+// Segmento compartido ya mapeado; se identifica por (dispositivo, inodo) para
+// reutilizar el mapeo cuando el cliente vuelve a enviar el mismo memfd
+typedef struct {
+    dev_t dispositivo;
+    ino_t inodo;
+    size_t bytes;
+    int *datos;
+    unsigned long ultimo_uso;
+} BufferCompartido;
+
+static volatile sig_atomic_t terminar = 0;
+
+static void manejar_senal(int senal) {
+    (void)senal;
+    terminar = 1;
+}
+
+// Función para obtener tiempo en microsegundos
+double get_time_microseconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// Misma multiplicación por bloques que multiplicar_matrices_openmp_optimizada,
+// sobre matrices contiguas (fila i en M + i * n)
+void multiplicar_matrices_openmp_contiguas(const int *A, const int *B, int *C, int n) {
+    const int BLOCK_SIZE = 64; // Tamaño de bloque para optimización de cache
+
+    // Peticiones pequeñas de tamaño fijo: sin bloques ni región paralela
+    if (multiplicar_fijo_contiguas(A, B, C, n)) return;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        memset(C + (size_t)i * n, 0, n * sizeof(int));
+    }
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int ii = 0; ii < n; ii += BLOCK_SIZE) {
+        for (int jj = 0; jj < n; jj += BLOCK_SIZE) {
+            for (int kk = 0; kk < n; kk += BLOCK_SIZE) {
+                int i_end = (ii + BLOCK_SIZE < n) ? ii + BLOCK_SIZE : n;
+                int j_end = (jj + BLOCK_SIZE < n) ? jj + BLOCK_SIZE : n;
+                int k_end = (kk + BLOCK_SIZE < n) ? kk + BLOCK_SIZE : n;
+
+                for (int i = ii; i < i_end; i++) {
+                    for (int j = jj; j < j_end; j++) {
+                        int sum = C[(size_t)i * n + j];
+                        for (int k = kk; k < k_end; k++) {
+                            sum += A[(size_t)i * n + k] * B[(size_t)k * n + j];
+                        }
+                        C[(size_t)i * n + j] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Latencias
+// ---------------------------------------------------------------------------
+
+static int comparar_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentiles e histograma en potencias de 2 de microsegundos
+void imprimir_latencias(const char *titulo, double *segundos, int cuenta) {
+    if (cuenta == 0) {
+        printf("%s: sin peticiones\n", titulo);
+        return;
+    }
+    qsort(segundos, cuenta, sizeof(double), comparar_double);
+
+    double suma = 0.0;
+    for (int i = 0; i < cuenta; i++) suma += segundos[i];
+
+    printf("%s (%d peticiones)\n", titulo, cuenta);
+    printf("  media: %10.1f us\n", suma / cuenta * 1e6);
+    printf("  p50:   %10.1f us\n", segundos[(int)(0.50 * (cuenta - 1))] * 1e6);
+    printf("  p90:   %10.1f us\n", segundos[(int)(0.90 * (cuenta - 1))] * 1e6);
+    printf("  p99:   %10.1f us\n", segundos[(int)(0.99 * (cuenta - 1))] * 1e6);
+    printf("  máx:   %10.1f us\n", segundos[cuenta - 1] * 1e6);
+
+    int histograma[64] = {0};
+    int max_cubeta = 0;
+    for (int i = 0; i < cuenta; i++) {
+        double us = segundos[i] * 1e6;
+        int cubeta = 0;
+        while (cubeta < 63 && us >= (double)(1ULL << (cubeta + 1))) cubeta++;
+        histograma[cubeta]++;
+        if (cubeta > max_cubeta) max_cubeta = cubeta;
+    }
+    for (int c = 0; c <= max_cubeta; c++) {
+        if (histograma[c] == 0) continue;
+        int barra = histograma[c] * 40 / cuenta;
+        printf("  [%9llu, %9llu) us %6d ", 1ULL << c, 1ULL << (c + 1), histograma[c]);
+        for (int b = 0; b < barra; b++) putchar('#');
+        putchar('\n');
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Socket: petición + descriptor por SCM_RIGHTS
+// ---------------------------------------------------------------------------
+
+static int enviar_peticion(int conexion, const PeticionServicio *peticion, int fd) {
+    struct iovec iov = {(void *)peticion, sizeof(*peticion)};
+    char control[CMSG_SPACE(sizeof(int))];
+    memset(control, 0, sizeof(control));
+
+    struct msghdr mensaje;
+    memset(&mensaje, 0, sizeof(mensaje));
+    mensaje.msg_iov = &iov;
+    mensaje.msg_iovlen = 1;
+    if (fd >= 0) {
+        mensaje.msg_control = control;
+        mensaje.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&mensaje);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    return sendmsg(conexion, &mensaje, 0) == (ssize_t)sizeof(*peticion) ? 0 : -1;
+}
+
+// Devuelve 1 si llegó una petición, 0 si el cliente cerró y -1 si hubo error.
+// *fd queda en -1 si la petición no traía descriptor
+static int recibir_peticion(int conexion, PeticionServicio *peticion, int *fd) {
+    struct iovec iov = {peticion, sizeof(*peticion)};
+    char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr mensaje;
+    memset(&mensaje, 0, sizeof(mensaje));
+    mensaje.msg_iov = &iov;
+    mensaje.msg_iovlen = 1;
+    mensaje.msg_control = control;
+    mensaje.msg_controllen = sizeof(control);
+
+    ssize_t leidos = recvmsg(conexion, &mensaje, MSG_CMSG_CLOEXEC);
+    if (leidos == 0) return 0;
+    if (leidos != (ssize_t)sizeof(*peticion)) return -1;
+
+    *fd = -1;
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&mensaje);
+    if (cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return 1;
+}
+
+static int abrir_socket(const char *ruta, struct sockaddr_un *direccion) {
+    if (strlen(ruta) >= sizeof(direccion->sun_path)) {
+        printf("Error: La ruta del socket es demasiado larga: %s\n", ruta);
+        exit(1);
+    }
+    memset(direccion, 0, sizeof(*direccion));
+    direccion->sun_family = AF_UNIX;
+    strcpy(direccion->sun_path, ruta);
+
+    int s = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (s < 0) {
+        perror("socket");
+        exit(1);
+    }
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Servidor
+// ---------------------------------------------------------------------------
+
+// Busca el segmento del descriptor entre los ya mapeados; si no está, lo mapea
+// (prefaultado con MAP_POPULATE) reemplazando el menos usado recientemente.
+// Rechaza el descriptor si no tiene F_SEAL_SHRINK y F_SEAL_GROW (los sellos
+// no se pueden quitar, así que el tamaño comprobado aquí vale mientras dure
+// el mapeo) o si es más chico que lo que pide la petición
+static int *obtener_buffer(BufferCompartido *buffers, int fd, size_t bytes, unsigned long reloj) {
+    const int sellos_requeridos = F_SEAL_SHRINK | F_SEAL_GROW;
+    int sellos = fcntl(fd, F_GET_SEALS);
+    if (sellos < 0 || (sellos & sellos_requeridos) != sellos_requeridos) {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < bytes) {
+        return NULL;
+    }
+
+    int libre = 0;
+    for (int b = 0; b < MAX_BUFFERS; b++) {
+        if (buffers[b].datos != NULL && buffers[b].dispositivo == info.st_dev &&
+            buffers[b].inodo == info.st_ino && buffers[b].bytes >= bytes) {
+            buffers[b].ultimo_uso = reloj;
+            return buffers[b].datos;
+        }
+        if (buffers[b].datos == NULL ||
+            (buffers[libre].datos != NULL && buffers[b].ultimo_uso < buffers[libre].ultimo_uso)) {
+            libre = b;
+        }
+    }
+
+    void *datos = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (datos == MAP_FAILED) {
+        return NULL;
+    }
+    if (buffers[libre].datos != NULL) {
+        munmap(buffers[libre].datos, buffers[libre].bytes);
+    }
+    buffers[libre].dispositivo = info.st_dev;
+    buffers[libre].inodo = info.st_ino;
+    buffers[libre].bytes = info.st_size;
+    buffers[libre].datos = (int *)datos;
+    buffers[libre].ultimo_uso = reloj;
+    return buffers[libre].datos;
+}
+
+// Estado del servidor compartido por todas las conexiones
+typedef struct {
+    BufferCompartido buffers[MAX_BUFFERS];
+    unsigned long reloj;
+    double *tiempos;
+    int capacidad;
+    int atendidas;
+} EstadoServidor;
+
+// Atiende una petición de una conexión con datos pendientes. Devuelve 0 si la
+// conexión sigue abierta y -1 si hay que cerrarla (el cliente cerró, mandó
+// una petición incompleta o no recibe la respuesta)
+static int atender_peticion(EstadoServidor *estado, int conexion) {
+    PeticionServicio peticion;
+    int fd;
+    errno = 0; // una petición incompleta devuelve -1 sin tocar errno
+    int recibida = recibir_peticion(conexion, &peticion, &fd);
+    if (recibida < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+    if (recibida != 1) return -1;
+
+    if (peticion.operacion == OP_CERRAR) {
+        terminar = 1;
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+
+    RespuestaServicio respuesta = {1, 0.0};
+    size_t bytes = 3 * (size_t)peticion.n * peticion.n * sizeof(int);
+    int *datos = (peticion.operacion == OP_MULTIPLICAR && peticion.n > 0 && fd >= 0)
+               ? obtener_buffer(estado->buffers, fd, bytes, ++estado->reloj) : NULL;
+    // El mapeo mantiene vivo el segmento; el descriptor ya no hace falta
+    if (fd >= 0) close(fd);
+
+    if (datos != NULL) {
+        size_t elementos = (size_t)peticion.n * peticion.n;
+        double inicio = omp_get_wtime();
+        multiplicar_matrices_openmp_contiguas(datos, datos + elementos, datos + 2 * elementos, peticion.n);
+        respuesta.tiempo_calculo = omp_get_wtime() - inicio;
+        respuesta.estado = 0;
+
+        if (estado->atendidas == estado->capacidad) {
+            estado->capacidad *= 2;
+            estado->tiempos = (double *)realloc(estado->tiempos, estado->capacidad * sizeof(double));
+        }
+        estado->tiempos[estado->atendidas++] = respuesta.tiempo_calculo;
+    }
+    // Sin bloquear: un cliente que no lee sus respuestas se desconecta
+    if (send(conexion, &respuesta, sizeof(respuesta), MSG_DONTWAIT) != (ssize_t)sizeof(respuesta)) {
+        return -1;
+    }
+    return 0;
+}
+
+int ejecutar_servidor(const char *ruta, int num_hilos) {
+    omp_set_num_threads(num_hilos);
+
+    // Levantar el equipo de hilos antes de la primera petición
+    #pragma omp parallel
+    {
+        (void)omp_get_thread_num();
+    }
+
+    struct sockaddr_un direccion;
+    int escucha = abrir_socket(ruta, &direccion);
+    unlink(ruta);
+    if (bind(escucha, (struct sockaddr *)&direccion, sizeof(direccion)) != 0 || listen(escucha, 16) != 0) {
+        perror("bind/listen");
+        return 1;
+    }
+
+    struct sigaction accion;
+    memset(&accion, 0, sizeof(accion));
+    accion.sa_handler = manejar_senal; // sin SA_RESTART: poll() vuelve con EINTR
+    sigaction(SIGINT, &accion, NULL);
+    sigaction(SIGTERM, &accion, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("=== SERVICIO DE MULTIPLICACIÓN DE MATRICES ===\n");
+    printf("Socket: %s\n", ruta);
+    printf("Hilos OpenMP: %d\n", num_hilos);
+    fflush(stdout);
+
+    EstadoServidor estado;
+    memset(&estado, 0, sizeof(estado));
+    estado.capacidad = 1024;
+    estado.tiempos = (double *)malloc(estado.capacidad * sizeof(double));
+
+    // fds[0] es el socket de escucha; fds[1..num_conexiones] los clientes
+    struct pollfd fds[1 + MAX_CONEXIONES];
+    int num_conexiones = 0;
+    fds[0].fd = escucha;
+    fds[0].events = POLLIN;
+
+    while (!terminar) {
+        if (poll(fds, 1 + num_conexiones, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            break;
+        }
+
+        // Una petición por conexión lista en cada vuelta, para que ningún
+        // cliente acapare el servidor; de atrás hacia adelante para poder
+        // quitar conexiones moviendo la última a su lugar
+        for (int c = num_conexiones; c >= 1 && !terminar; c--) {
+            if (fds[c].revents == 0) continue;
+            if ((fds[c].revents & POLLIN) == 0 || atender_peticion(&estado, fds[c].fd) != 0) {
+                close(fds[c].fd);
+                fds[c] = fds[num_conexiones--];
+            }
+        }
+
+        if (!terminar && (fds[0].revents & POLLIN)) {
+            int conexion = accept4(escucha, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (conexion < 0) {
+                if (errno != EINTR && errno != EAGAIN && errno != ECONNABORTED) {
+                    perror("accept");
+                    break;
+                }
+            } else if (num_conexiones == MAX_CONEXIONES) {
+                close(conexion); // el cliente ve la conexión cerrada y puede reintentar
+            } else {
+                num_conexiones++;
+                fds[num_conexiones].fd = conexion;
+                fds[num_conexiones].events = POLLIN;
+                fds[num_conexiones].revents = 0;
+            }
+        }
+    }
+    for (int c = 1; c <= num_conexiones; c++) {
+        close(fds[c].fd);
+    }
+
+    printf("\n");
+    imprimir_latencias("Tiempo de cálculo en el servidor", estado.tiempos, estado.atendidas);
+
+    for (int b = 0; b < MAX_BUFFERS; b++) {
+        if (estado.buffers[b].datos != NULL) munmap(estado.buffers[b].datos, estado.buffers[b].bytes);
+    }
+    free(estado.tiempos);
+    close(escucha);
+    unlink(ruta);
+    printf("=== SERVICIO DETENIDO ===\n");
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Cliente
+// ---------------------------------------------------------------------------
+
+static int conectar(const char *ruta) {
+    struct sockaddr_un direccion;
+    int conexion = abrir_socket(ruta, &direccion);
+    if (connect(conexion, (struct sockaddr *)&direccion, sizeof(direccion)) != 0) {
+        printf("Error: No se pudo conectar al servicio en %s (¿está corriendo?)\n", ruta);
+        exit(1);
+    }
+    return conexion;
+}
+
+int ejecutar_cliente(const char *ruta, int n, int peticiones) {
+    // A, B y C en un solo memfd: [A | B | C]
+    size_t elementos = (size_t)n * n;
+    size_t bytes = 3 * elementos * sizeof(int);
+    int fd = memfd_create("matrices", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0 || ftruncate(fd, bytes) != 0) {
+        perror("memfd_create");
+        return 1;
+    }
+    // El servidor rechaza segmentos cuyo tamaño todavía puede cambiar
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) != 0) {
+        perror("fcntl(F_ADD_SEALS)");
+        return 1;
+    }
+    int *datos = (int *)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (datos == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    int *A = datos, *B = datos + elementos, *C = datos + 2 * elementos;
+
+    srand(time(NULL));
+    for (size_t i = 0; i < elementos; i++) {
+        A[i] = rand() % 100;
+        B[i] = rand() % 100;
+    }
+
+    printf("=== CLIENTE DEL SERVICIO DE MATRICES ===\n");
+    printf("Socket: %s\n", ruta);
+    printf("Tamaño de matriz: %dx%d\n", n, n);
+    printf("Peticiones: %d\n\n", peticiones);
+
+    int conexion = conectar(ruta);
+    double *latencias = (double *)malloc(peticiones * sizeof(double));
+    double *calculo = (double *)malloc(peticiones * sizeof(double));
+    PeticionServicio peticion = {OP_MULTIPLICAR, n};
+
+    double inicio_total = get_time_microseconds();
+    for (int p = 0; p < peticiones; p++) {
+        double inicio = get_time_microseconds();
+        RespuestaServicio respuesta;
+        if (enviar_peticion(conexion, &peticion, fd) != 0 ||
+            recv(conexion, &respuesta, sizeof(respuesta), MSG_WAITALL) != (ssize_t)sizeof(respuesta) ||
+            respuesta.estado != 0) {
+            printf("Error: La petición %d falló\n", p);
+            return 1;
+        }
+        latencias[p] = (get_time_microseconds() - inicio) / 1e6;
+        calculo[p] = respuesta.tiempo_calculo;
+    }
+    double total = (get_time_microseconds() - inicio_total) / 1e6;
+    close(conexion);
+
+    // Verificar algunas entradas de C contra el producto directo
+    int errores = 0;
+    for (int muestra = 0; muestra < 32; muestra++) {
+        int i = rand() % n, j = rand() % n;
+        int esperado = 0;
+        for (int k = 0; k < n; k++) esperado += A[(size_t)i * n + k] * B[(size_t)k * n + j];
+        if (C[(size_t)i * n + j] != esperado) errores++;
+    }
+    printf("Verificación de C: %s\n", errores == 0 ? "correcta" : "INCORRECTA");
+    printf("Tiempo total: %f segundos\n", total);
+    printf("Peticiones por segundo: %.2f\n\n", peticiones / total);
+
+    imprimir_latencias("Latencia de extremo a extremo", latencias, peticiones);
+    imprimir_latencias("Tiempo de cálculo en el servidor", calculo, peticiones);
+
+    free(latencias);
+    free(calculo);
+    munmap(datos, bytes);
+    close(fd);
+    return errores == 0 ? 0 : 1;
+}
+
+int detener_servidor(const char *ruta) {
+    int conexion = conectar(ruta);
+    PeticionServicio peticion = {OP_CERRAR, 0};
+    int resultado = enviar_peticion(conexion, &peticion, -1);
+    close(conexion);
+    return resultado == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "servidor") == 0 && argc <= 4) {
+        const char *ruta = argc > 2 ? argv[2] : SOCKET_POR_DEFECTO;
+        int num_hilos = argc > 3 ? atoi(argv[3]) : omp_get_max_threads();
+        if (num_hilos > 0) {
+            return ejecutar_servidor(ruta, num_hilos);
+        }
+    } else if (argc >= 4 && strcmp(argv[1], "cliente") == 0 && argc <= 5) {
+        int n = atoi(argv[2]);
+        int peticiones = atoi(argv[3]);
+        if (n > 0 && peticiones > 0) {
+            return ejecutar_cliente(argc > 4 ? argv[4] : SOCKET_POR_DEFECTO, n, peticiones);
+        }
+    } else if (argc >= 2 && strcmp(argv[1], "detener") == 0 && argc <= 3) {
+        return detener_servidor(argc > 2 ? argv[2] : SOCKET_POR_DEFECTO);
+    }
+
+    printf("Uso: %s servidor [socket] [num_hilos]\n", argv[0]);
+    printf("     %s cliente <tamaño_matriz> <peticiones> [socket]\n", argv[0]);
+    printf("     %s detener [socket]\n", argv[0]);
+    printf("El servicio es un programa aparte (no un modo de cada versión): usa el kernel por bloques\n");
+    printf("de la versión OpenMP y atiende a varios clientes a la vez con poll()\n");
+    printf("Ejemplo: %s servidor %s 4 &\n", argv[0], SOCKET_POR_DEFECTO);
+    printf("         %s cliente 512 100\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,168 @@
+#ifndef TOPOLOGIA_H
+#define TOPOLOGIA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
+
+// Dominios de memoria de la máquina, de /sys: los nodos NUMA si hay más de
+// uno, si no los sockets (physical_package_id), y si no un solo dominio con
+// todas las CPUs. Solo cuentan las CPUs que permite la afinidad del proceso
+// (taskset, cgroups). topologia_dividir reparte las CPUs en N dominios
+// artificiales para probar el camino de varios procesos en una máquina de
+// un solo nodo.
+
+#define TOPO_MAX_DOMINIOS 64
+#define TOPO_RUTA_NODOS "/sys/devices/system/node"
+#define TOPO_RUTA_CPUS "/sys/devices/system/cpu"
+
+typedef struct {
+    int num_dominios;
+    const char *tipo;              // "nodo NUMA", "socket", "máquina" o "dominio forzado"
+    int id[TOPO_MAX_DOMINIOS];     // número de nodo o de socket
+    cpu_set_t cpus[TOPO_MAX_DOMINIOS];
+    int num_cpus[TOPO_MAX_DOMINIOS];
+} Topologia;
+
+// Lista de CPUs de /sys ("0-3,8-11") a cpu_set_t
+static inline int topologia_leer_lista(const char *ruta, cpu_set_t *cpus) {
+    char texto[4096];
+    FILE *f = fopen(ruta, "r");
+    CPU_ZERO(cpus);
+    if (f == NULL) return 0;
+    if (fgets(texto, sizeof(texto), f) == NULL) texto[0] = '\0';
+    fclose(f);
+    char *p = texto;
+    while (*p >= '0' && *p <= '9') {
+        int desde = (int)strtol(p, &p, 10), hasta = desde;
+        if (*p == '-') hasta = (int)strtol(p + 1, &p, 10);
+        for (int c = desde; c <= hasta && c < CPU_SETSIZE; c++) CPU_SET(c, cpus);
+        if (*p == ',') p++;
+    }
+    return 1;
+}
+
+// Formato inverso para imprimir: "0-3,8-11"
+static inline void topologia_formatear(const cpu_set_t *cpus, char *texto, size_t tam) {
+    size_t usado = 0;
+    texto[0] = '\0';
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (!CPU_ISSET(c, cpus)) continue;
+        int fin = c;
+        while (fin + 1 < CPU_SETSIZE && CPU_ISSET(fin + 1, cpus)) fin++;
+        int escrito = fin > c ? snprintf(texto + usado, tam - usado, "%s%d-%d", usado ? "," : "", c, fin)
+                              : snprintf(texto + usado, tam - usado, "%s%d", usado ? "," : "", c);
+        if (escrito < 0 || (size_t)escrito >= tam - usado) return;
+        usado += escrito;
+        c = fin;
+    }
+}
+
+static inline void topologia_agregar(Topologia *t, int id, const cpu_set_t *cpus) {
+    if (t->num_dominios >= TOPO_MAX_DOMINIOS || CPU_COUNT(cpus) == 0) return;
+    t->id[t->num_dominios] = id;
+    t->cpus[t->num_dominios] = *cpus;
+    t->num_cpus[t->num_dominios] = CPU_COUNT(cpus);
+    t->num_dominios++;
+}
+
+static inline void topologia_detectar(Topologia *t) {
+    cpu_set_t permitidas, cpus;
+    char ruta[256];
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) != 0) {
+        CPU_ZERO(&permitidas);
+        CPU_SET(0, &permitidas);
+    }
+
+    // Nodos NUMA
+    t->num_dominios = 0;
+    t->tipo = "nodo NUMA";
+    for (int nodo = 0; nodo < 1024 && t->num_dominios < TOPO_MAX_DOMINIOS; nodo++) {
+        snprintf(ruta, sizeof(ruta), TOPO_RUTA_NODOS "/node%d/cpulist", nodo);
+        if (!topologia_leer_lista(ruta, &cpus)) continue;
+        CPU_AND(&cpus, &cpus, &permitidas);
+        topologia_agregar(t, nodo, &cpus);
+    }
+    if (t->num_dominios > 1) return;
+
+    // Sockets
+    t->num_dominios = 0;
+    t->tipo = "socket";
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (!CPU_ISSET(c, &permitidas)) continue;
+        snprintf(ruta, sizeof(ruta), TOPO_RUTA_CPUS "/cpu%d/topology/physical_package_id", c);
+        FILE *f = fopen(ruta, "r");
+        int socket = 0;
+        if (f != NULL) {
+            if (fscanf(f, "%d", &socket) != 1) socket = 0;
+            fclose(f);
+        }
+        int d = 0;
+        while (d < t->num_dominios && t->id[d] != socket) d++;
+        if (d == t->num_dominios) {
+            if (d == TOPO_MAX_DOMINIOS) continue;
+            t->id[d] = socket;
+            CPU_ZERO(&t->cpus[d]);
+            t->num_dominios++;
+        }
+        CPU_SET(c, &t->cpus[d]);
+        t->num_cpus[d] = CPU_COUNT(&t->cpus[d]);
+    }
+    if (t->num_dominios > 1) return;
+
+    t->num_dominios = 0;
+    t->tipo = "máquina";
+    topologia_agregar(t, 0, &permitidas);
+}
+
+// Reparte las CPUs de todos los dominios en num_dominios dominios de CPUs
+// consecutivas; con menos CPUs que dominios, los dominios las comparten
+static inline void topologia_dividir(Topologia *t, int num_dominios) {
+    int lista[CPU_SETSIZE], total = 0;
+    for (int d = 0; d < t->num_dominios; d++) {
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &t->cpus[d])) lista[total++] = c;
+        }
+    }
+    if (num_dominios > TOPO_MAX_DOMINIOS) num_dominios = TOPO_MAX_DOMINIOS;
+    t->num_dominios = num_dominios;
+    t->tipo = "dominio forzado";
+    for (int d = 0; d < num_dominios; d++) {
+        t->id[d] = d;
+        CPU_ZERO(&t->cpus[d]);
+        if (total >= num_dominios) {
+            for (int k = total * d / num_dominios; k < total * (d + 1) / num_dominios; k++) CPU_SET(lista[k], &t->cpus[d]);
+        } else {
+            CPU_SET(lista[d % total], &t->cpus[d]);
+        }
+        t->num_cpus[d] = CPU_COUNT(&t->cpus[d]);
+    }
+}
+
+// k-ésima CPU del dominio (módulo el número de CPUs)
+static inline int topologia_cpu(const Topologia *t, int dominio, int k) {
+    int buscada = k % t->num_cpus[dominio];
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &t->cpus[dominio]) && buscada-- == 0) return c;
+    }
+    return 0;
+}
+
+// Fija el hilo que llama a una CPU. Devuelve 0 o el código de error
+static inline int topologia_fijar_hilo(int cpu) {
+    cpu_set_t una;
+    CPU_ZERO(&una);
+    CPU_SET(cpu, &una);
+    return pthread_setaffinity_np(pthread_self(), sizeof(una), &una);
+}
+
+// Fija el proceso que llama a las CPUs de un dominio. Devuelve 0 o el código
+// de error (errno de sched_setaffinity)
+static inline int topologia_fijar_proceso(const Topologia *t, int dominio) {
+    return sched_setaffinity(0, sizeof(cpu_set_t), &t->cpus[dominio]) == 0 ? 0 : errno;
+}
+
+#endif
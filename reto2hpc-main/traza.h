@@ -0,0 +1,156 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+// Trazas por hilo en formato Chrome trace (chrome://tracing, ui.perfetto.dev).
+// Se compilan sólo con -DTRAZA (make TRAZA=1); sin él las macros no generan
+// código. Uso:
+//
+//   TRAZA_TRAMO_INICIO(t);                  // toma la marca de tiempo
+//   ... trabajo ...
+//   TRAZA_TRAMO_FIN(t, "tesela", id);       // registra el tramo [t, ahora)
+//   TRAZA_NOMBRAR_HILO("productor", 3);     // opcional, nombre en el visor
+//   TRAZA_VOLCAR("traza.json");             // al final, con los hilos unidos
+//
+// Cada hilo escribe en su propio buffer circular (sin locks: el buffer se
+// asigna una vez con un incremento atómico y sólo lo escribe su hilo). Si un
+// hilo registra más de TRAZA_CAPACIDAD tramos se conservan los últimos. Cada
+// tramo se guarda como un evento completo ("ph": "X"), que equivale al par
+// inicio/fin y no queda desemparejado al sobrescribir el buffer.
+
+#ifdef TRAZA
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TRAZA_MAX_HILOS 256
+#define TRAZA_CAPACIDAD (1 << 16) // tramos por hilo, potencia de 2
+
+typedef struct {
+    const char *nombre; // literal: no se copia
+    uint64_t inicio_ns;
+    uint64_t duracion_ns;
+    int id;
+} EventoTraza;
+
+typedef struct {
+    EventoTraza eventos[TRAZA_CAPACIDAD];
+    uint64_t escritos;
+    char nombre_hilo[32];
+} BufferTraza;
+
+static BufferTraza *traza_buffers[TRAZA_MAX_HILOS];
+static int traza_num_buffers = 0;
+static __thread BufferTraza *traza_buffer_local = NULL;
+static __thread int traza_sin_lugar = 0;
+
+static inline uint64_t traza_ahora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline BufferTraza *traza_buffer_hilo(void) {
+    if (traza_buffer_local == NULL && !traza_sin_lugar) {
+        int indice = __atomic_fetch_add(&traza_num_buffers, 1, __ATOMIC_RELAXED);
+        if (indice >= TRAZA_MAX_HILOS) {
+            traza_sin_lugar = 1; // más hilos que buffers: este no se traza
+            return NULL;
+        }
+        BufferTraza *buffer = (BufferTraza *)calloc(1, sizeof(BufferTraza));
+        if (buffer == NULL) {
+            traza_sin_lugar = 1;
+            return NULL;
+        }
+        snprintf(buffer->nombre_hilo, sizeof(buffer->nombre_hilo), "hilo %d", indice);
+        __atomic_store_n(&traza_buffers[indice], buffer, __ATOMIC_RELEASE);
+        traza_buffer_local = buffer;
+    }
+    return traza_buffer_local;
+}
+
+static inline void traza_registrar(const char *nombre, uint64_t inicio_ns, int id) {
+    BufferTraza *buffer = traza_buffer_hilo();
+    if (buffer == NULL) return;
+    EventoTraza *e = &buffer->eventos[buffer->escritos & (TRAZA_CAPACIDAD - 1)];
+    e->nombre = nombre;
+    e->inicio_ns = inicio_ns;
+    e->duracion_ns = traza_ahora_ns() - inicio_ns;
+    e->id = id;
+    buffer->escritos++;
+}
+
+static inline void traza_nombrar_hilo(const char *nombre, int numero) {
+    BufferTraza *buffer = traza_buffer_hilo();
+    if (buffer != NULL) {
+        snprintf(buffer->nombre_hilo, sizeof(buffer->nombre_hilo), "%s %d", nombre, numero);
+    }
+}
+
+// Escribe todos los buffers como JSON; TRAZA_ARCHIVO en el entorno cambia el
+// archivo de salida. Llamar cuando ningún hilo esté registrando
+static inline void traza_volcar(const char *archivo) {
+    if (getenv("TRAZA_ARCHIVO") != NULL) archivo = getenv("TRAZA_ARCHIVO");
+    FILE *f = fopen(archivo, "w");
+    if (f == NULL) {
+        printf("Error: No se pudo escribir la traza en %s\n", archivo);
+        return;
+    }
+
+    int num_buffers = traza_num_buffers < TRAZA_MAX_HILOS ? traza_num_buffers : TRAZA_MAX_HILOS;
+    uint64_t origen = UINT64_MAX, total = 0, perdidos = 0;
+    for (int b = 0; b < num_buffers; b++) {
+        BufferTraza *buffer = traza_buffers[b];
+        if (buffer == NULL || buffer->escritos == 0) continue;
+        uint64_t primero = buffer->escritos > TRAZA_CAPACIDAD ? buffer->escritos - TRAZA_CAPACIDAD : 0;
+        for (uint64_t e = primero; e < buffer->escritos; e++) {
+            uint64_t inicio = buffer->eventos[e & (TRAZA_CAPACIDAD - 1)].inicio_ns;
+            if (inicio < origen) origen = inicio;
+        }
+    }
+
+    int pid = (int)getpid();
+    int primero_json = 1;
+    fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    for (int b = 0; b < num_buffers; b++) {
+        BufferTraza *buffer = traza_buffers[b];
+        if (buffer == NULL) continue;
+        fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                primero_json ? "" : ",\n", pid, b, buffer->nombre_hilo);
+        primero_json = 0;
+
+        uint64_t primero = buffer->escritos > TRAZA_CAPACIDAD ? buffer->escritos - TRAZA_CAPACIDAD : 0;
+        perdidos += primero;
+        for (uint64_t e = primero; e < buffer->escritos; e++) {
+            const EventoTraza *ev = &buffer->eventos[e & (TRAZA_CAPACIDAD - 1)];
+            // Chrome trace usa microsegundos
+            fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"id\": %d}}",
+                    ev->nombre, pid, b, (ev->inicio_ns - origen) / 1000.0, ev->duracion_ns / 1000.0, ev->id);
+            total++;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    printf("Traza: %llu tramos de %d hilos en %s", (unsigned long long)total, num_buffers, archivo);
+    if (perdidos > 0) printf(" (%llu tramos antiguos sobrescritos)", (unsigned long long)perdidos);
+    printf("\n");
+}
+
+#define TRAZA_TRAMO_INICIO(var) uint64_t var = traza_ahora_ns()
+#define TRAZA_TRAMO_FIN(var, nombre, id) traza_registrar((nombre), (var), (id))
+#define TRAZA_NOMBRAR_HILO(nombre, numero) traza_nombrar_hilo((nombre), (numero))
+#define TRAZA_VOLCAR(archivo) traza_volcar(archivo)
+
+#else
+
+#define TRAZA_TRAMO_INICIO(var) do { } while (0)
+#define TRAZA_TRAMO_FIN(var, nombre, id) do { } while (0)
+#define TRAZA_NOMBRAR_HILO(nombre, numero) do { } while (0)
+#define TRAZA_VOLCAR(archivo) do { } while (0)
+
+#endif
+
+#endif